@@ -0,0 +1,43 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Minimalna uprząż do mikrobenchmarków (bez zależności zewnętrznych)
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    std::string name;
+    uint64_t ops;
+    double seconds;
+    std::string unit;
+};
+
+// Wszystkie wyniki uruchomienia - main.cpp zapisuje je do JSON (--json)
+inline std::vector<Result>& results() {
+    static std::vector<Result> all;
+    return all;
+}
+
+inline double secondsSince(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+inline void report(const char* name, uint64_t ops, double seconds, const char* unit = "ops") {
+    const double perSec = seconds > 0.0 ? static_cast<double>(ops) / seconds : 0.0;
+    std::printf("%-40s %12llu %-8s %10.3f ms %14.1f %s/s\n", name,
+        static_cast<unsigned long long>(ops), unit, seconds * 1000.0, perSec, unit);
+    results().push_back({ name, ops, seconds, unit });
+}
+
+// Zapobiega wyrzuceniu wyniku przez optymalizator (przenośnie, także MSVC)
+inline void consume(uint64_t value) {
+    static volatile uint64_t sink = 0;
+    sink = sink + value;
+}
+
+} // namespace bench
@@ -0,0 +1,57 @@
+#include "Bench.h"
+#include "game/Animation.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+void benchAnimation()
+{
+    constexpr uint32_t kInstances = 100000;
+    constexpr int kFrames = 600;   // 10 s przy 60 fps
+    constexpr float kDt = 1.0f / 60.0f;
+
+    AnimationLibrary library;
+    library.loadFromText(
+        "sheet monsters monsters.png 32 32\n"
+        "clip idle monsters 0 4 6 loop\n"
+        "clip walk monsters 4 8 12 loop\n"
+        "clip die monsters 12 6 10 once\n");
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> clip(0, 2);
+    std::uniform_real_distribution<float> phase(0.0f, 1.0f);
+
+    Animator animator(library);
+    for (uint32_t i = 0; i < kInstances; ++i)
+        animator.add(static_cast<uint16_t>(clip(rng)), phase(rng));
+
+    auto t0 = bench::Clock::now();
+    for (int f = 0; f < kFrames; ++f) animator.update(kDt);
+    bench::report("animation/update-100k", static_cast<uint64_t>(kInstances) * kFrames, bench::secondsSince(t0), "instances");
+
+    // Odczyt klatek jak w drawWorld - po Id, przez tablicę pośrednią
+    uint64_t sum = 0;
+    t0 = bench::Clock::now();
+    for (int f = 0; f < 60; ++f)
+        for (uint32_t i = 0; i < kInstances; ++i) sum += animator.frame(i);
+    bench::report("animation/frame-lookup-100k", static_cast<uint64_t>(kInstances) * 60, bench::secondsSince(t0), "lookups");
+    bench::consume(sum);
+
+    // Dla porównania: stan w obiektach, klip czytany z biblioteki przy każdej instancji
+    struct NaiveAnim { uint16_t clip; int frame; float timer; };
+    std::vector<NaiveAnim> naive(kInstances);
+    for (auto& a : naive) a = { static_cast<uint16_t>(clip(rng)), 0, phase(rng) };
+    t0 = bench::Clock::now();
+    for (int f = 0; f < kFrames; ++f) {
+        for (auto& a : naive) {
+            const AnimationClip& c = library.clip(a.clip);
+            a.timer += kDt;
+            while (a.timer >= c.frameDuration) {
+                a.timer -= c.frameDuration;
+                if (++a.frame >= c.frameCount) a.frame = c.loop ? 0 : c.frameCount - 1;
+            }
+        }
+    }
+    bench::report("animation/naive-update-100k", static_cast<uint64_t>(kInstances) * kFrames, bench::secondsSince(t0), "instances");
+    bench::consume(static_cast<uint64_t>(naive[kInstances / 2].frame));
+}
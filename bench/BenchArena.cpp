@@ -0,0 +1,76 @@
+#include "Bench.h"
+#include "core/FrameArena.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace {
+// Typowa lista jednej klatki: widoczne encje po odrzuceniu, rosnąca przez push_back
+template <typename Vec>
+uint64_t buildVisibleList(Vec& list, uint32_t count, uint32_t seed)
+{
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t h = (i ^ seed) * 2654435761u;
+        if (h & 1) list.push_back(h);
+    }
+    for (uint32_t v : list) sum += v;
+    return sum;
+}
+}
+
+void benchArena()
+{
+    constexpr int kFrames = 2000;
+    constexpr uint32_t kEntities = 4096;
+    constexpr int kListsPerFrame = 8;
+
+    uint64_t sum = 0;
+    auto t0 = bench::Clock::now();
+    for (int f = 0; f < kFrames; ++f) {
+        for (int l = 0; l < kListsPerFrame; ++l) {
+            std::vector<uint32_t> list;
+            sum += buildVisibleList(list, kEntities, static_cast<uint32_t>(f * 31 + l));
+        }
+    }
+    bench::report("arena/std-vector-lists", static_cast<uint64_t>(kFrames) * kListsPerFrame, bench::secondsSince(t0), "lists");
+
+    FrameArenas arenas(2, 64 * 1024, 16 * 1024, AllocTag::General);
+    t0 = bench::Clock::now();
+    for (int f = 0; f < kFrames; ++f) {
+        arenas.beginFrame(static_cast<uint32_t>(f & 1));
+        for (int l = 0; l < kListsPerFrame; ++l) {
+            ArenaVector<uint32_t> list(arenas.frame());
+            sum += buildVisibleList(list, kEntities, static_cast<uint32_t>(f * 31 + l));
+        }
+    }
+    bench::report("arena/frame-arena-lists", static_cast<uint64_t>(kFrames) * kListsPerFrame, bench::secondsSince(t0), "lists");
+    std::printf("   frame arena: %u block(s), high water %zu B\n", arenas.frame(0).blockCount(), arenas.frame(0).highWater());
+
+    // Scratch zadań: każdy wątek bierze własną pod-arenę, bez blokad i bez malloc
+    JobSystem jobs;
+    FrameArenas jobArenas(2, 4 * 1024, 16 * 1024, AllocTag::General, jobs.slotCount());
+    constexpr int kJobFrames = 200;
+    for (int pass = 0; pass < 2; ++pass) {
+        const bool useArena = pass == 1;
+        t0 = bench::Clock::now();
+        for (int f = 0; f < kJobFrames; ++f) {
+            jobArenas.beginFrame(static_cast<uint32_t>(f & 1));
+            jobs.parallelFor(0, 256, 4, [&](uint32_t b, uint32_t e) {
+                for (uint32_t i = b; i < e; ++i) {
+                    if (useArena) {
+                        ArenaVector<uint32_t> scratch(jobArenas.local(jobs));
+                        bench::consume(buildVisibleList(scratch, 1024, i));
+                    } else {
+                        std::vector<uint32_t> scratch;
+                        bench::consume(buildVisibleList(scratch, 1024, i));
+                    }
+                }
+            });
+        }
+        bench::report(useArena ? "arena/job-scratch-arena" : "arena/job-scratch-std-vector",
+            static_cast<uint64_t>(kJobFrames) * 256, bench::secondsSince(t0), "jobs");
+    }
+    bench::consume(sum);
+}
@@ -0,0 +1,55 @@
+#include "Bench.h"
+#include "core/Hash.h"
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Assets::getOrLoad bez urządzenia: ta sama mapa (ścieżka -> SpriteId) i ta sama droga wywołania.
+// spawn() podaje const char*, więc każde trafienie buduje std::string - ścieżki assetów są
+// dłuższe niż bufor SSO, czyli to alokacja na każde wyszukanie.
+void benchAssets()
+{
+    constexpr int kSprites = 256;
+    constexpr int kLookups = 1000000;
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < kSprites; ++i) {
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "assets/characters/monster_%03d_idle.png", i);
+        paths.emplace_back(buf);
+    }
+    std::unordered_map<std::string, int> byPath;
+    std::unordered_map<uint64_t, int> byHash;
+    for (int i = 0; i < kSprites; ++i) {
+        byPath[paths[i]] = i;
+        byHash[hashString(paths[i])] = i;
+    }
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pick(0, kSprites - 1);
+    std::vector<int> order(kLookups);
+    for (int& o : order) o = pick(rng);
+
+    uint64_t sum = 0;
+    auto t0 = bench::Clock::now();
+    for (int o : order) {
+        const char* path = paths[o].c_str();
+        sum += static_cast<uint64_t>(byPath.find(path)->second);   // jak getOrLoad(const std::string&)
+    }
+    bench::report("assets/getOrLoad-hit-cstr", kLookups, bench::secondsSince(t0), "lookups");
+
+    t0 = bench::Clock::now();
+    for (int o : order) sum += static_cast<uint64_t>(byPath.find(paths[o])->second);
+    bench::report("assets/getOrLoad-hit-string", kLookups, bench::secondsSince(t0), "lookups");
+
+    // Dla porównania: klucz to hash ścieżki policzony raz (jak w zapisie gry)
+    std::vector<uint64_t> hashes(kSprites);
+    for (int i = 0; i < kSprites; ++i) hashes[i] = hashString(paths[i]);
+    t0 = bench::Clock::now();
+    for (int o : order) sum += static_cast<uint64_t>(byHash.find(hashes[o])->second);
+    bench::report("assets/hash-key-hit", kLookups, bench::secondsSince(t0), "lookups");
+    bench::consume(sum);
+}
@@ -0,0 +1,87 @@
+#include "Bench.h"
+#include "game/ChunkStore.h"
+#include "game/Rng.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+
+// Schodzenie przez kLevels pięter 128x128 (pokoje z korytarzami w skale): każde opuszczone piętro
+// trafia do magazynu, a pamięć ma zostać w budżecie niezależnie od ich liczby. Potem powrót
+// w górę: wczytanie piętra z dysku synchronicznie i po prefetchu w tle.
+namespace {
+constexpr int kSize = 128;
+constexpr uint32_t kLevels = 400;
+constexpr size_t kBudget = 256u << 10;
+
+void generateLevel(TileMap& map, Rng& rng)
+{
+    map = TileMap(kSize, kSize, TileWall);
+    for (int room = 0; room < 24; ++room) {
+        const int w = 4 + int(rng.below(10)), h = 4 + int(rng.below(8));
+        const int x0 = 1 + int(rng.below(kSize - w - 2)), y0 = 1 + int(rng.below(kSize - h - 2));
+        for (int y = y0; y < y0 + h; ++y)
+            for (int x = x0; x < x0 + w; ++x) map.set(x, y, TileFloor);
+        for (int x = 1; x < kSize - 1; ++x) map.set(x, y0 + h / 2, TileFloor);   // korytarz przez całe piętro
+    }
+}
+}
+
+void benchChunkStore()
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "roguelike_bench.swap").string();
+    ChunkStore::Config config;
+    config.swapPath = path;
+    config.compressedBudget = kBudget;
+    ChunkStore store(config);
+    Rng rng(7);
+    TileMap map;
+
+    {
+        uint64_t peak = 0;
+        const auto t0 = bench::Clock::now();
+        for (uint32_t level = 0; level < kLevels; ++level) {
+            generateLevel(map, rng);
+            store.storeLevel(level, map);
+            store.setFocus(level, kSize / 2, kSize / 2, 1);
+            store.maintain();
+            peak = std::max(peak, store.stats().residentBytes);
+        }
+        bench::report("chunkstore/store-level", kLevels, bench::secondsSince(t0), "levels");
+        const ChunkStore::Stats s = store.stats();
+        std::printf("   raw %llu KB, resident peak %llu KB (budget %zu KB), swap %llu KB, %u uniform chunks\n",
+            static_cast<unsigned long long>(uint64_t(kLevels) * kSize * kSize >> 10),
+            static_cast<unsigned long long>(peak >> 10), kBudget >> 10,
+            static_cast<unsigned long long>(s.swapBytes >> 10), s.uniformChunks);
+    }
+
+    // Wczytanie piętra leżącego na dysku: od razu (blokujące odczyty) albo po prefetchu w tle
+    constexpr uint32_t kVisits = 100;
+    {
+        const auto t0 = bench::Clock::now();
+        for (uint32_t i = 0; i < kVisits; ++i) {
+            store.loadLevel(i, map);
+            store.maintain();
+            bench::consume(map.at(kSize / 2, kSize / 2));
+        }
+        bench::report("chunkstore/load-blocking", kVisits, bench::secondsSince(t0), "levels");
+    }
+    {
+        double loadSeconds = 0.0;
+        const auto t0 = bench::Clock::now();
+        for (uint32_t i = 0; i < kVisits; ++i) {
+            store.prefetchLevel(kVisits + i);
+            store.waitLoads();   // w grze: kilka klatek między prefetchem a zejściem po schodach
+            const auto t1 = bench::Clock::now();
+            store.loadLevel(kVisits + i, map);
+            loadSeconds += bench::secondsSince(t1);
+            store.maintain();
+            bench::consume(map.at(kSize / 2, kSize / 2));
+        }
+        bench::report("chunkstore/load-prefetched", kVisits, loadSeconds, "levels");
+        const ChunkStore::Stats s = store.stats();
+        std::printf("   %llu background, %llu blocking chunk loads, total %.1f ms with waits\n",
+            static_cast<unsigned long long>(s.backgroundLoads), static_cast<unsigned long long>(s.blockingLoads),
+            bench::secondsSince(t0) * 1000.0);
+    }
+}
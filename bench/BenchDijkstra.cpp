@@ -0,0 +1,76 @@
+#include "Bench.h"
+#include "BenchMaps.h"
+#include "game/DijkstraMap.h"
+#include "game/Pathfinding.h"
+#include <cstdio>
+#include <vector>
+
+void benchDijkstra()
+{
+    const TileMap map = bench::makeBenchMap(512, 512, 1234);
+    const auto players = bench::randomWalkable(map, 32, 7);
+
+    // Mapa pościgu: jeden cel (gracz), pełne przeliczenie co turę
+    DijkstraMap chase(map);
+    const auto player = chase.addGoal(players[0]);
+    chase.update();
+    auto t0 = bench::Clock::now();
+    for (size_t turn = 1; turn < players.size(); ++turn) {
+        chase.moveGoal(player, players[turn]);
+        chase.update();
+    }
+    bench::report("dijkstra/chase-rebuild", players.size() - 1, bench::secondsSince(t0), "maps");
+
+    DijkstraMap flee(map);
+    t0 = bench::Clock::now();
+    for (int i = 0; i < 8; ++i) flee.buildFleeFrom(chase);
+    bench::report("dijkstra/flee-build", 8, bench::secondsSince(t0), "maps");
+
+    // Mapa przedmiotów: 64 cele, co turę zmieniają się 2 - naprawa tylko ich dorzeczy
+    const auto items = bench::randomWalkable(map, 64 + 2 * 64, 11);
+    DijkstraMap loot(map);
+    std::vector<DijkstraMap::GoalId> ids;
+    for (size_t i = 0; i < 64; ++i) ids.push_back(loot.addGoal(items[i]));
+    loot.update();
+    size_t relaxed = 0;
+    t0 = bench::Clock::now();
+    for (size_t turn = 0; turn < 64; ++turn) {
+        loot.moveGoal(ids[turn], items[64 + 2 * turn]);
+        loot.moveGoal(ids[(turn + 32) % 64], items[64 + 2 * turn + 1]);
+        loot.update();
+        relaxed += loot.lastRelaxed();
+    }
+    bench::report("dijkstra/loot-incremental", 64, bench::secondsSince(t0), "maps");
+    std::printf("   avg relaxed tiles per update: %zu of %zu\n", relaxed / 64, map.size());
+
+    t0 = bench::Clock::now();
+    for (int i = 0; i < 16; ++i) loot.rebuild();
+    bench::report("dijkstra/loot-rebuild", 16, bench::secondsSince(t0), "maps");
+
+    // Koszt AI na turę: jedna mapa + krok gradientu na potwora
+    for (size_t count : { 1000u, 10000u, 100000u }) {
+        auto monsters = bench::randomWalkable(map, count, 13);
+        t0 = bench::Clock::now();
+        chase.update();
+        uint64_t sum = 0;
+        for (auto& m : monsters) {
+            m = chase.nextStep(m);
+            sum += static_cast<uint64_t>(m.x) + m.y;
+        }
+        bench::consume(sum);
+        char name[64];
+        std::snprintf(name, sizeof(name), "dijkstra/horde-step-%zu", count);
+        bench::report(name, count, bench::secondsSince(t0), "steps");
+    }
+
+    // Dla porównania: osobne wyszukiwanie JPS dla każdego z 1000 potworów
+    {
+        const auto monsters = bench::randomWalkable(map, 1000, 13);
+        Pathfinder pf(map);
+        std::vector<TilePos> path;
+        path.reserve(4096);
+        t0 = bench::Clock::now();
+        for (const auto& m : monsters) pf.findPath(m, players.back(), path);
+        bench::report("dijkstra/horde-jps-1000", monsters.size(), bench::secondsSince(t0), "steps");
+    }
+}
@@ -0,0 +1,77 @@
+#include "Bench.h"
+#include "core/DirtyRegion.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Aktualizacje tekstury dynamicznej 256x256 (kafel = piksel) co turę, jak minimapa/mgła wojny:
+// rozproszone pojedyncze kafle i odsłanianie pola widzenia idącego gracza. Mierzy koszt
+// scalania prostokątów i ile bajtów trafia do uploadu w porównaniu z całą teksturą.
+namespace {
+constexpr uint32_t kSize = 256;
+constexpr uint32_t kTurns = 20000;
+constexpr uint64_t kFullBytes = uint64_t(kSize) * kSize * 4;
+
+void report(const char* name, uint64_t tiles, double seconds, uint64_t bytes, uint64_t regions)
+{
+    bench::report(name, tiles, seconds, "tiles");
+    std::printf("   %.0f B/turn (%.2f%% of full), %.1f regions/turn\n", double(bytes) / kTurns,
+        100.0 * double(bytes) / double(kFullBytes * kTurns), double(regions) / kTurns);
+}
+}
+
+void benchDirtyRegion()
+{
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<uint32_t> coord(0, kSize - 1);
+    DirtyRegion region;
+
+    {
+        uint64_t tiles = 0, bytes = 0, regions = 0;
+        const auto t0 = bench::Clock::now();
+        for (uint32_t turn = 0; turn < kTurns; ++turn) {
+            for (uint32_t i = 0; i < 16; ++i) region.add({ coord(rng), coord(rng), 1, 1 });
+            tiles += 16;
+            bytes += region.area() * 4;
+            regions += region.rects().size();
+            region.clear();
+        }
+        report("dirtyregion/scatter-16", tiles, bench::secondsSince(t0), bytes, regions);
+    }
+
+    {
+        // Gracz idzie, co 32 tury zmieniając kierunek; odsłania się okrąg r = 8, nowe są tylko kafle na jego brzegu
+        constexpr int kRadius = 8;
+        std::vector<uint8_t> seen(kSize * kSize, 0);
+        uint64_t tiles = 0, bytes = 0, regions = 0;
+        int px = kRadius, py = kRadius, dx = 1, dy = 1;
+        const auto t0 = bench::Clock::now();
+        std::uniform_int_distribution<int> step(-1, 1);
+        for (uint32_t turn = 0; turn < kTurns; ++turn) {
+            if (turn % 32 == 0) {
+                do { dx = step(rng); dy = step(rng); } while (dx == 0 && dy == 0);
+            }
+            if (px + dx < kRadius || px + dx >= int(kSize) - kRadius) dx = -dx;
+            if (py + dy < kRadius || py + dy >= int(kSize) - kRadius) dy = -dy;
+            px += dx;
+            py += dy;
+            if (turn % 2000 == 0) std::fill(seen.begin(), seen.end(), 0);   // nowy poziom
+            for (int y = -kRadius; y <= kRadius; ++y) {
+                for (int x = -kRadius; x <= kRadius; ++x) {
+                    if (x * x + y * y > kRadius * kRadius) continue;
+                    uint8_t& s = seen[(py + y) * kSize + (px + x)];
+                    if (s) continue;
+                    s = 1;
+                    region.add({ uint32_t(px + x), uint32_t(py + y), 1, 1 });
+                    ++tiles;
+                }
+            }
+            bytes += region.area() * 4;
+            regions += region.rects().size();
+            region.clear();
+        }
+        report("dirtyregion/fov-reveal", tiles, bench::secondsSince(t0), bytes, regions);
+    }
+}
@@ -0,0 +1,72 @@
+#include "Bench.h"
+#include "app/WorldDraw.h"
+#include "core/FrameArena.h"
+#include "core/JobSystem.h"
+#include "core/RadixSort.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Sortowanie kluczy rysowania (drawkey z WorldDraw.h) jak w drawWorld: std::sort jako punkt
+// odniesienia, radixSort sekwencyjnie i na wątkach roboczych. Klucze zawierają indeks encji,
+// więc są unikalne i wszystkie trzy wyniki muszą być identyczne.
+namespace {
+std::vector<uint64_t> makeKeys(uint32_t count, std::mt19937& rng)
+{
+    std::uniform_int_distribution<uint32_t> layer(0, 2), depth(0, 270 * 32), texture(0, 63);
+    std::vector<uint64_t> keys(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t l = layer(rng);
+        keys[i] = drawkey::make(l, l == static_cast<uint32_t>(DrawLayer::Ground) ? 0 : depth(rng), texture(rng), i);
+    }
+    return keys;
+}
+
+std::string sizeName(const char* prefix, uint32_t count)
+{
+    return std::string(prefix) + "-" + (count >= 1000000 ? std::to_string(count / 1000000) + "m" : std::to_string(count / 1000) + "k");
+}
+}
+
+void benchDrawSort()
+{
+    std::mt19937 rng(11);
+    LinearArena arena(1 << 20, AllocTag::General);
+    JobSystem jobs;
+    std::printf("drawsort: %u threads\n", jobs.workerCount() + 1);
+
+    for (uint32_t count : { 1000u, 10000u, 100000u, 1000000u }) {
+        const std::vector<uint64_t> input = makeKeys(count, rng);
+        const uint32_t rounds = std::max(1u, 20000000 / count / 4);
+        std::vector<uint64_t> reference, keys;
+
+        auto t0 = bench::Clock::now();
+        for (uint32_t r = 0; r < rounds; ++r) {
+            reference = input;
+            std::sort(reference.begin(), reference.end());
+        }
+        bench::report(sizeName("drawsort/std-sort", count).c_str(), uint64_t(count) * rounds, bench::secondsSince(t0), "keys");
+
+        for (JobSystem* pool : { static_cast<JobSystem*>(nullptr), &jobs }) {
+            t0 = bench::Clock::now();
+            for (uint32_t r = 0; r < rounds; ++r) {
+                keys = input;
+                radixSort(keys, arena, pool);
+            }
+            bench::report(sizeName(pool ? "drawsort/radix-parallel" : "drawsort/radix", count).c_str(),
+                uint64_t(count) * rounds, bench::secondsSince(t0), "keys");
+            if (keys != reference) std::printf("drawsort: radix result differs from std::sort (%u keys)\n", count);
+        }
+
+        // Ile zmian tekstury zostaje po sortowaniu vs kolejność encji w wektorze
+        uint32_t before = 0, after = 0;
+        for (uint32_t i = 1; i < count; ++i) {
+            before += drawkey::texture(input[i]) != drawkey::texture(input[i - 1]);
+            after += drawkey::texture(reference[i]) != drawkey::texture(reference[i - 1]);
+        }
+        std::printf("   %u keys: texture switches %u -> %u\n", count, before, after);
+    }
+}
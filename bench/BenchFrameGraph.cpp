@@ -0,0 +1,57 @@
+#include "Bench.h"
+#include "core/FrameGraph.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Koszt budowy i compile() grafu klatki. Graf gry jest przebudowywany tylko przy zmianie
+// swapchaina, ale łańcuch postprocesu pokazuje, jak koszt rośnie z liczbą passów.
+namespace {
+// Łańcuch: scena -> passes x efekt (każdy czyta poprzedni obraz) -> UI na swapchainie,
+// plus jeden pass bez odbiorcy (do wycięcia)
+void buildChain(FrameGraph& g, uint32_t passes, std::vector<std::string>& names)
+{
+    names.resize(passes + 1);
+    const FrameGraph::ResourceId backbuffer = g.importImage("backbuffer", GpuAccess::Present, GpuAccess::Present);
+    FrameGraph::ResourceId prev = g.createImage("scene", { 480, 270, 44 });
+    g.write(g.addPass("scene"), prev, GpuAccess::ColorAttachmentWrite);
+    for (uint32_t i = 0; i < passes; ++i) {
+        names[i] = "effect" + std::to_string(i);
+        const FrameGraph::ResourceId out = g.createImage(names[i].c_str(), { 480, 270, 44 });
+        const FrameGraph::PassId p = g.addPass(names[i].c_str());
+        g.read(p, prev, GpuAccess::ShaderRead);
+        g.write(p, out, GpuAccess::ColorAttachmentWrite);
+        prev = out;
+    }
+    g.write(g.addPass("debug"), g.createImage("debug", { 64, 64, 44 }), GpuAccess::ColorAttachmentWrite);
+    const FrameGraph::PassId ui = g.addPass("ui");
+    g.read(ui, prev, GpuAccess::ShaderRead);
+    g.write(ui, backbuffer, GpuAccess::ColorAttachmentWrite);
+}
+}
+
+void benchFrameGraph()
+{
+    std::vector<std::string> names;
+    for (uint32_t passes : { 1u, 16u, 256u }) {
+        const uint32_t rounds = 400000 / (passes + 2);
+        uint64_t barriers = 0;
+        auto t0 = bench::Clock::now();
+        for (uint32_t r = 0; r < rounds; ++r) {
+            FrameGraph g;
+            buildChain(g, passes, names);
+            g.compile();
+            for (const FrameGraph::Step& s : g.steps()) barriers += g.barriers(s).size();
+            barriers += g.aliasSlotCount();
+        }
+        const std::string name = "framegraph/compile-" + std::to_string(passes + 2) + "-passes";
+        bench::report(name.c_str(), rounds, bench::secondsSince(t0), "graphs");
+        bench::consume(barriers);
+    }
+
+    FrameGraph g;
+    buildChain(g, 16, names);
+    g.compile();
+    std::printf("framegraph: %u transients in %u alias slots\n", g.resourceCount() - 1, g.aliasSlotCount());
+}
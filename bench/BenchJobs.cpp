@@ -0,0 +1,55 @@
+#include "Bench.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+// Coś, co liczy się dość długo na element i nie jest ograniczone pamięcią
+float work(uint32_t i) {
+    float x = static_cast<float>(i) * 0.001f;
+    for (int k = 0; k < 32; ++k) x = std::sqrt(x * x + 1.0f) * 0.999f;
+    return x;
+}
+}
+
+void benchJobs()
+{
+    constexpr uint32_t kItems = 1u << 20;
+    std::vector<float> out(kItems);
+
+    auto t0 = bench::Clock::now();
+    for (uint32_t i = 0; i < kItems; ++i) out[i] = work(i);
+    const double serial = bench::secondsSince(t0);
+    bench::report("jobs/serial", kItems, serial, "items");
+
+    const uint32_t hw = std::max(2u, std::thread::hardware_concurrency());
+    for (uint32_t workers = 1; workers < hw; workers *= 2) {
+        JobSystem jobs(workers);
+
+        t0 = bench::Clock::now();
+        jobs.parallelFor(0, kItems, 4096, [&](uint32_t b, uint32_t e) {
+            for (uint32_t i = b; i < e; ++i) out[i] = work(i);
+        });
+        const double t = bench::secondsSince(t0);
+        char name[64];
+        std::snprintf(name, sizeof(name), "jobs/parallel-for-%ut", workers + 1);
+        bench::report(name, kItems, t, "items");
+        std::printf("   speedup vs serial: %.2fx\n", serial / t);
+
+        // Narzut pojedynczego zadania: dużo pustych zadań z zależnością na końcu
+        constexpr int kJobs = 100000;
+        JobCounter batch, tail;
+        uint64_t sum = 0;
+        t0 = bench::Clock::now();
+        for (int i = 0; i < kJobs; ++i) jobs.schedule(batch, [] {});
+        jobs.schedule(tail, [&sum] { sum += 1; }, &batch);
+        jobs.wait(tail);
+        std::snprintf(name, sizeof(name), "jobs/empty-jobs-%ut", workers + 1);
+        bench::report(name, kJobs, bench::secondsSince(t0), "jobs");
+        bench::consume(sum);
+    }
+    bench::consume(static_cast<uint64_t>(out[kItems / 3]));
+}
@@ -0,0 +1,116 @@
+#include "Bench.h"
+#include "BenchMaps.h"
+#include "core/JobSystem.h"
+#include "game/Fov.h"
+#include "game/Lighting.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 500 świateł o promieniu 8 na mapie 512x512, 200 tur. Co turę rusza się 5% świateł (potwory
+// z pochodniami) i przełączają się drzwi. Punkt odniesienia: całe pole światła od nowa co turę.
+namespace {
+constexpr int kMapSize = 512;
+constexpr size_t kLights = 500;
+constexpr int kRadius = 8;
+constexpr int kTurns = 200;
+constexpr size_t kMovingPerTurn = kLights / 20;
+
+uint32_t lightColor(size_t i)
+{
+    static const uint32_t kColors[] = { 0x0040A0FFu, 0x00FF6040u, 0x0060FF60u, 0x00FFFFFFu };
+    return kColors[i % 4];
+}
+
+TilePos step(const TileMap& map, TilePos p, std::mt19937& rng)
+{
+    static const TilePos kDirs[] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+    const TilePos d = kDirs[rng() % 4];
+    const TilePos n{ p.x + d.x, p.y + d.y };
+    return map.walkable(n.x, n.y) ? n : p;
+}
+
+// Drzwi: kafel, który co turę zmienia się między ścianą a podłogą
+std::vector<TilePos> pickDoors(const TileMap& map, uint32_t seed)
+{
+    return bench::randomWalkable(map, kTurns, seed);
+}
+}
+
+void benchLighting()
+{
+    const TileMap base = bench::makeBenchMap(kMapSize, kMapSize, 11);
+    const std::vector<TilePos> starts = bench::randomWalkable(base, kLights, 12);
+    const std::vector<TilePos> doors = pickDoors(base, 13);
+    const uint64_t work = uint64_t(kLights) * kTurns;
+
+    {
+        TileMap map = base;
+        std::vector<TilePos> pos = starts;
+        std::vector<float> r(map.size()), g(map.size()), b(map.size());
+        std::mt19937 rng(5);
+        double seconds = 0.0;
+        for (int t = 0; t < kTurns; ++t) {
+            for (size_t k = 0; k < kMovingPerTurn; ++k) {
+                const size_t i = rng() % kLights;
+                pos[i] = step(map, pos[i], rng);
+            }
+            const TilePos door = doors[t];
+            map.set(door.x, door.y, map.at(door.x, door.y) == TileWall ? TileFloor : TileWall);
+
+            const auto t0 = bench::Clock::now();
+            std::fill(r.begin(), r.end(), 0.0f);
+            std::fill(g.begin(), g.end(), 0.0f);
+            std::fill(b.begin(), b.end(), 0.0f);
+            for (size_t i = 0; i < kLights; ++i) {
+                const uint32_t c = lightColor(i);
+                fov::shadowcast(map, pos[i], kRadius, [&](int x, int y, int dx, int dy) {
+                    const float d = 1.0f - std::sqrt(static_cast<float>(dx * dx + dy * dy)) / (kRadius + 1);
+                    const float f = d * d / 255.0f;
+                    const size_t idx = map.index(x, y);
+                    r[idx] += f * (c & 0xFF);
+                    g[idx] += f * ((c >> 8) & 0xFF);
+                    b[idx] += f * ((c >> 16) & 0xFF);
+                });
+            }
+            seconds += bench::secondsSince(t0);
+        }
+        bench::consume(static_cast<uint64_t>(r[map.index(starts[0].x, starts[0].y)] * 1000.0f));
+        bench::report("lighting/full-recompute", work, seconds, "lights");
+        std::printf("   %.3f ms/turn\n", seconds * 1000.0 / kTurns);
+    }
+
+    JobSystem jobs;
+    for (JobSystem* pool : { static_cast<JobSystem*>(nullptr), &jobs }) {
+        TileMap map = base;
+        LightMap lights;
+        std::vector<LightMap::LightId> ids;
+        for (size_t i = 0; i < kLights; ++i) ids.push_back(lights.add({ starts[i], kRadius, lightColor(i) }));
+        lights.update(map, pool);
+
+        std::mt19937 rng(5);
+        double seconds = 0.0;
+        uint64_t recomputed = 0, blended = 0, resolved = 0;
+        for (int t = 0; t < kTurns; ++t) {
+            for (size_t k = 0; k < kMovingPerTurn; ++k) {
+                const size_t i = rng() % kLights;
+                lights.move(ids[i], step(map, lights.light(ids[i]).pos, rng));
+            }
+            const TilePos door = doors[t];
+            map.set(door.x, door.y, map.at(door.x, door.y) == TileWall ? TileFloor : TileWall);
+
+            const auto t0 = bench::Clock::now();
+            lights.update(map, pool);
+            seconds += bench::secondsSince(t0);
+            recomputed += lights.lastUpdate().recomputed;
+            blended += lights.lastUpdate().blendedTiles;
+            resolved += lights.dirty().area();
+        }
+        bench::consume(lights.at(starts[0].x, starts[0].y));
+        bench::report(pool ? "lighting/incremental-parallel" : "lighting/incremental", work, seconds, "lights");
+        std::printf("   %.3f ms/turn, %.1f lights recomputed/turn, %.0f tiles blended, %.0f texels changed per turn\n",
+            seconds * 1000.0 / kTurns, double(recomputed) / kTurns, double(blended) / kTurns, double(resolved) / kTurns);
+    }
+}
@@ -0,0 +1,69 @@
+#include "Bench.h"
+#include "core/Log.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+// Koszt logowania po stronie wywołującego: fprintf + fflush (jak std::cerr << std::endl)
+// vs logger asynchroniczny. Paczki mniejsze niż pierścień mierzą samo wstawienie, "sustained"
+// obejmuje też czekanie na wątek zapisu (blockWhenFull). Wszystko do pliku tymczasowego.
+void benchLog()
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "roguelike_bench_log.txt").string();
+    const char* validation = "Validation Error: [ VUID-vkCmdDraw-None-02859 ] Object 0: handle = 0x%llx, type = VK_OBJECT_TYPE_COMMAND_BUFFER";
+    constexpr uint32_t kMessages = 100000;
+    constexpr uint32_t kBurst = 512;
+
+    {
+        FILE* f = std::fopen(path.c_str(), "w");
+        if (!f) {
+            std::printf("log: cannot open %s\n", path.c_str());
+            return;
+        }
+        const auto t0 = bench::Clock::now();
+        for (uint32_t i = 0; i < kMessages; ++i) {
+            std::fprintf(f, "[Vulkan-ERROR] ");
+            std::fprintf(f, validation, static_cast<unsigned long long>(i));
+            std::fputc('\n', f);
+            std::fflush(f);
+        }
+        bench::report("log/stdio-flush", kMessages, bench::secondsSince(t0), "msgs");
+        std::fclose(f);
+    }
+
+    logger::Config config;
+    config.path = path.c_str();
+    config.blockWhenFull = true;
+    config.repeatLimit = 0;
+    logger::start(config);
+
+    double burstSeconds = 0.0;
+    for (uint32_t i = 0; i < kMessages; i += kBurst) {
+        const auto t0 = bench::Clock::now();
+        for (uint32_t j = 0; j < kBurst && i + j < kMessages; ++j)
+            logger::error(LogCategory::Vulkan, validation, static_cast<unsigned long long>(i + j));
+        burstSeconds += bench::secondsSince(t0);
+        logger::flush();
+    }
+    bench::report("log/async-burst", kMessages, burstSeconds, "msgs");
+
+    auto t0 = bench::Clock::now();
+    for (uint32_t i = 0; i < kMessages; ++i)
+        logger::error(LogCategory::Vulkan, validation, static_cast<unsigned long long>(i));
+    logger::flush();
+    bench::report("log/async-sustained", kMessages, bench::secondsSince(t0), "msgs");
+
+    logger::setCategoryEnabled(LogCategory::Vulkan, false);
+    t0 = bench::Clock::now();
+    for (uint32_t i = 0; i < kMessages * 10; ++i)
+        logger::error(LogCategory::Vulkan, validation, static_cast<unsigned long long>(i));
+    bench::report("log/filtered", kMessages * 10, bench::secondsSince(t0), "msgs");
+    logger::setCategoryEnabled(LogCategory::Vulkan, true);
+
+    const logger::Stats stats = logger::stats();
+    logger::stop();
+    std::printf("   log: %llu written, %llu dropped\n", static_cast<unsigned long long>(stats.written),
+        static_cast<unsigned long long>(stats.dropped));
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "game/TileMap.h"
+#include <random>
+#include <vector>
+
+namespace bench {
+
+// Mapa testowa: losowe proste ściany + szum, żeby były korytarze, zakręty i zamknięte kieszenie
+inline TileMap makeBenchMap(int w, int h, uint32_t seed) {
+    TileMap map(w, h, TileFloor);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> px(0, w - 1), py(0, h - 1), len(4, 40);
+    for (int i = 0; i < (w * h) / 300; ++i) {
+        const int x = px(rng), y = py(rng), l = len(rng);
+        const bool horizontal = rng() & 1;
+        for (int k = 0; k < l; ++k) {
+            const int tx = horizontal ? x + k : x, ty = horizontal ? y : y + k;
+            if (map.inBounds(tx, ty)) map.set(tx, ty, TileWall);
+        }
+    }
+    for (int i = 0; i < (w * h) / 20; ++i) map.set(px(rng), py(rng), TileWall);
+    return map;
+}
+
+inline std::vector<TilePos> randomWalkable(const TileMap& map, size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> px(0, map.width() - 1), py(0, map.height() - 1);
+    std::vector<TilePos> out;
+    out.reserve(count);
+    while (out.size() < count) {
+        TilePos p{ px(rng), py(rng) };
+        if (map.walkable(p.x, p.y)) out.push_back(p);
+    }
+    return out;
+}
+
+} // namespace bench
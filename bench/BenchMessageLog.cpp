@@ -0,0 +1,85 @@
+#include "Bench.h"
+#include "game/MessageLog.h"
+#include "game/Simulation.h"
+#include <cstdio>
+#include <deque>
+#include <string>
+
+// Dziennik walki z kilkudziesięciu gier symulacji (prawdziwy rozkład powtórzeń), odtworzony w kółko
+// jako 1M wiadomości do pierścienia 128k.
+// Punkt odniesienia: deque<string> z pop_front, jak prosty log z ograniczeniem długości.
+namespace {
+constexpr uint32_t kCapacity = 1u << 17;
+constexpr uint32_t kMessages = 1000000;
+constexpr uint32_t kSourceMessages = 50000;
+constexpr uint32_t kVisibleRows = 40;
+constexpr uint32_t kFrames = 1000;
+
+// Okno 40 wierszy w losowych miejscach - to, co panel z ImGuiListClipper czyta w klatce
+template <typename Get>
+double readWindows(uint32_t size, Get&& get)
+{
+    uint64_t sum = 0;
+    const auto t0 = bench::Clock::now();
+    for (uint32_t f = 0; f < kFrames; ++f) {
+        const uint32_t first = static_cast<uint32_t>((uint64_t(f) * 2654435761u) % (size - kVisibleRows));
+        for (uint32_t i = first; i < first + kVisibleRows; ++i) sum += get(i);
+    }
+    const double seconds = bench::secondsSince(t0);
+    bench::consume(sum);
+    return seconds;
+}
+}
+
+void benchMessageLog()
+{
+    // Źródło: ta sama symulacja co roguelike_sim, zapisana raz
+    MessageLog source(kSourceMessages);
+    {
+        uint64_t seed = 1;
+        while (source.total() < kSourceMessages) {
+            SimConfig config;
+            config.maxTurns = 5000;
+            Simulation sim(seed++, config);
+            sim.setLog(&source);
+            sim.run();
+        }
+    }
+    std::vector<std::string> messages;
+    messages.reserve(source.size());
+    for (uint32_t i = 0; i < source.size(); ++i) messages.emplace_back(source.line(i).text);
+    std::printf("messagelog: %zu source lines, %zu distinct\n", messages.size(), source.internedCount());
+
+    {
+        std::deque<std::string> log;
+        size_t bytes = 0;
+        const auto t0 = bench::Clock::now();
+        for (uint32_t i = 0; i < kMessages; ++i) {
+            const std::string& m = messages[i % messages.size()];
+            if (log.size() == kCapacity) {
+                bytes -= log.front().capacity();
+                log.pop_front();
+            }
+            log.push_back(m);
+            bytes += log.back().capacity();
+        }
+        bench::report("messagelog/deque-string", kMessages, bench::secondsSince(t0), "msgs");
+        std::printf("   %.1f MB of strings\n", bytes / (1024.0 * 1024.0));
+    }
+
+    MessageLog log(kCapacity);
+    const auto t0 = bench::Clock::now();
+    for (uint32_t i = 0; i < kMessages; ++i) log.add(MessageKind::Combat, i, messages[i % messages.size()]);
+    bench::report("messagelog/interned-ring", kMessages, bench::secondsSince(t0), "msgs");
+    std::printf("   %u lines kept, %zu interned strings, %.1f KB of text\n", log.size(), log.internedCount(),
+        log.internedBytes() / 1024.0);
+
+    for (uint32_t size : { 1000u, kCapacity }) {
+        MessageLog sized(size);
+        for (uint32_t i = 0; i < size * 2; ++i) sized.add(MessageKind::Combat, i, messages[i % messages.size()]);
+        const double seconds = readWindows(sized.size(), [&](uint32_t i) { return sized.line(i).text.size(); });
+        char name[64];
+        std::snprintf(name, sizeof(name), "messagelog/visible-window-%u", size);
+        bench::report(name, uint64_t(kFrames) * kVisibleRows, seconds, "rows");
+    }
+}
@@ -0,0 +1,71 @@
+#include "Bench.h"
+#include "BenchMaps.h"
+#include "game/Pathfinding.h"
+#include <random>
+#include <vector>
+
+using bench::makeBenchMap;
+using bench::randomWalkable;
+
+void benchPathfinding()
+{
+    const TileMap map = makeBenchMap(512, 512, 1234);
+    Pathfinder pf(map);
+    std::vector<TilePos> path;
+    path.reserve(4096);
+
+    // Krótkie zapytania (potwór -> gracz w promieniu ~32 kafli) i długie (przez całą mapę)
+    constexpr size_t kShort = 4000, kLong = 200;
+    const auto starts = randomWalkable(map, kShort, 1);
+    std::vector<TilePos> goals;
+    goals.reserve(kShort);
+    {
+        std::mt19937 rng(2);
+        std::uniform_int_distribution<int> off(-32, 32);
+        for (const auto& s : starts) {
+            TilePos g{ s.x + off(rng), s.y + off(rng) };
+            while (!map.walkable(g.x, g.y)) g = { s.x + off(rng), s.y + off(rng) };
+            goals.push_back(g);
+        }
+    }
+    const auto longA = randomWalkable(map, kLong, 3);
+    const auto longB = randomWalkable(map, kLong, 4);
+
+    // Rozgrzewka - pierwsze zapytanie alokuje tablice węzłów
+    pf.findPath(starts[0], goals[0], path);
+
+    auto run = [&](const char* name, Pathfinder::Algorithm algo, const std::vector<TilePos>& a,
+                   const std::vector<TilePos>& b, std::vector<uint32_t>* costs) {
+        uint64_t expanded = 0;
+        auto t0 = bench::Clock::now();
+        for (size_t i = 0; i < a.size(); ++i) {
+            const bool ok = pf.findPath(a[i], b[i], path, algo);
+            expanded += pf.lastExpanded();
+            if (costs) costs->push_back(ok ? pf.lastPathCost() : 0);
+        }
+        bench::report(name, a.size(), bench::secondsSince(t0), "paths");
+        bench::consume(expanded);
+    };
+
+    std::vector<uint32_t> costA, costJ;
+    costA.reserve(kShort);
+    costJ.reserve(kShort);
+    run("astar/short", Pathfinder::Algorithm::AStar, starts, goals, &costA);
+    run("jps/short", Pathfinder::Algorithm::JumpPoint, starts, goals, &costJ);
+    run("astar/long", Pathfinder::Algorithm::AStar, longA, longB, nullptr);
+    run("jps/long", Pathfinder::Algorithm::JumpPoint, longA, longB, nullptr);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < costA.size(); ++i) mismatches += costA[i] != costJ[i];
+    if (mismatches) std::printf("!! A* / JPS cost mismatch on %zu paths\n", mismatches);
+
+    // Cache: te same pary odpytywane kilka razy w turze (np. grupa potworów z jednego pokoju)
+    PathCache cache(pf, map);
+    auto t0 = bench::Clock::now();
+    for (int turn = 0; turn < 4; ++turn)
+        for (size_t i = 0; i < 128; ++i)
+            cache.findPath(starts[i], goals[i], path);
+    bench::report("jps/cached", 4 * 128, bench::secondsSince(t0), "paths");
+    std::printf("   cache hits=%llu misses=%llu\n",
+        static_cast<unsigned long long>(cache.hits()), static_cast<unsigned long long>(cache.misses()));
+}
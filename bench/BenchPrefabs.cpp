@@ -0,0 +1,87 @@
+#include "Bench.h"
+#include "core/Hash.h"
+#include "game/Animation.h"
+#include "game/Prefab.h"
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Spawn fali potworów: dotychczasowa droga (ścieżka tekstury jako napis + getOrLoad po mapie,
+// rozmiary w kodzie) vs prefab rozwiązany przy wczytaniu (kopia rekordu po indeksie).
+namespace {
+struct SpawnedEntity {
+    int sprite;
+    uint32_t width;
+    uint32_t height;
+    float x, y;
+};
+
+struct Resolved {
+    int sprite;
+    uint32_t width;
+    uint32_t height;
+};
+}
+
+void benchPrefabs()
+{
+    constexpr int kKinds = 64;
+    constexpr uint32_t kSpawns = 1000000;
+
+    std::string text;
+    std::vector<std::string> paths;
+    for (int i = 0; i < kKinds; ++i) {
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), "assets/characters/monster_%03d.png", i);
+        paths.emplace_back(buf);
+        std::snprintf(buf, sizeof(buf), "prefab monster_%03d sprite %s 32 32\n", i, paths.back().c_str());
+        text += buf;
+    }
+    AnimationLibrary animations;
+    auto t0 = bench::Clock::now();
+    const std::vector<uint8_t> binary = PrefabTable::compile(text, animations, 0);
+    bench::report("prefabs/compile-64", kKinds, bench::secondsSince(t0), "prefabs");
+
+    PrefabTable table;
+    t0 = bench::Clock::now();
+    for (int i = 0; i < 1000; ++i) table.load(binary);
+    bench::report("prefabs/load-64", 1000, bench::secondsSince(t0), "tables");
+
+    std::unordered_map<std::string, int> byPath;   // jak Assets::byPath_
+    for (int i = 0; i < kKinds; ++i) byPath[paths[i]] = i;
+    std::vector<Resolved> resolved;
+    for (const PrefabRecord& r : table.prefabs()) resolved.push_back({ byPath[std::string(table.path(r.pathIndex))], r.width, r.height });
+
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> pick(0, kKinds - 1);
+    std::vector<int> wave(kSpawns);
+    for (int& w : wave) w = pick(rng);
+    std::vector<int> waveIds(kSpawns);
+    for (uint32_t i = 0; i < kSpawns; ++i) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "monster_%03d", wave[i]);
+        waveIds[i] = table.find(hashString(name));
+    }
+
+    std::vector<SpawnedEntity> out;
+    out.reserve(kSpawns);
+    t0 = bench::Clock::now();
+    for (uint32_t i = 0; i < kSpawns; ++i) {
+        const char* path = paths[wave[i]].c_str();
+        out.push_back({ byPath.find(path)->second, 32, 32, float(i & 511), float(i >> 9) });
+    }
+    bench::report("prefabs/spawn-by-path", kSpawns, bench::secondsSince(t0), "spawns");
+    bench::consume(out.size());
+
+    out.clear();
+    t0 = bench::Clock::now();
+    for (uint32_t i = 0; i < kSpawns; ++i) {
+        const Resolved& p = resolved[waveIds[i]];
+        out.push_back({ p.sprite, p.width, p.height, float(i & 511), float(i >> 9) });
+    }
+    bench::report("prefabs/spawn-by-prefab", kSpawns, bench::secondsSince(t0), "spawns");
+    bench::consume(out.size());
+}
@@ -0,0 +1,68 @@
+#include "Bench.h"
+#include "BenchMaps.h"
+#include "game/SaveGame.h"
+#include <cstdio>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+
+void benchSave()
+{
+    constexpr uint32_t kEntities = 100000;
+    const std::string path = (std::filesystem::temp_directory_path() / "roguelike_bench.rlsv").string();
+
+    World world;
+    world.tiles = bench::makeBenchMap(1024, 1024, 77);
+    world.rng.reseed(9);
+    const auto positions = bench::randomWalkable(world.tiles, kEntities, 3);
+
+    SaveSystem saves(path);
+
+    // Migawka na wątku gry - tylko kopie, reszta w tle
+    auto capture = [&](WorldSnapshot& s) {
+        s.capture(world);
+        s.entities.resize(kEntities);
+        for (uint32_t i = 0; i < kEntities; ++i)
+            s.entities[i] = { 0x1234u + i % 16, positions[i].x * 32.0f, positions[i].y * 32.0f, 32, 32 };
+        s.assetPaths.assign({ "assets/player.png", "assets/monster.png" });
+    };
+
+    WorldSnapshot* snap = saves.beginSave();
+    auto t0 = bench::Clock::now();
+    capture(*snap);
+    bench::report("save/capture-1024-100k", 1, bench::secondsSince(t0), "snaps");
+    saves.commitSave(false);
+    saves.waitIdle();
+    SaveStats st = saves.lastStats();
+    bench::report("save/full-write", st.bytesWritten, st.writeMs / 1000.0, "bytes");
+
+    // Kilka zmian w kilku chunkach -> zapis przyrostowy
+    for (int i = 0; i < 8; ++i) {
+        for (int k = 0; k < 16; ++k)
+            world.tiles.set(100 + i * 97 + k, 200 + i * 53, TileWall);
+        ++world.turn;
+        snap = saves.beginSave();
+        capture(*snap);
+        saves.commitSave(true);
+        saves.waitIdle();
+    }
+    st = saves.lastStats();
+    bench::report("save/incremental-write", st.bytesWritten, st.writeMs / 1000.0, "bytes");
+    std::printf("   last delta: %u chunks, %s\n", st.chunksWritten, st.incremental ? "incremental" : "full");
+
+    std::error_code ec;
+    WorldSnapshot loaded;
+    t0 = bench::Clock::now();
+    const bool ok = loadWorld(path, loaded);
+    bench::report("save/load-base+deltas", 1, bench::secondsSince(t0), "loads");
+    std::printf("   loaded: %s, tiles match: %s, turn %llu, base %llu B, delta %llu B\n",
+        ok ? "yes" : "no",
+        loaded.tiles.size() == world.tiles.size() &&
+            std::equal(loaded.tiles.begin(), loaded.tiles.end(), world.tiles.data()) ? "yes" : "no",
+        static_cast<unsigned long long>(loaded.turn),
+        static_cast<unsigned long long>(std::filesystem::file_size(path)),
+        static_cast<unsigned long long>(std::filesystem::file_size(path + ".delta", ec)));
+
+    std::filesystem::remove(path, ec);
+    std::filesystem::remove(path + ".delta", ec);
+}
@@ -0,0 +1,80 @@
+#include "Bench.h"
+#include "BenchMaps.h"
+#include "game/TurnScheduler.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+void benchTurns()
+{
+    constexpr uint32_t kActors = 100000;
+    constexpr uint64_t kActions = 5000000;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> speed(50, 200), cost(50, 150);
+
+    std::vector<uint32_t> speeds(kActors);
+    for (auto& s : speeds) s = speed(rng);
+
+    TurnScheduler sched;
+    for (uint32_t i = 0; i < kActors; ++i) sched.addActor(speeds[i], i % 100);
+
+    // Co 64. akcja aktor ginie i pojawia się nowy - usuwanie ma być tanie
+    uint64_t acted = 0, deaths = 0;
+    TurnScheduler::Turn t;
+    auto t0 = bench::Clock::now();
+    while (acted < kActions && sched.next(t)) {
+        ++acted;
+        if ((acted & 63) == 0) {
+            sched.removeActor(t.actor);
+            sched.addActor(speed(rng), cost(rng));
+            ++deaths;
+            continue;
+        }
+        sched.endTurn(t.actor, cost(rng));
+    }
+    bench::report("turns/scheduler-100k", acted, bench::secondsSince(t0), "actions");
+    std::printf("   deaths/respawns: %llu, game time: %llu ticks\n",
+        static_cast<unsigned long long>(deaths), static_cast<unsigned long long>(sched.now()));
+
+    // Dla porównania: naiwna pętla po wszystkich aktorach co tick
+    {
+        std::vector<uint32_t> energy(kActors, 0);
+        uint64_t naiveActed = 0, ticks = 0;
+        t0 = bench::Clock::now();
+        while (naiveActed < kActions / 10) {
+            ++ticks;
+            for (uint32_t i = 0; i < kActors; ++i) {
+                energy[i] += speeds[i];
+                if (energy[i] >= 100 * TurnScheduler::kActionCost) {
+                    energy[i] -= 100 * TurnScheduler::kActionCost;
+                    ++naiveActed;
+                }
+            }
+        }
+        bench::report("turns/naive-tick-100k", naiveActed, bench::secondsSince(t0), "actions");
+        bench::consume(ticks);
+    }
+
+    // LOD po odległości: gracz na środku mapy 512x512, dalecy aktorzy śpią albo mają grube tury
+    {
+        const TileMap map = bench::makeBenchMap(512, 512, 1234);
+        const auto positions = bench::randomWalkable(map, kActors, 5);
+        TurnScheduler lodSched;
+        for (uint32_t i = 0; i < kActors; ++i) lodSched.addActor(speeds[i], i % 100);
+        const TilePos player{ 256, 256 };
+
+        t0 = bench::Clock::now();
+        lodSched.applyDistanceLod(positions, player, 24, 64);
+        bench::report("turns/apply-lod-100k", kActors, bench::secondsSince(t0), "actors");
+
+        uint64_t lodActed = 0;
+        t0 = bench::Clock::now();
+        const uint64_t end = lodSched.now() + 100 * 100;   // 100 tur gracza
+        while (lodSched.next(t) && t.time < end) {
+            lodActed += t.steps;
+            lodSched.endTurn(t.actor);
+        }
+        bench::report("turns/lod-100-player-turns", lodActed, bench::secondsSince(t0), "actions");
+        std::printf("   scheduled (awake) actors: %zu of %zu\n", lodSched.scheduledCount(), lodSched.actorCount());
+    }
+}
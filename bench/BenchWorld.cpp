@@ -0,0 +1,209 @@
+#include "Bench.h"
+#include "app/Assets.h"
+#include "app/Game.h"
+#include "app/WorldDraw.h"
+#include "core/JobSystem.h"
+#include "game/Animation.h"
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if __has_include(<stb_image.h>)
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#else
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+#endif
+
+// Kod aplikacji bez okna i urządzenia: encje, dekodowanie PNG, budowanie listy świata.
+// Budowane tylko z ENABLE_VCPKG_DEPS (ImGui, stb); ścieżka assetów przychodzi z CMake.
+namespace {
+constexpr uint32_t kSizes[] = { 1000, 10000, 100000 };
+constexpr float kWorldW = 480.0f;   // rozdzielczość wewnętrzna świata (WorldTarget)
+constexpr float kWorldH = 270.0f;
+
+// Encje jak ze spawn(): każda osobno na stercie, przeplatana z innymi alokacjami
+std::vector<Entity*> makeEntities(uint32_t count, std::vector<std::unique_ptr<char[]>>& noise, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> x(-64.0f, kWorldW), y(-64.0f, kWorldH);
+    std::vector<Entity*> entities;
+    entities.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        entities.push_back(new Entity(static_cast<int>(i % 4), 32, 32, x(rng), y(rng)));
+        noise.push_back(std::make_unique<char[]>(48));
+    }
+    return entities;
+}
+
+std::string benchName(const char* prefix, uint32_t count)
+{
+    return std::string(prefix) + "-" + (count >= 1000 ? std::to_string(count / 1000) + "k" : std::to_string(count));
+}
+}
+
+void benchEntities()
+{
+    std::mt19937 rng(3);
+    for (uint32_t count : kSizes) {
+        std::vector<std::unique_ptr<char[]>> noise;
+        std::vector<Entity*> entities = makeEntities(count, noise, rng);
+        const uint32_t passes = 20000000 / count;
+
+        // Obecny układ: wektor wskaźników, gettery poza linią (game.cpp)
+        uint64_t visible = 0;
+        auto t0 = bench::Clock::now();
+        for (uint32_t p = 0; p < passes; ++p) {
+            for (const Entity* e : entities) {
+                const ImVec2 pos = e->getPosition();
+                visible += pos.x + e->getWidth() > 0.0f && pos.x < kWorldW && pos.y + e->getHeight() > 0.0f && pos.y < kWorldH;
+            }
+        }
+        bench::report(benchName("entities/ptr-vector-cull", count).c_str(), uint64_t(count) * passes, bench::secondsSince(t0), "entities");
+
+        // Te same dane w tablicach (SoA) - punkt odniesienia dla nowego układu
+        std::vector<float> px(count), py(count), w(count), h(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const ImVec2 pos = entities[i]->getPosition();
+            px[i] = pos.x; py[i] = pos.y;
+            w[i] = static_cast<float>(entities[i]->getWidth());
+            h[i] = static_cast<float>(entities[i]->getHeight());
+        }
+        t0 = bench::Clock::now();
+        for (uint32_t p = 0; p < passes; ++p)
+            for (uint32_t i = 0; i < count; ++i)
+                visible += px[i] + w[i] > 0.0f && px[i] < kWorldW && py[i] + h[i] > 0.0f && py[i] < kWorldH;
+        bench::report(benchName("entities/soa-cull", count).c_str(), uint64_t(count) * passes, bench::secondsSince(t0), "entities");
+        bench::consume(visible);
+
+        for (Entity* e : entities) delete e;
+    }
+}
+
+// Dekodowanie jak Assets::decode (stb, RGBA8) plus kopia do bufora staging z addDecoded.
+// Sam upload na GPU wymaga urządzenia - mierzy go raport startu gry (--startup-report).
+void benchDecode()
+{
+    const char* files[] = { "characters/hero_idle.png", "characters/angel_idle.png" };
+    std::vector<std::vector<unsigned char>> encoded;
+    for (const char* f : files) {
+        std::ifstream in(std::string(ROGUELIKE_ASSET_DIR) + "/" + f, std::ios::binary);
+        if (!in) { std::printf("decode: missing %s, skipped\n", f); return; }
+        encoded.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    constexpr int kRounds = 200;
+    uint64_t pixelBytes = 0;
+    std::vector<unsigned char> staging;
+    double decodeSeconds = 0.0, copySeconds = 0.0;
+    for (int r = 0; r < kRounds; ++r) {
+        for (const auto& png : encoded) {
+            int w = 0, h = 0, channels = 0;
+            auto t0 = bench::Clock::now();
+            stbi_uc* pixels = stbi_load_from_memory(png.data(), static_cast<int>(png.size()), &w, &h, &channels, STBI_rgb_alpha);
+            decodeSeconds += bench::secondsSince(t0);
+            if (!pixels) { std::printf("decode: %s\n", stbi_failure_reason()); return; }
+            const size_t bytes = static_cast<size_t>(w) * h * 4;
+            staging.resize(bytes);
+            t0 = bench::Clock::now();
+            std::memcpy(staging.data(), pixels, bytes);
+            copySeconds += bench::secondsSince(t0);
+            pixelBytes += bytes;
+            stbi_image_free(pixels);
+        }
+    }
+    bench::report("decode/stb-rgba8", pixelBytes, decodeSeconds, "bytes");
+    bench::report("decode/staging-copy", pixelBytes, copySeconds, "bytes");
+
+    // Równolegle jak przy starcie gry (Startup.cpp)
+    JobSystem jobs;
+    const uint32_t tasks = kRounds * static_cast<uint32_t>(encoded.size());
+    std::atomic<uint64_t> decoded{ 0 };
+    auto t0 = bench::Clock::now();
+    jobs.parallelFor(0, tasks, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const auto& png = encoded[i % encoded.size()];
+            int w = 0, h = 0, channels = 0;
+            stbi_uc* pixels = stbi_load_from_memory(png.data(), static_cast<int>(png.size()), &w, &h, &channels, STBI_rgb_alpha);
+            if (pixels) decoded.fetch_add(static_cast<uint64_t>(w) * h * 4, std::memory_order_relaxed);
+            stbi_image_free(pixels);
+        }
+    });
+    bench::report("decode/stb-rgba8-parallel", decoded.load(), bench::secondsSince(t0), "bytes");
+}
+
+// drawEntities na jednej liście i drawEntityBatches (to samo co drawWorld) po kolei
+// i na wątkach roboczych - na samodzielnych ImDrawList, bez kontekstu ImGui
+void benchDrawWorld()
+{
+    AnimationLibrary library;
+    library.loadFromText(
+        "sheet a a.png 32 32\n"
+        "sheet b b.png 32 32\n"
+        "clip a_idle a 0 4 6 loop\n"
+        "clip b_idle b 0 4 8 loop\n");
+
+    std::vector<SpriteGPU> sprites(4);
+    for (size_t i = 0; i < sprites.size(); ++i) {
+        sprites[i].imTex = (ImTextureID)(intptr_t)(i + 1);
+        sprites[i].width = 128;
+        sprites[i].height = 32;
+        sprites[i].ready = true;
+    }
+
+    ImDrawListSharedData shared;
+    ImDrawList dl(&shared);
+    std::vector<std::unique_ptr<ImDrawList>> batchLists;
+    std::vector<ImDrawList*> lists;
+    JobSystem jobs;
+    std::printf("drawworld: %u threads\n", jobs.workerCount() + 1);
+    std::mt19937 rng(5);
+    for (uint32_t count : kSizes) {
+        std::vector<std::unique_ptr<char[]>> noise;
+        std::vector<Entity*> entities = makeEntities(count, noise, rng);
+        Animator animator(library);
+        for (uint32_t i = 0; i < count; ++i)
+            if (i % 4 < 2) entities[i]->setAnimation(animator.add(static_cast<uint16_t>(i % 2), 0.01f * i));
+
+        const uint32_t frames = 2000000 / count;
+        uint64_t vertices = 0;
+        auto t0 = bench::Clock::now();
+        for (uint32_t f = 0; f < frames; ++f) {
+            dl._ResetForNewFrame();
+            dl.PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(kWorldW, kWorldH));
+            drawEntities(&dl, entities, sprites, animator);
+            dl.PopClipRect();
+            vertices += static_cast<uint64_t>(dl.VtxBuffer.Size);
+        }
+        bench::report(benchName("drawworld/build", count).c_str(), uint64_t(count) * frames, bench::secondsSince(t0), "entities");
+
+        while (lists.size() < entityBatchCount(count)) {
+            batchLists.push_back(std::make_unique<ImDrawList>(&shared));
+            lists.push_back(batchLists.back().get());
+        }
+        for (JobSystem* pool : { static_cast<JobSystem*>(nullptr), &jobs }) {
+            t0 = bench::Clock::now();
+            for (uint32_t f = 0; f < frames; ++f) {
+                drawEntityBatches(pool, std::span<ImDrawList* const>(lists.data(), entityBatchCount(count)),
+                    ImVec2(0.0f, 0.0f), ImVec2(kWorldW, kWorldH), entities, sprites, animator);
+                for (uint32_t b = 0; b < entityBatchCount(count); ++b) {
+                    lists[b]->PopClipRect();
+                    vertices += static_cast<uint64_t>(lists[b]->VtxBuffer.Size);
+                }
+            }
+            const std::string name = benchName(pool ? "drawworld/batches-parallel" : "drawworld/batches", count);
+            bench::report(name.c_str(), uint64_t(count) * frames, bench::secondsSince(t0), "entities");
+        }
+        bench::consume(vertices);
+
+        for (Entity* e : entities) delete e;
+    }
+}
@@ -0,0 +1,122 @@
+#include "Bench.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+void benchPathfinding();
+void benchDijkstra();
+void benchJobs();
+void benchTurns();
+void benchSave();
+void benchAnimation();
+void benchArena();
+void benchAssets();
+void benchPrefabs();
+void benchFrameGraph();
+void benchDrawSort();
+void benchLog();
+void benchDirtyRegion();
+void benchChunkStore();
+void benchParticles();
+void benchLighting();
+void benchMessageLog();
+#ifdef ROGUELIKE_BENCH_WORLD
+void benchEntities();
+void benchDecode();
+void benchDrawWorld();
+#endif
+
+namespace {
+struct BenchEntry {
+    const char* name;
+    void (*fn)();
+};
+
+const BenchEntry kBenches[] = {
+    { "pathfinding", benchPathfinding },
+    { "dijkstra", benchDijkstra },
+    { "jobs", benchJobs },
+    { "turns", benchTurns },
+    { "save", benchSave },
+    { "animation", benchAnimation },
+    { "arena", benchArena },
+    { "assets", benchAssets },
+    { "prefabs", benchPrefabs },
+    { "framegraph", benchFrameGraph },
+    { "drawsort", benchDrawSort },
+    { "log", benchLog },
+    { "dirtyregion", benchDirtyRegion },
+    { "chunkstore", benchChunkStore },
+    { "particles", benchParticles },
+    { "lighting", benchLighting },
+    { "messagelog", benchMessageLog },
+#ifdef ROGUELIKE_BENCH_WORLD
+    // Kod aplikacji (Entity, ImDrawList, stb) - tylko z ENABLE_VCPKG_DEPS
+    { "entities", benchEntities },
+    { "decode", benchDecode },
+    { "drawworld", benchDrawWorld },
+#endif
+};
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+bool writeJson(const char* path, int repeat) {
+    FILE* f = std::fopen(path, "w");
+    if (!f) return false;
+#ifdef NDEBUG
+    const char* build = "release";
+#else
+    const char* build = "debug";
+#endif
+    std::fprintf(f, "{\n  \"build\": \"%s\",\n  \"repeat\": %d,\n  \"benchmarks\": [", build, repeat);
+    const auto& all = bench::results();
+    for (size_t i = 0; i < all.size(); ++i) {
+        const bench::Result& r = all[i];
+        const double perSec = r.seconds > 0.0 ? static_cast<double>(r.ops) / r.seconds : 0.0;
+        std::fprintf(f, "%s\n    {\"name\": \"%s\", \"ops\": %llu, \"unit\": \"%s\", \"seconds\": %.9g, \"per_second\": %.9g}",
+            i ? "," : "", jsonEscape(r.name).c_str(), static_cast<unsigned long long>(r.ops),
+            jsonEscape(r.unit).c_str(), r.seconds, perSec);
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+}
+
+// Użycie: roguelike_bench [fragment-nazwy] [--json <plik>] [--repeat <n>]
+// Porównanie dwóch plików JSON: tools/bench_compare.py
+int main(int argc, char** argv) {
+    const char* filter = nullptr;
+    const char* jsonPath = nullptr;
+    int repeat = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--json") && i + 1 < argc) jsonPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--repeat") && i + 1 < argc) repeat = std::max(1, std::atoi(argv[++i]));
+        else if (argv[i][0] != '-' && !filter) filter = argv[i];
+        else {
+            std::fprintf(stderr, "Usage: roguelike_bench [filter] [--json <file>] [--repeat <n>]\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (int run = 0; run < repeat; ++run) {
+        for (const auto& b : kBenches) {
+            if (filter && !std::strstr(b.name, filter)) continue;
+            std::printf("== %s ==\n", b.name);
+            b.fn();
+        }
+    }
+    if (jsonPath && !writeJson(jsonPath, repeat)) {
+        std::fprintf(stderr, "Failed to write %s\n", jsonPath);
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
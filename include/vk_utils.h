@@ -10,5 +10,8 @@ inline void checkVk(VkResult res, const char* msg) {
         throw std::runtime_error(msg);
     }
 }
+
+// Callbacki liczące pamięć hosta sterownika (src/app/MemoryTracking.cpp) - do każdego vkCreate*/vkDestroy*
+const VkAllocationCallbacks* allocator();
 } // namespace vkutils
 
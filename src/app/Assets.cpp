@@ -1,7 +1,11 @@
 #include "Assets.h"
+#include "FrameGraphVulkan.h"
 #include <imgui_impl_vulkan.h>
+#include <vk_utils.h>
+#include "core/AllocTracker.h"
 #include <stdexcept>
 #include <cstring>
+#include <algorithm>
 
 #if __has_include(<stb_image.h>)
 #define STB_IMAGE_IMPLEMENTATION
@@ -13,12 +17,23 @@
 #error "Nie znaleziono stb_image.h. Zainstaluj vcpkg 'stb' lub dodaj lokalny nagwek."
 #endif
 
-Assets::Assets(const Ctx& ctx) : ctx_(ctx) {}
-Assets::~Assets() { clear(); }
+Assets::Assets(const Ctx& ctx) : ctx_(ctx) {
+    VkCommandPoolCreateInfo pci{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    pci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    pci.queueFamilyIndex = ctx_.transferFamily;
+    if (vkCreateCommandPool(ctx_.device, &pci, vkutils::allocator(), &uploadPool_) != VK_SUCCESS)
+        throw std::runtime_error("Assets: failed to create upload command pool");
+}
+
+Assets::~Assets() {
+    clear();
+    for (VkFence f : freeFences_) vkDestroyFence(ctx_.device, f, vkutils::allocator());
+    freeFences_.clear();
+    if (uploadPool_) vkDestroyCommandPool(ctx_.device, uploadPool_, vkutils::allocator());
+}
 
 uint32_t Assets::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
-    VkPhysicalDeviceMemoryProperties memProps{};
-    vkGetPhysicalDeviceMemoryProperties(ctx_.physicalDevice, &memProps);
+    const VkPhysicalDeviceMemoryProperties& memProps = ctx_.memoryProperties;
     for (uint32_t i = 0; i < memProps.memoryTypeCount; i++) {
         if ((typeFilter & (1u << i)) && (memProps.memoryTypes[i].propertyFlags & properties) == properties)
             return i;
@@ -26,10 +41,10 @@ uint32_t Assets::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags prope
     throw std::runtime_error("Assets::findMemoryType: no suitable memory type");
 }
 
-VkCommandBuffer Assets::beginSingleTimeCommands() const {
+VkCommandBuffer Assets::beginUploadCommands() {
     VkCommandBufferAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
     allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = ctx_.commandPool;
+    allocInfo.commandPool = uploadPool_;
     allocInfo.commandBufferCount = 1;
 
     VkCommandBuffer cmd{};
@@ -41,14 +56,77 @@ VkCommandBuffer Assets::beginSingleTimeCommands() const {
     return cmd;
 }
 
-void Assets::endSingleTimeCommands(VkCommandBuffer cmd) const {
+// Wysyka bez czekania - fence sprawdzamy w pollUploads()
+void Assets::submitUpload(SpriteId id, VkCommandBuffer cmd, VkBuffer staging, VkDeviceMemory stagingMemory) {
     vkEndCommandBuffer(cmd);
+
+    VkFence fence = VK_NULL_HANDLE;
+    if (!freeFences_.empty()) {
+        fence = freeFences_.back();
+        freeFences_.pop_back();
+        vkResetFences(ctx_.device, 1, &fence);
+    } else {
+        VkFenceCreateInfo fci{ VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+        vkCreateFence(ctx_.device, &fci, vkutils::allocator(), &fence);
+    }
+
     VkSubmitInfo submit{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
     submit.commandBufferCount = 1;
     submit.pCommandBuffers = &cmd;
-    vkQueueSubmit(ctx_.graphicsQueue, 1, &submit, VK_NULL_HANDLE);
-    vkQueueWaitIdle(ctx_.graphicsQueue);
-    vkFreeCommandBuffers(ctx_.device, ctx_.commandPool, 1, &cmd);
+    if (vkQueueSubmit(ctx_.transferQueue, 1, &submit, fence) != VK_SUCCESS)
+        throw std::runtime_error("Assets: upload submit failed");
+    uploads_.push_back({ id, cmd, fence, staging, stagingMemory });
+}
+
+void Assets::retireUpload(Upload& u) {
+    vkFreeCommandBuffers(ctx_.device, uploadPool_, 1, &u.cmd);
+    vkDestroyBuffer(ctx_.device, u.staging, vkutils::allocator());
+    vkFreeMemory(ctx_.device, u.stagingMemory, vkutils::allocator());
+    freeFences_.push_back(u.fence);
+
+    if (u.id < 0 || static_cast<size_t>(u.id) >= sprites_.size() || !sprites_[u.id].image) return;
+    if (separateTransfer()) acquires_.push_back(u.id);
+    else sprites_[u.id].ready = true;
+}
+
+void Assets::pollUploads() {
+    size_t kept = 0;
+    for (size_t i = 0; i < uploads_.size(); ++i) {
+        if (vkGetFenceStatus(ctx_.device, uploads_[i].fence) == VK_SUCCESS) retireUpload(uploads_[i]);
+        else uploads_[kept++] = uploads_[i];
+    }
+    uploads_.resize(kept);
+}
+
+void Assets::waitUploads() {
+    for (Upload& u : uploads_) {
+        vkWaitForFences(ctx_.device, 1, &u.fence, VK_TRUE, UINT64_MAX);
+        retireUpload(u);
+    }
+    uploads_.clear();
+}
+
+// Druga poowa przekazania wasnoci (release nagraa kolejka transferu w addSpriteFromFile)
+void Assets::recordAcquires(VkCommandBuffer cmd) {
+    if (acquires_.empty()) return;
+    std::vector<VkImageMemoryBarrier> barriers;
+    barriers.reserve(acquires_.size());
+    for (SpriteId id : acquires_) {
+        SpriteGPU& s = sprites_[id];
+        if (!s.image) continue;
+        // Ukady jak w zwolnieniu (ta sama para dostpw). Semafora nie ma: acquires_ dostaje tylko
+        // upload, ktrego fence ju zaobserwowa pollUploads(), a zapis udostpnia bariera zwolnienia
+        VkImageMemoryBarrier b = imageBarrier(s.image, GpuAccess::TransferWrite, GpuAccess::ShaderRead);
+        b.srcAccessMask = 0;
+        b.srcQueueFamilyIndex = ctx_.transferFamily;
+        b.dstQueueFamilyIndex = ctx_.graphicsFamily;
+        barriers.push_back(b);
+        s.ready = true;
+    }
+    acquires_.clear();
+    if (barriers.empty()) return;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, vulkanAccess(GpuAccess::ShaderRead).stage, 0,
+        0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
 }
 
 void Assets::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
@@ -57,7 +135,7 @@ void Assets::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryP
     bci.size = size;
     bci.usage = usage;
     bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    vkCreateBuffer(ctx_.device, &bci, nullptr, &buffer);
+    vkCreateBuffer(ctx_.device, &bci, vkutils::allocator(), &buffer);
 
     VkMemoryRequirements memReq{};
     vkGetBufferMemoryRequirements(ctx_.device, buffer, &memReq);
@@ -65,56 +143,11 @@ void Assets::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryP
     VkMemoryAllocateInfo mai{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
     mai.allocationSize = memReq.size;
     mai.memoryTypeIndex = findMemoryType(memReq.memoryTypeBits, properties);
-    vkAllocateMemory(ctx_.device, &mai, nullptr, &bufferMemory);
+    vkAllocateMemory(ctx_.device, &mai, vkutils::allocator(), &bufferMemory);
     vkBindBufferMemory(ctx_.device, buffer, bufferMemory, 0);
 }
 
-void Assets::transitionImageLayout(VkImage image, VkFormat /*format*/,
-    VkImageLayout oldLayout, VkImageLayout newLayout) const {
-    VkCommandBuffer cmd = beginSingleTimeCommands();
-
-    VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
-    barrier.oldLayout = oldLayout;
-    barrier.newLayout = newLayout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = image;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-
-    VkPipelineStageFlags srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-    VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    barrier.srcAccessMask = 0;
-    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-    if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL &&
-        newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    }
-    else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED &&
-        newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-        // default OK
-    }
-    else {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    }
-
-    vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-    endSingleTimeCommands(cmd);
-}
-
-void Assets::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) const {
-    VkCommandBuffer cmd = beginSingleTimeCommands();
-
+void Assets::copyBufferToImage(VkCommandBuffer cmd, VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) const {
     VkBufferImageCopy region{};
     region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     region.imageSubresource.mipLevel = 0;
@@ -124,7 +157,48 @@ void Assets::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, u
     region.imageExtent = { width, height, 1 };
 
     vkCmdCopyBufferToImage(cmd, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-    endSingleTimeCommands(cmd);
+}
+
+void Assets::createDeviceImage(uint32_t width, uint32_t height, VkImage& image, VkDeviceMemory& memory) const {
+    VkImageCreateInfo ici{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+    ici.imageType = VK_IMAGE_TYPE_2D;
+    ici.extent = { width, height, 1 };
+    ici.mipLevels = 1;
+    ici.arrayLayers = 1;
+    ici.format = VK_FORMAT_R8G8B8A8_UNORM;
+    ici.tiling = VK_IMAGE_TILING_OPTIMAL;
+    ici.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    ici.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    ici.samples = VK_SAMPLE_COUNT_1_BIT;
+    ici.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    vkCreateImage(ctx_.device, &ici, vkutils::allocator(), &image);
+
+    VkMemoryRequirements memReq{};
+    vkGetImageMemoryRequirements(ctx_.device, image, &memReq);
+    VkMemoryAllocateInfo mai{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    mai.allocationSize = memReq.size;
+    mai.memoryTypeIndex = findMemoryType(memReq.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    vkAllocateMemory(ctx_.device, &mai, vkutils::allocator(), &memory);
+    vkBindImageMemory(ctx_.device, image, memory, 0);
+}
+
+VkSampler Assets::createSampler() const {
+    VkSamplerCreateInfo sci{ VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
+    sci.magFilter = VK_FILTER_LINEAR;
+    sci.minFilter = VK_FILTER_LINEAR;
+    sci.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    sci.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sci.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sci.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sci.maxAnisotropy = 1.0f;
+    sci.anisotropyEnable = VK_FALSE;
+    sci.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+    sci.unnormalizedCoordinates = VK_FALSE;
+
+    VkSampler sampler{};
+    vkCreateSampler(ctx_.device, &sci, vkutils::allocator(), &sampler);
+    return sampler;
 }
 
 VkImageView Assets::createImageView(VkImage image, VkFormat format) const {
@@ -137,14 +211,49 @@ VkImageView Assets::createImageView(VkImage image, VkFormat format) const {
     ivci.subresourceRange.layerCount = 1;
 
     VkImageView view{};
-    vkCreateImageView(ctx_.device, &ivci, nullptr, &view);
+    vkCreateImageView(ctx_.device, &ivci, vkutils::allocator(), &view);
     return view;
 }
 
+DecodedImage::DecodedImage(DecodedImage&& other) noexcept
+    : path(std::move(other.path)), width(other.width), height(other.height), pixels(other.pixels) {
+    other.pixels = nullptr;
+}
+
+DecodedImage& DecodedImage::operator=(DecodedImage&& other) noexcept {
+    if (this != &other) {
+        if (pixels) stbi_image_free(pixels);
+        path = std::move(other.path);
+        width = other.width;
+        height = other.height;
+        pixels = other.pixels;
+        other.pixels = nullptr;
+    }
+    return *this;
+}
+
+DecodedImage::~DecodedImage() {
+    if (pixels) stbi_image_free(pixels);
+}
+
+DecodedImage Assets::decode(const std::string& path) {
+    AllocScope scope(AllocTag::Assets);
+    DecodedImage img;
+    img.path = path;
+    int channels = 0;
+    img.pixels = stbi_load(path.c_str(), &img.width, &img.height, &channels, STBI_rgb_alpha);
+    return img;
+}
+
 SpriteId Assets::addSpriteFromFile(const std::string& path) {
-    int texW = 0, texH = 0, texC = 0;
-    stbi_uc* pixels = stbi_load(path.c_str(), &texW, &texH, &texC, STBI_rgb_alpha);
-    if (!pixels) throw std::runtime_error("Failed to load image: " + path);
+    return addDecoded(decode(path));
+}
+
+SpriteId Assets::addDecoded(DecodedImage&& image) {
+    AllocScope scope(AllocTag::Assets);
+    if (!image.pixels) throw std::runtime_error("Failed to load image: " + image.path);
+    const std::string path = image.path;
+    const int texW = image.width, texH = image.height;
 
     VkDeviceSize imageSize = static_cast<VkDeviceSize>(texW) * texH * 4;
 
@@ -157,53 +266,35 @@ SpriteId Assets::addSpriteFromFile(const std::string& path) {
 
     void* data = nullptr;
     vkMapMemory(ctx_.device, stagingMemory, 0, imageSize, 0, &data);
-    std::memcpy(data, pixels, static_cast<size_t>(imageSize));
+    std::memcpy(data, image.pixels, static_cast<size_t>(imageSize));
     vkUnmapMemory(ctx_.device, stagingMemory);
-    stbi_image_free(pixels);
+    image = DecodedImage();   // piksele ju w stagingu
 
     SpriteGPU s{};
+    createDeviceImage(static_cast<uint32_t>(texW), static_cast<uint32_t>(texH), s.image, s.memory);
+
+    // Kopia na kolejce transferu. Przy osobnej rodzinie kocowa bariera jest zwolnieniem wasnoci
+    // (przejcie nagrywa recordAcquires w buforze klatki), inaczej zwykym przejciem do odczytu.
+    VkCommandBuffer cmd = beginUploadCommands();
+    const VkImageMemoryBarrier toDst = imageBarrier(s.image, GpuAccess::None, GpuAccess::TransferWrite, true);
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, vulkanAccess(GpuAccess::TransferWrite).stage, 0,
+        0, nullptr, 0, nullptr, 1, &toDst);
+
+    copyBufferToImage(cmd, stagingBuffer, s.image, static_cast<uint32_t>(texW), static_cast<uint32_t>(texH));
+
+    VkImageMemoryBarrier toRead = imageBarrier(s.image, GpuAccess::TransferWrite, GpuAccess::ShaderRead);
+    VkPipelineStageFlags dstStage = vulkanAccess(GpuAccess::ShaderRead).stage;
+    if (separateTransfer()) {
+        toRead.dstAccessMask = 0;
+        toRead.srcQueueFamilyIndex = ctx_.transferFamily;
+        toRead.dstQueueFamilyIndex = ctx_.graphicsFamily;
+        dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    }
+    vkCmdPipelineBarrier(cmd, vulkanAccess(GpuAccess::TransferWrite).stage, dstStage, 0,
+        0, nullptr, 0, nullptr, 1, &toRead);
 
-    VkImageCreateInfo ici{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
-    ici.imageType = VK_IMAGE_TYPE_2D;
-    ici.extent = { static_cast<uint32_t>(texW), static_cast<uint32_t>(texH), 1 };
-    ici.mipLevels = 1;
-    ici.arrayLayers = 1;
-    ici.format = VK_FORMAT_R8G8B8A8_UNORM;
-    ici.tiling = VK_IMAGE_TILING_OPTIMAL;
-    ici.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    ici.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-    ici.samples = VK_SAMPLE_COUNT_1_BIT;
-    ici.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    vkCreateImage(ctx_.device, &ici, nullptr, &s.image);
-
-    VkMemoryRequirements memReq{};
-    vkGetImageMemoryRequirements(ctx_.device, s.image, &memReq);
-    VkMemoryAllocateInfo mai{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
-    mai.allocationSize = memReq.size;
-    mai.memoryTypeIndex = findMemoryType(memReq.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    vkAllocateMemory(ctx_.device, &mai, nullptr, &s.memory);
-    vkBindImageMemory(ctx_.device, s.image, s.memory, 0);
-
-    transitionImageLayout(s.image, ici.format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    copyBufferToImage(stagingBuffer, s.image, static_cast<uint32_t>(texW), static_cast<uint32_t>(texH));
-    transitionImageLayout(s.image, ici.format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-    s.view = createImageView(s.image, ici.format);
-
-    VkSamplerCreateInfo sci{ VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
-    sci.magFilter = VK_FILTER_LINEAR;
-    sci.minFilter = VK_FILTER_LINEAR;
-    sci.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-    sci.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-    sci.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-    sci.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-    sci.maxAnisotropy = 1.0f;
-    sci.anisotropyEnable = VK_FALSE;
-    sci.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
-    sci.unnormalizedCoordinates = VK_FALSE;
-
-    vkCreateSampler(ctx_.device, &sci, nullptr, &s.sampler);
+    s.view = createImageView(s.image, VK_FORMAT_R8G8B8A8_UNORM);
+    s.sampler = createSampler();
 
     VkDescriptorSet ds = ImGui_ImplVulkan_AddTexture(s.sampler, s.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
     s.imTex = (ImTextureID)(uintptr_t)ds;
@@ -211,11 +302,10 @@ SpriteId Assets::addSpriteFromFile(const std::string& path) {
     s.width = static_cast<uint32_t>(texW);
     s.height = static_cast<uint32_t>(texH);
 
-    vkDestroyBuffer(ctx_.device, stagingBuffer, nullptr);
-    vkFreeMemory(ctx_.device, stagingMemory, nullptr);
-
     sprites_.push_back(s);
     SpriteId id = static_cast<int>(sprites_.size() - 1);
+    // staging zwalnia pollUploads(), gdy kolejka transferu skoczy
+    submitUpload(id, cmd, stagingBuffer, stagingMemory);
 
     // <<< DODAJ: zapamitaj ciek i zaktualizuj cache (eby getOrLoad widzia ten asset)
     paths_.push_back(path);
@@ -236,15 +326,17 @@ SpriteId Assets::getOrLoad(const std::string& path)
 
 void Assets::destroySprite(const Ctx& ctx, SpriteGPU& s) {
     if (s.imTex) ImGui_ImplVulkan_RemoveTexture((VkDescriptorSet)(uintptr_t)s.imTex);
-    if (s.sampler) vkDestroySampler(ctx.device, s.sampler, nullptr);
-    if (s.view)    vkDestroyImageView(ctx.device, s.view, nullptr);
-    if (s.image)   vkDestroyImage(ctx.device, s.image, nullptr);
-    if (s.memory)  vkFreeMemory(ctx.device, s.memory, nullptr);
+    if (s.sampler) vkDestroySampler(ctx.device, s.sampler, vkutils::allocator());
+    if (s.view)    vkDestroyImageView(ctx.device, s.view, vkutils::allocator());
+    if (s.image)   vkDestroyImage(ctx.device, s.image, vkutils::allocator());
+    if (s.memory)  vkFreeMemory(ctx.device, s.memory, vkutils::allocator());
     s = SpriteGPU{};
 }
 
 void Assets::removeSprite(SpriteId id) {
     if (id < 0 || (size_t)id >= sprites_.size()) return;
+    if (!sprites_[id].ready) waitUploads();   // obraz moe by jeszcze celem kopii
+    acquires_.erase(std::remove(acquires_.begin(), acquires_.end(), id), acquires_.end());
 
     // Usu z cache jeli mamy ciek
     if (id < static_cast<SpriteId>(paths_.size())) {
@@ -262,8 +354,125 @@ void Assets::removeSprite(SpriteId id) {
 
 
 void Assets::clear() {
+    waitUploads();
+    acquires_.clear();
     for (auto& s : sprites_) destroySprite(ctx_, s);
     sprites_.clear();
+    for (auto& t : dynamic_) destroyDynamic(t);
+    dynamic_.clear();
     byPath_.clear();     // <<< DODAJ
     paths_.clear();      // <<< DODAJ
 }
+
+// --- Tekstury dynamiczne ---
+
+DynamicTextureId Assets::createDynamicTexture(uint32_t width, uint32_t height, uint32_t framesInFlight, uint32_t fill) {
+    AllocScope scope(AllocTag::Assets);
+    DynamicTexture t;
+    t.width = width;
+    t.height = height;
+    t.pixels.assign(static_cast<size_t>(width) * height, fill);
+    t.sampler = createSampler();
+    t.frames.resize(framesInFlight);
+    const VkDeviceSize bytes = static_cast<VkDeviceSize>(width) * height * 4;
+    for (DynamicTexture::Frame& f : t.frames) {
+        createDeviceImage(width, height, f.image, f.memory);
+        f.view = createImageView(f.image, VK_FORMAT_R8G8B8A8_UNORM);
+        f.imTex = (ImTextureID)(uintptr_t)ImGui_ImplVulkan_AddTexture(t.sampler, f.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        createBuffer(bytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, f.staging, f.stagingMemory);
+        void* mapped = nullptr;
+        vkMapMemory(ctx_.device, f.stagingMemory, 0, bytes, 0, &mapped);
+        f.mapped = static_cast<unsigned char*>(mapped);
+        f.dirty.add({ 0, 0, width, height });
+    }
+
+    for (size_t i = 0; i < dynamic_.size(); ++i) {
+        if (dynamic_[i].frames.empty()) {
+            dynamic_[i] = std::move(t);
+            return static_cast<DynamicTextureId>(i);
+        }
+    }
+    dynamic_.push_back(std::move(t));
+    return static_cast<DynamicTextureId>(dynamic_.size() - 1);
+}
+
+void Assets::destroyDynamic(DynamicTexture& t) {
+    for (DynamicTexture::Frame& f : t.frames) {
+        if (f.imTex) ImGui_ImplVulkan_RemoveTexture((VkDescriptorSet)(uintptr_t)f.imTex);
+        if (f.view) vkDestroyImageView(ctx_.device, f.view, vkutils::allocator());
+        if (f.image) vkDestroyImage(ctx_.device, f.image, vkutils::allocator());
+        if (f.memory) vkFreeMemory(ctx_.device, f.memory, vkutils::allocator());
+        if (f.staging) vkDestroyBuffer(ctx_.device, f.staging, vkutils::allocator());
+        if (f.stagingMemory) vkFreeMemory(ctx_.device, f.stagingMemory, vkutils::allocator());
+    }
+    if (t.sampler) vkDestroySampler(ctx_.device, t.sampler, vkutils::allocator());
+    t = DynamicTexture{};
+}
+
+// Obrazy mog by w klatkach w locie - rzadka operacja, wic po prostu czekamy na GPU
+void Assets::destroyDynamicTexture(DynamicTextureId id) {
+    if (id < 0 || static_cast<size_t>(id) >= dynamic_.size()) return;
+    vkDeviceWaitIdle(ctx_.device);
+    destroyDynamic(dynamic_[id]);
+}
+
+void Assets::markDirty(DynamicTextureId id, const DirtyRect& rect) {
+    for (DynamicTexture::Frame& f : dynamic_[id].frames) f.dirty.add(rect);
+}
+
+void Assets::setPixel(DynamicTextureId id, uint32_t x, uint32_t y, uint32_t rgba) {
+    DynamicTexture& t = dynamic_[id];
+    uint32_t& p = t.pixels[static_cast<size_t>(y) * t.width + x];
+    if (p == rgba) return;
+    p = rgba;
+    markDirty(id, { x, y, 1, 1 });
+}
+
+// Brudne prostokty obrazu klatki: wiersze pakowane do jego stagingu (od zera - poprzednia
+// zawarto ju skopiowana, klatka frame skoczya si na GPU), potem jedna bariera przed,
+// kopia per tekstura i jedna bariera po
+void Assets::recordDynamicUploads(VkCommandBuffer cmd, uint32_t frame) {
+    dynamicBarriers_.clear();
+    for (DynamicTexture& t : dynamic_) {
+        if (t.frames.empty() || t.frames[frame].dirty.empty()) continue;
+        DynamicTexture::Frame& f = t.frames[frame];
+        dynamicBarriers_.push_back(imageBarrier(f.image, f.written ? GpuAccess::ShaderRead : GpuAccess::None,
+            GpuAccess::TransferWrite, !f.written));
+    }
+    if (dynamicBarriers_.empty()) return;
+    dynamicStats_ = {};
+    vkCmdPipelineBarrier(cmd, vulkanAccess(GpuAccess::ShaderRead).stage, vulkanAccess(GpuAccess::TransferWrite).stage, 0,
+        0, nullptr, 0, nullptr, static_cast<uint32_t>(dynamicBarriers_.size()), dynamicBarriers_.data());
+
+    dynamicBarriers_.clear();
+    for (DynamicTexture& t : dynamic_) {
+        if (t.frames.empty() || t.frames[frame].dirty.empty()) continue;
+        DynamicTexture::Frame& f = t.frames[frame];
+        dynamicCopies_.clear();
+        VkDeviceSize offset = 0;
+        for (const DirtyRect& r : f.dirty.rects()) {
+            VkBufferImageCopy region{};
+            region.bufferOffset = offset;
+            region.bufferRowLength = r.width;
+            region.bufferImageHeight = r.height;
+            region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+            region.imageOffset = { static_cast<int32_t>(r.x), static_cast<int32_t>(r.y), 0 };
+            region.imageExtent = { r.width, r.height, 1 };
+            dynamicCopies_.push_back(region);
+            for (uint32_t row = 0; row < r.height; ++row) {
+                std::memcpy(f.mapped + offset, &t.pixels[static_cast<size_t>(r.y + row) * t.width + r.x], r.width * 4);
+                offset += r.width * 4;
+            }
+        }
+        vkCmdCopyBufferToImage(cmd, f.staging, f.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            static_cast<uint32_t>(dynamicCopies_.size()), dynamicCopies_.data());
+        dynamicStats_.regions += static_cast<uint32_t>(dynamicCopies_.size());
+        dynamicStats_.bytes += offset;
+        f.dirty.clear();
+        f.written = true;
+        dynamicBarriers_.push_back(imageBarrier(f.image, GpuAccess::TransferWrite, GpuAccess::ShaderRead));
+    }
+    vkCmdPipelineBarrier(cmd, vulkanAccess(GpuAccess::TransferWrite).stage, vulkanAccess(GpuAccess::ShaderRead).stage, 0,
+        0, nullptr, 0, nullptr, static_cast<uint32_t>(dynamicBarriers_.size()), dynamicBarriers_.data());
+}
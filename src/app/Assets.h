@@ -4,9 +4,12 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <span>
 #include <unordered_map>
+#include "core/DirtyRegion.h"
 
 using SpriteId = int;
+using DynamicTextureId = int;
 
 // GPU-strona sprite'a (bez pozycji/widocznoci  to jest logika gry)
 struct SpriteGPU {
@@ -17,27 +20,83 @@ struct SpriteGPU {
     ImTextureID    imTex = (ImTextureID)0;
     uint32_t       width = 0;
     uint32_t       height = 0;
+    bool           ready = false;   // upload zakoczony i obraz przejty przez kolejk graficzn
+};
+
+// Piksele RGBA8 po dekodowaniu pliku. Dekodowanie nie dotyka Vulkana, wic moe biec na wtku
+// roboczym jeszcze przed utworzeniem urzdzenia (start gry).
+struct DecodedImage {
+    std::string path;
+    int width = 0;
+    int height = 0;
+    unsigned char* pixels = nullptr;   // nullptr = bd dekodowania
+
+    DecodedImage() = default;
+    DecodedImage(DecodedImage&& other) noexcept;
+    DecodedImage& operator=(DecodedImage&& other) noexcept;
+    DecodedImage(const DecodedImage&) = delete;
+    DecodedImage& operator=(const DecodedImage&) = delete;
+    ~DecodedImage();
 };
 
 class Assets {
 public:
+    // transferQueue moe by t sam kolejk co graphicsQueue (urzdzenie bez osobnej rodziny transferu)
     struct Ctx {
         VkPhysicalDevice physicalDevice{};
+        VkPhysicalDeviceMemoryProperties memoryProperties{};
         VkDevice device{};
         VkQueue graphicsQueue{};
-        VkCommandPool commandPool{};
+        uint32_t graphicsFamily = 0;
+        VkQueue transferQueue{};
+        uint32_t transferFamily = 0;
     };
 
     explicit Assets(const Ctx& ctx);
     ~Assets();
 
+    // Zwraca od razu; tekstura jest wysyana w tle i rysowalna, gdy sprite(id).ready
     SpriteId addSpriteFromFile(const std::string& path);
     SpriteId getOrLoad(const std::string& path);
+    // Nie rzuca (bd = pixels == nullptr); addDecoded rzuca wyjtek dla nieudanego dekodowania
+    static DecodedImage decode(const std::string& path);
+    SpriteId addDecoded(DecodedImage&& image);
     const SpriteGPU& sprite(SpriteId id) const { return sprites_[id]; }
+    std::span<const SpriteGPU> sprites() const { return sprites_; }
+    const std::string& path(SpriteId id) const { return paths_[id]; }
 
     void removeSprite(SpriteId id);   // zostawia dziur  stabilne ID
     void clear();                     // czyci wszystko
 
+    // Raz na klatk: zwalnia bufory zakoczonych uploadw
+    void pollUploads();
+    // Na pocztku bufora polece klatki: przejcie obrazw od kolejki transferu
+    void recordAcquires(VkCommandBuffer cmd);
+    void waitUploads();
+    size_t pendingUploads() const { return uploads_.size() + acquires_.size(); }
+
+    // Tekstury zmieniane w trakcie gry (minimapa, mga wojny): kopia RGBA8 w pamici CPU i osobny
+    // obraz na kad klatk w locie, wic GPU nigdy nie czyta obrazu, do ktrego wanie piszemy.
+    // Zmiany (setPixel/markDirty) trafiaj do obszarw brudnych kadego obrazu; recordDynamicUploads
+    // kopiuje do obrazu biecej klatki tylko jego brudne prostokty, jednym vkCmdCopyBufferToImage.
+    DynamicTextureId createDynamicTexture(uint32_t width, uint32_t height, uint32_t framesInFlight, uint32_t fill = 0);
+    void destroyDynamicTexture(DynamicTextureId id);
+    uint32_t* dynamicPixels(DynamicTextureId id) { return dynamic_[id].pixels.data(); }   // po zapisie: markDirty
+    void markDirty(DynamicTextureId id, const DirtyRect& rect);
+    void setPixel(DynamicTextureId id, uint32_t x, uint32_t y, uint32_t rgba);   // oznacza tylko przy zmianie
+    uint32_t dynamicWidth(DynamicTextureId id) const { return dynamic_[id].width; }
+    uint32_t dynamicHeight(DynamicTextureId id) const { return dynamic_[id].height; }
+    // Tekstura do narysowania w klatce frame (ten sam indeks co w recordDynamicUploads)
+    ImTextureID dynamicTexture(DynamicTextureId id, uint32_t frame) const { return dynamic_[id].frames[frame].imTex; }
+    // W buforze klatki, przed passami, ktre czytaj tekstury (GPU skoczyo poprzedni klatk frame)
+    void recordDynamicUploads(VkCommandBuffer cmd, uint32_t frame);
+
+    struct DynamicUploadStats {
+        uint32_t regions = 0;
+        uint64_t bytes = 0;
+    };
+    DynamicUploadStats lastDynamicUpload() const { return dynamicStats_; }   // ostatnia klatka z uploadem
+
 private:
     Ctx ctx_;
     std::vector<SpriteGPU> sprites_;
@@ -45,15 +104,55 @@ private:
     std::unordered_map<std::string, SpriteId> byPath_;
     std::vector < std::string> paths_;
 
+    struct Upload {
+        SpriteId id = -1;
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        VkBuffer staging = VK_NULL_HANDLE;
+        VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    };
+    VkCommandPool uploadPool_ = VK_NULL_HANDLE;   // na rodzinie transferu
+    std::vector<Upload> uploads_;                  // w locie na kolejce transferu
+    std::vector<SpriteId> acquires_;               // skoczone, czekaj na barier przejcia
+    std::vector<VkFence> freeFences_;
+
+    struct DynamicTexture {
+        struct Frame {
+            VkImage image = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            VkImageView view = VK_NULL_HANDLE;
+            ImTextureID imTex = (ImTextureID)0;
+            VkBuffer staging = VK_NULL_HANDLE;         // stale zmapowany, rozmiar caego obrazu
+            VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+            unsigned char* mapped = nullptr;
+            DirtyRegion dirty;
+            bool written = false;                      // false: zawarto nieokrelona (pierwszy upload)
+        };
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint32_t> pixels;
+        std::vector<Frame> frames;
+        VkSampler sampler = VK_NULL_HANDLE;
+    };
+    std::vector<DynamicTexture> dynamic_;              // frames.empty() = usunita (stabilne ID)
+    std::vector<VkImageMemoryBarrier> dynamicBarriers_;
+    std::vector<VkBufferImageCopy> dynamicCopies_;
+    DynamicUploadStats dynamicStats_;
+
+    bool separateTransfer() const { return ctx_.transferFamily != ctx_.graphicsFamily; }
+    void retireUpload(Upload& u);
+
     // Pomocnicze (przeniesione z Texture.cpp)
     uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
-    VkCommandBuffer beginSingleTimeCommands() const;
-    void endSingleTimeCommands(VkCommandBuffer cmd) const;
+    VkCommandBuffer beginUploadCommands();
+    void submitUpload(SpriteId id, VkCommandBuffer cmd, VkBuffer staging, VkDeviceMemory stagingMemory);
     void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
         VkBuffer& buffer, VkDeviceMemory& bufferMemory) const;
-    void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout) const;
-    void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) const;
+    void copyBufferToImage(VkCommandBuffer cmd, VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) const;
     VkImageView createImageView(VkImage image, VkFormat format) const;
+    VkSampler createSampler() const;
+    void createDeviceImage(uint32_t width, uint32_t height, VkImage& image, VkDeviceMemory& memory) const;
+    void destroyDynamic(DynamicTexture& t);
 
     static void destroySprite(const Ctx& ctx, SpriteGPU& s);
 };
@@ -31,15 +31,24 @@ void VulkanImGuiApp::pickPhysicalDevice()
     if (!best) throw std::runtime_error("Failed to find suitable GPU");
     physicalDevice_ = best;
 
-    VkPhysicalDeviceProperties props{};
-    vkGetPhysicalDeviceProperties(physicalDevice_, &props);
-    std::cout << "[Vulkan] Using GPU: " << props.deviceName << std::endl;
+    // Wszystko, o co później pytają swapchain, pule poleceń, ImGui i assety - jeden raz
+    caps_.queues = findQueueFamilies(physicalDevice_, surface_);
+    vkGetPhysicalDeviceProperties(physicalDevice_, &caps_.properties);
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice_, &caps_.memory);
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice_, &familyCount, nullptr);
+    caps_.families.resize(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice_, &familyCount, caps_.families.data());
+    std::cout << "[Vulkan] Using GPU: " << caps_.properties.deviceName << std::endl;
 }
 
 void VulkanImGuiApp::createLogicalDevice()
 {
-    auto indices = findQueueFamilies(physicalDevice_, surface_);
-    std::set<uint32_t> uniqueFamilies = { indices.graphicsFamily.value(), indices.presentFamily.value() };
+    const QueueFamilyIndices& indices = caps_.queues;
+    // Bez osobnej rodziny transferu uploady idą na kolejkę graficzną
+    graphicsFamily_ = indices.graphicsFamily.value();
+    transferFamily_ = indices.transferFamily.value_or(graphicsFamily_);
+    std::set<uint32_t> uniqueFamilies = { graphicsFamily_, indices.presentFamily.value(), transferFamily_ };
 
     float priority = 1.0f;
     std::vector<VkDeviceQueueCreateInfo> qcis;
@@ -62,10 +71,13 @@ void VulkanImGuiApp::createLogicalDevice()
     dci.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
     dci.ppEnabledExtensionNames = extensions.data();
 
-    vkutils::checkVk(vkCreateDevice(physicalDevice_, &dci, nullptr, &device_), "vkCreateDevice failed");
+    vkutils::checkVk(vkCreateDevice(physicalDevice_, &dci, vkutils::allocator(), &device_), "vkCreateDevice failed");
 
     vkGetDeviceQueue(device_, indices.graphicsFamily.value(), 0, &graphicsQueue_);
     vkGetDeviceQueue(device_, indices.presentFamily.value(), 0, &presentQueue_);
+    vkGetDeviceQueue(device_, transferFamily_, 0, &transferQueue_);
+    if (transferFamily_ != graphicsFamily_)
+        std::cout << "[Vulkan] Dedicated transfer queue family: " << transferFamily_ << std::endl;
 }
 
 VulkanImGuiApp::QueueFamilyIndices VulkanImGuiApp::findQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface)
@@ -85,6 +97,15 @@ VulkanImGuiApp::QueueFamilyIndices VulkanImGuiApp::findQueueFamilies(VkPhysicalD
             indices.presentFamily = i;
         if (indices.isComplete()) break;
     }
+
+    // Rodzina tylko do transferu (silnik DMA); w drugiej kolejności dowolna bez grafiki
+    int bestTransfer = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const VkQueueFlags f = props[i].queueFlags;
+        if (!(f & VK_QUEUE_TRANSFER_BIT) || (f & VK_QUEUE_GRAPHICS_BIT) || props[i].queueCount == 0) continue;
+        const int score = (f & VK_QUEUE_COMPUTE_BIT) ? 1 : 2;
+        if (score > bestTransfer) { bestTransfer = score; indices.transferFamily = i; }
+    }
     return indices;
 }
 
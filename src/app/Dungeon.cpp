@@ -0,0 +1,55 @@
+#include "VulkanImGuiApp.h"
+#include <imgui.h>
+
+namespace {
+constexpr size_t kLevelBudget = 1u << 20;   // skompresowane piętra w pamięci, reszta w pliku wymiany
+}
+
+// Opuszczone piętro trafia do magazynu chunków, piętro docelowe jest z niego wczytywane
+// (albo generowane przy pierwszej wizycie). Sąsiednie piętra są wczytywane z dysku w tle,
+// zanim gracz zejdzie po schodach.
+void VulkanImGuiApp::changeLevel(int delta)
+{
+    if (delta < 0 && level_ < static_cast<uint32_t>(-delta)) return;
+    if (!levels_) {
+        ChunkStore::Config config;
+        config.swapPath = "levels.swap";
+        config.compressedBudget = kLevelBudget;
+        levels_ = new ChunkStore(config);
+    }
+    levels_->storeLevel(level_, world_.tiles);
+    level_ += delta;
+    if (!levels_->loadLevel(level_, world_.tiles)) generateLevel(world_.tiles, level_);
+    levels_->setFocus(level_, world_.tiles.width() / 2, world_.tiles.height() / 2, 1);
+    if (level_ > 0) levels_->prefetchLevel(level_ - 1);
+    levels_->prefetchLevel(level_ + 1);
+    levels_->maintain();
+    messages_.addf(MessageKind::Info, world_.turn, "You take the stairs to level %u.", level_);
+    redraw_.requestFrames(RedrawScheduler::Simulation, 2);
+}
+
+void VulkanImGuiApp::drawDungeonPanel()
+{
+    if (levels_) levels_->maintain();   // odbiór wczytanych w tle
+
+    ImGui::Begin("Dungeon");
+    ImGui::Text("Level %u", level_);
+    ImGui::SameLine();
+    ImGui::BeginDisabled(level_ == 0);
+    if (ImGui::Button("Up")) changeLevel(-1);
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (ImGui::Button("Down")) changeLevel(+1);
+
+    if (levels_) {
+        const ChunkStore::Stats s = levels_->stats();
+        ImGui::Text("Chunks: %u raw, %u compressed, %u uniform, %u on disk", s.rawChunks, s.compressedChunks,
+            s.uniformChunks, s.pagedChunks);
+        ImGui::Text("Memory %.1f KB (budget %.0f KB), swap file %.1f KB", s.residentBytes / 1024.0,
+            kLevelBudget / 1024.0, s.swapBytes / 1024.0);
+        ImGui::Text("Page-outs %llu, loads: %llu background, %llu blocking",
+            static_cast<unsigned long long>(s.pageOuts), static_cast<unsigned long long>(s.backgroundLoads),
+            static_cast<unsigned long long>(s.blockingLoads));
+    }
+    ImGui::End();
+}
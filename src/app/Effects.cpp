@@ -0,0 +1,90 @@
+#include "VulkanImGuiApp.h"
+#include "WorldDraw.h"
+#include "core/Simd.h"
+#include <imgui.h>
+#include <chrono>
+
+namespace {
+constexpr uint32_t kMaxParticles = 1u << 20;
+constexpr uint32_t kMaxParticleQuads = 1u << 17;   // limit listy: 128k kwadratów = 512k wierzchołków na klatkę
+
+float elapsedMs(std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+}
+
+void VulkanImGuiApp::emitParticles(const ParticleBurst& burst, uint32_t count)
+{
+    if (!particles_) {
+        particles_ = new ParticleSystem(kMaxParticles);
+        particles_->setGravity(0.0f, 40.0f);
+        particles_->setDrag(1.5f);
+    }
+    particles_->emit(burst, count);
+    redraw_.requestFrames(RedrawScheduler::Animation);
+}
+
+// Ta sama pula wątków co listy encji; panel Render wyłącza oba naraz
+void VulkanImGuiApp::updateParticles(float dt)
+{
+    WorldTarget& wt = worldTarget_;
+    if (!particles_ || particles_->alive() == 0) { wt.particleMs = 0.0f; return; }
+    const auto t0 = std::chrono::steady_clock::now();
+    particles_->update(dt, parallelWorld_ ? jobs_ : nullptr);
+    wt.particleMs = elapsedMs(t0);
+}
+
+// Nad encjami, osobna lista dokładana w presentWorld po paczkach encji
+void VulkanImGuiApp::drawParticleLayer()
+{
+    WorldTarget& wt = worldTarget_;
+    wt.drawnParticles = 0;
+    if (!particles_ || particles_->alive() == 0) return;
+    const auto t0 = std::chrono::steady_clock::now();
+    wt.drawnParticles = drawParticles(wt.effectsList, *particles_, kMaxParticleQuads);
+    wt.particleMs += elapsedMs(t0);
+}
+
+void VulkanImGuiApp::drawEffectsPanel()
+{
+    WorldTarget& wt = worldTarget_;
+    ImGui::Begin("Effects");
+    ParticleBurst burst;
+    burst.x = effectsRng_.unit() * wt.width;
+    burst.y = effectsRng_.unit() * wt.height;
+    if (ImGui::Button("Sparks")) {
+        burst.color = IM_COL32(255, 200, 80, 255);
+        emitParticles(burst, 256);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Blood")) {
+        burst.color = IM_COL32(180, 20, 20, 255);
+        burst.speedMax = 30.0f;
+        burst.lifeMax = 1.5f;
+        emitParticles(burst, 512);
+    }
+    ImGui::SameLine();
+    // Obciążenie: pełna pula wybuchami po całym ekranie
+    if (ImGui::Button("Stress (1M)")) {
+        burst.lifeMin = 2.0f;
+        burst.lifeMax = 5.0f;
+        burst.speedMax = 120.0f;
+        for (uint32_t k = 0; k < kMaxParticles / 1024; ++k) {
+            burst.x = effectsRng_.unit() * wt.width;
+            burst.y = effectsRng_.unit() * wt.height;
+            burst.color = IM_COL32(80 + effectsRng_.below(176), 80 + effectsRng_.below(176), 255, 255);
+            emitParticles(burst, 1024);
+        }
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear") && particles_) particles_->clear();
+
+    if (particles_) {
+        ImGui::Text("Alive %u / %u, dropped %llu", particles_->alive(), particles_->capacity(),
+            static_cast<unsigned long long>(particles_->dropped()));
+        ImGui::Text("Update + build %.2f ms (%s, %s), drawn %u", wt.particleMs, simd::kName,
+            parallelWorld_ ? "parallel" : "serial", wt.drawnParticles);
+    }
+    ImGui::End();
+}
@@ -0,0 +1,196 @@
+#include "FrameGraphVulkan.h"
+#include <vk_utils.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+constexpr VkAccessFlags kWriteAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+uint32_t findMemoryTypeIndex(const VkPhysicalDeviceMemoryProperties& memProps, uint32_t typeFilter, VkMemoryPropertyFlags properties)
+{
+    for (uint32_t i = 0; i < memProps.memoryTypeCount; i++) {
+        if ((typeFilter & (1u << i)) && (memProps.memoryTypes[i].propertyFlags & properties) == properties)
+            return i;
+    }
+    throw std::runtime_error("FrameGraph: no suitable memory type");
+}
+
+bool uses(uint32_t mask, GpuAccess access) { return mask & (1u << static_cast<uint32_t>(access)); }
+}
+
+VulkanAccess vulkanAccess(GpuAccess access)
+{
+    switch (access) {
+    case GpuAccess::ColorAttachmentWrite:
+        // Odczyt też: loadOp i mieszanie czytają attachment
+        return { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+    case GpuAccess::ShaderRead:
+        return { VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+    case GpuAccess::TransferWrite:
+        return { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL };
+    case GpuAccess::TransferRead:
+        return { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL };
+    case GpuAccess::Present:
+        // Obraz swapchaina jest nasz dopiero po semaforze acquire, na który kolejka czeka
+        // w COLOR_ATTACHMENT_OUTPUT - przejście z/do PRESENT_SRC synchronizujemy na tym etapie
+        return { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR };
+    default:
+        return { VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, VK_IMAGE_LAYOUT_UNDEFINED };
+    }
+}
+
+VkImageMemoryBarrier imageBarrier(VkImage image, GpuAccess before, GpuAccess after, bool discard)
+{
+    const VulkanAccess src = vulkanAccess(before);
+    const VulkanAccess dst = vulkanAccess(after);
+    VkImageMemoryBarrier b{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    b.srcAccessMask = src.access & kWriteAccess;
+    b.dstAccessMask = dst.access;
+    b.oldLayout = discard ? VK_IMAGE_LAYOUT_UNDEFINED : src.layout;
+    b.newLayout = dst.layout;
+    b.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    b.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    b.image = image;
+    b.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+    return b;
+}
+
+VkRenderPass createColorRenderPass(VkDevice device, VkFormat format)
+{
+    VkAttachmentDescription color{};
+    color.format = format;
+    color.samples = VK_SAMPLE_COUNT_1_BIT;
+    color.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    color.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    color.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    color.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    color.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    color.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkAttachmentReference colorRef{ 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorRef;
+
+    VkRenderPassCreateInfo rpci{ VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO };
+    rpci.attachmentCount = 1;
+    rpci.pAttachments = &color;
+    rpci.subpassCount = 1;
+    rpci.pSubpasses = &subpass;
+    VkRenderPass renderPass{};
+    vkutils::checkVk(vkCreateRenderPass(device, &rpci, vkutils::allocator(), &renderPass), "vkCreateRenderPass failed");
+    return renderPass;
+}
+
+FrameGraph::PassId FrameGraphVulkan::addPass(const char* name, Record record, bool keep)
+{
+    const FrameGraph::PassId pass = graph_.addPass(name, keep);
+    records_.resize(pass + 1);
+    records_[pass] = std::move(record);
+    return pass;
+}
+
+void FrameGraphVulkan::compile(VkDevice device, const VkPhysicalDeviceMemoryProperties& memory)
+{
+    graph_.compile();
+    const uint32_t count = graph_.resourceCount();
+    images_.assign(count, VK_NULL_HANDLE);
+    views_.assign(count, VK_NULL_HANDLE);
+
+    // Slot ma rozmiar i wyrównanie największego lokatora; typ pamięci musi pasować wszystkim
+    std::vector<VkDeviceSize> slotSize(graph_.aliasSlotCount(), 0), slotAlign(graph_.aliasSlotCount(), 1);
+    uint32_t typeBits = ~0u;
+    unaliasedBytes_ = 0;
+    std::vector<VkMemoryRequirements> reqs(count);
+    for (FrameGraph::ResourceId r = 0; r < count; ++r) {
+        const uint32_t slot = graph_.aliasSlot(r);
+        if (slot == FrameGraph::kNoSlot) continue;
+        const FrameGraph::ImageDesc& desc = graph_.desc(r);
+        const uint32_t mask = graph_.accessMask(r);
+
+        VkImageCreateInfo ici{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+        ici.imageType = VK_IMAGE_TYPE_2D;
+        ici.extent = { desc.width, desc.height, 1 };
+        ici.mipLevels = 1;
+        ici.arrayLayers = 1;
+        ici.format = static_cast<VkFormat>(desc.format);
+        ici.tiling = VK_IMAGE_TILING_OPTIMAL;
+        ici.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        if (uses(mask, GpuAccess::ColorAttachmentWrite)) ici.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        if (uses(mask, GpuAccess::ShaderRead)) ici.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+        if (uses(mask, GpuAccess::TransferWrite)) ici.usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        if (uses(mask, GpuAccess::TransferRead)) ici.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        ici.samples = VK_SAMPLE_COUNT_1_BIT;
+        ici.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        vkutils::checkVk(vkCreateImage(device, &ici, vkutils::allocator(), &images_[r]), "vkCreateImage (frame graph) failed");
+
+        vkGetImageMemoryRequirements(device, images_[r], &reqs[r]);
+        slotSize[slot] = std::max(slotSize[slot], reqs[r].size);
+        slotAlign[slot] = std::max(slotAlign[slot], reqs[r].alignment);
+        typeBits &= reqs[r].memoryTypeBits;
+        unaliasedBytes_ += reqs[r].size;
+    }
+
+    std::vector<VkDeviceSize> slotOffset(slotSize.size(), 0);
+    memoryBytes_ = 0;
+    for (size_t s = 0; s < slotSize.size(); ++s) {
+        slotOffset[s] = (memoryBytes_ + slotAlign[s] - 1) / slotAlign[s] * slotAlign[s];
+        memoryBytes_ = slotOffset[s] + slotSize[s];
+    }
+    if (memoryBytes_ == 0) return;
+
+    VkMemoryAllocateInfo mai{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    mai.allocationSize = memoryBytes_;
+    mai.memoryTypeIndex = findMemoryTypeIndex(memory, typeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    vkutils::checkVk(vkAllocateMemory(device, &mai, vkutils::allocator(), &memory_), "vkAllocateMemory (frame graph) failed");
+
+    for (FrameGraph::ResourceId r = 0; r < count; ++r) {
+        const uint32_t slot = graph_.aliasSlot(r);
+        if (slot == FrameGraph::kNoSlot) continue;
+        vkutils::checkVk(vkBindImageMemory(device, images_[r], memory_, slotOffset[slot]), "vkBindImageMemory (frame graph) failed");
+
+        VkImageViewCreateInfo ivci{ VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+        ivci.image = images_[r];
+        ivci.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        ivci.format = static_cast<VkFormat>(graph_.desc(r).format);
+        ivci.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        vkutils::checkVk(vkCreateImageView(device, &ivci, vkutils::allocator(), &views_[r]), "vkCreateImageView (frame graph) failed");
+    }
+}
+
+void FrameGraphVulkan::destroy(VkDevice device)
+{
+    for (FrameGraph::ResourceId r = 0; r < images_.size(); ++r) {
+        if (graph_.imported(r)) continue;
+        if (views_[r]) vkDestroyImageView(device, views_[r], vkutils::allocator());
+        if (images_[r]) vkDestroyImage(device, images_[r], vkutils::allocator());
+    }
+    if (memory_) vkFreeMemory(device, memory_, vkutils::allocator());
+    *this = {};
+}
+
+// Wszystkie przejścia przed passem w jednym vkCmdPipelineBarrier (suma etapów źródłowych i docelowych)
+void FrameGraphVulkan::recordBarriers(VkCommandBuffer cmd, std::span<const FrameGraph::Barrier> barriers)
+{
+    if (barriers.empty()) return;
+    scratch_.clear();
+    VkPipelineStageFlags srcStage = 0, dstStage = 0;
+    for (const FrameGraph::Barrier& b : barriers) {
+        scratch_.push_back(imageBarrier(images_[b.resource], b.before, b.after, b.discard));
+        srcStage |= vulkanAccess(b.before).stage;
+        dstStage |= vulkanAccess(b.after).stage;
+    }
+    vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0, 0, nullptr, 0, nullptr,
+        static_cast<uint32_t>(scratch_.size()), scratch_.data());
+}
+
+void FrameGraphVulkan::execute(VkCommandBuffer cmd)
+{
+    for (const FrameGraph::Step& step : graph_.steps()) {
+        recordBarriers(cmd, graph_.barriers(step));
+        if (records_[step.pass]) records_[step.pass](cmd);
+    }
+    recordBarriers(cmd, graph_.finalBarriers());
+}
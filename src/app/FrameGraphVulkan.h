@@ -0,0 +1,54 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include "core/FrameGraph.h"
+#include <functional>
+#include <vector>
+
+// Etap, maski dostępu i układ obrazu dla GpuAccess - jedno źródło dla grafu klatki i assetów
+struct VulkanAccess {
+    VkPipelineStageFlags stage;
+    VkAccessFlags access;
+    VkImageLayout layout;
+};
+VulkanAccess vulkanAccess(GpuAccess access);
+// Bariera obrazu koloru (1 mip, 1 warstwa); discard: stara zawartość odrzucona (UNDEFINED)
+VkImageMemoryBarrier imageBarrier(VkImage image, GpuAccess before, GpuAccess after, bool discard = false);
+// Render pass z jednym attachmentem koloru (czyszczonym) dla passa grafu: układ wejściowy
+// i wyjściowy to COLOR_ATTACHMENT_OPTIMAL, przejścia i zależności robią bariery grafu
+VkRenderPass createColorRenderPass(VkDevice device, VkFormat format);
+
+// FrameGraph na Vulkanie: tworzy obrazy przejściowe w jednej alokacji (obrazy z tego samego
+// slotu dzielą offset), nagrywa passy w kolejności grafu i przed każdym jedną zbiorczą barierę.
+class FrameGraphVulkan {
+public:
+    using Record = std::function<void(VkCommandBuffer)>;
+
+    FrameGraph& graph() { return graph_; }
+    const FrameGraph& graph() const { return graph_; }
+    FrameGraph::PassId addPass(const char* name, Record record, bool keep = false);
+
+    void compile(VkDevice device, const VkPhysicalDeviceMemoryProperties& memory);
+    void destroy(VkDevice device);
+
+    // Obraz importowany (np. bieżący obraz swapchaina) - ustawiany przed execute
+    void setImage(FrameGraph::ResourceId resource, VkImage image) { images_[resource] = image; }
+    VkImage image(FrameGraph::ResourceId resource) const { return images_[resource]; }
+    VkImageView view(FrameGraph::ResourceId resource) const { return views_[resource]; }
+
+    void execute(VkCommandBuffer cmd);
+
+    VkDeviceSize memoryBytes() const { return memoryBytes_; }        // po aliasingu
+    VkDeviceSize unaliasedBytes() const { return unaliasedBytes_; }  // gdyby każdy obraz miał własną pamięć
+
+private:
+    FrameGraph graph_;
+    std::vector<Record> records_;
+    std::vector<VkImage> images_;
+    std::vector<VkImageView> views_;
+    VkDeviceMemory memory_{};
+    VkDeviceSize memoryBytes_ = 0;
+    VkDeviceSize unaliasedBytes_ = 0;
+    std::vector<VkImageMemoryBarrier> scratch_;
+
+    void recordBarriers(VkCommandBuffer cmd, std::span<const FrameGraph::Barrier> barriers);
+};
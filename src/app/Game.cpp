@@ -16,3 +16,17 @@ uint32_t Entity::getHeight() const {
 int Entity::getSpriteId() const {
 	return spriteId;
 }
+
+uint32_t Entity::getAnimation() const {
+	return animation;
+}
+void Entity::setAnimation(uint32_t id) {
+	animation = id;
+}
+
+uint8_t Entity::getLayer() const {
+	return layer;
+}
+void Entity::setLayer(uint8_t value) {
+	layer = value;
+}
@@ -10,11 +10,21 @@ public:
 	uint32_t getWidth() const;
 	uint32_t getHeight() const;
 	int getSpriteId() const;
+
+	// Id w Animator (UINT32_MAX = sprite statyczny, cała tekstura)
+	uint32_t getAnimation() const;
+	void setAnimation(uint32_t id);
+
+	// Warstwa rysowania (DrawLayer z WorldDraw.h)
+	uint8_t getLayer() const;
+	void setLayer(uint8_t value);
 private:
 	int spriteId;
 	uint32_t width = 0;
 	uint32_t height = 0;
 	ImVec2 pos{ 0.0f, 0.0f };
 	bool visible = true;
+	uint32_t animation = UINT32_MAX;
+	uint8_t layer = 1;   // DrawLayer::Actors
 };
 
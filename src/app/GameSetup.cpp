@@ -1,7 +1,14 @@
 #include "Game.h"
 #include "Assets.h"
 #include <vector>
+#include <unordered_map>
 #include "GameSetup.h"
+#include "core/Hash.h"
+#include "game/Animation.h"
+#include "game/Prefab.h"
+#include "game/SaveGame.h"
+#include <stdexcept>
+#include <string>
 
 Entity* spawn(std::vector<Entity*>& entities, Assets* assets, const char* path, uint32_t width, uint32_t height, float posX, float posY)
 {
@@ -11,9 +18,101 @@ Entity* spawn(std::vector<Entity*>& entities, Assets* assets, const char* path,
     return e;
 }
 
-void setupGameEntities(std::vector<Entity*>& entities, Assets* assets)
+Entity* spawnPrefab(std::vector<Entity*>& entities, Animator& animator, const PrefabInstance& prefab, float posX, float posY, float startTime)
 {
-    spawn(entities, assets, "assets/characters/hero.png", 64, 64, 256.0f, 256.0f);
-    spawn(entities, assets, "assets/characters/angel.png", 64, 64, 400.0f, 256.0f);
-    spawn(entities, assets, "assets/characters/angel.png", 64, 64, 400.0f, 400.0f);
-}
\ No newline at end of file
+    Entity* e = new Entity(prefab.sprite, prefab.width, prefab.height, posX, posY);
+    if (prefab.clip != UINT16_MAX) e->setAnimation(animator.add(prefab.clip, startTime));
+    entities.push_back(e);
+    return e;
+}
+
+std::vector<PrefabInstance> resolvePrefabs(const PrefabTable& table, Assets* assets, const AnimationLibrary& library)
+{
+    std::vector<int> sprites(table.pathCount());
+    for (uint32_t i = 0; i < table.pathCount(); ++i)
+        sprites[i] = assets->getOrLoad(std::string(table.path(i)));
+    std::unordered_map<uint64_t, uint16_t> clips;
+    for (size_t i = 0; i < library.clips().size(); ++i)
+        clips.emplace(hashString(library.clips()[i].name), static_cast<uint16_t>(i));
+
+    std::vector<PrefabInstance> out;
+    out.reserve(table.prefabs().size());
+    for (const PrefabRecord& r : table.prefabs()) {
+        PrefabInstance p;
+        p.sprite = sprites[r.pathIndex];
+        p.width = r.width;
+        p.height = r.height;
+        if (r.clipHash) {
+            auto it = clips.find(r.clipHash);
+            if (it == clips.end()) throw std::runtime_error("Prefab table refers to a clip missing from animations.txt");
+            p.clip = it->second;
+        }
+        out.push_back(p);
+    }
+    return out;
+}
+
+void setupGameEntities(std::vector<Entity*>& entities, const PrefabTable& table, const std::vector<PrefabInstance>& prefabs, Animator& animator)
+{
+    auto prefab = [&](uint64_t nameHash) -> const PrefabInstance& {
+        const int id = table.find(nameHash);
+        if (id < 0) throw std::runtime_error("Prefab missing from assets/prefabs.txt");
+        return prefabs[id];
+    };
+    const PrefabInstance& hero = prefab(hashString("hero"));
+    const PrefabInstance& angel = prefab(hashString("angel"));
+
+    // Pozycje w pikselach świata (480x270, patrz WorldTarget)
+    spawnPrefab(entities, animator, hero, 96.0f, 96.0f);
+    spawnPrefab(entities, animator, angel, 200.0f, 96.0f);
+    spawnPrefab(entities, animator, angel, 200.0f, 170.0f, 0.25f);
+}
+
+void captureWorld(const World& world, const std::vector<Entity*>& entities, const Assets& assets, WorldSnapshot& out)
+{
+    out.capture(world);
+    out.entities.clear();
+    out.assetPaths.clear();
+    std::unordered_map<int, uint64_t> hashes;
+    for (const Entity* e : entities) {
+        if (!e) continue;
+        auto [it, added] = hashes.try_emplace(e->getSpriteId(), 0);
+        if (added) {
+            const std::string& path = assets.path(e->getSpriteId());
+            it->second = hashString(path);
+            out.assetPaths.push_back(path);
+        }
+        const ImVec2 pos = e->getPosition();
+        out.entities.push_back({ it->second, pos.x, pos.y, e->getWidth(), e->getHeight(), e->getLayer() });
+    }
+}
+
+void restoreWorld(const WorldSnapshot& snapshot, World& world, std::vector<Entity*>& entities, Assets* assets, Animator& animator)
+{
+    snapshot.restore(world);
+
+    // Pierwszy klip każdego arkusza, po hashu ścieżki tekstury
+    const AnimationLibrary& library = animator.library();
+    std::unordered_map<uint64_t, uint16_t> defaultClips;
+    for (size_t i = 0; i < library.clips().size(); ++i)
+        defaultClips.try_emplace(hashString(library.sheets()[library.clips()[i].sheet].path), static_cast<uint16_t>(i));
+
+    std::unordered_map<uint64_t, int> sprites;
+    for (const std::string& path : snapshot.assetPaths)
+        sprites[hashString(path)] = assets->getOrLoad(path);
+
+    for (auto* e : entities) {
+        animator.remove(e->getAnimation());
+        delete e;
+    }
+    entities.clear();
+    for (const SaveEntity& s : snapshot.entities) {
+        auto it = sprites.find(s.spriteHash);
+        if (it == sprites.end()) continue;   // asset zniknął z gry - pomijamy encję
+        Entity* e = new Entity(it->second, s.width, s.height, s.x, s.y);
+        e->setLayer(static_cast<uint8_t>(s.layer));
+        auto clip = defaultClips.find(s.spriteHash);
+        if (clip != defaultClips.end()) e->setAnimation(animator.add(clip->second));
+        entities.push_back(e);
+    }
+}
@@ -1,9 +1,34 @@
 #pragma once
+#include "game/LevelGen.h"
+#include <cstdint>
 #include <vector>
 
 class Entity;
 class Assets;
+class Animator;
+class AnimationLibrary;
+class PrefabTable;
+struct WorldSnapshot;
 
-void setupGameEntities(std::vector<Entity*>& entities, Assets* assets);
+// Prefab po rozwiązaniu assetów (indeksy jak w PrefabTable::prefabs()). Spawn kopiuje te pola
+// do encji - bez napisów i wyszukiwań w mapie ścieżek.
+struct PrefabInstance {
+    int sprite = -1;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint16_t clip = UINT16_MAX;   // indeks w AnimationLibrary; UINT16_MAX = sprite statyczny
+};
 
-Entity* spawn(std::vector<Entity*>& entities, Assets* assets, const char* path, uint32_t width, uint32_t height, float posX, float posY);
\ No newline at end of file
+void setupGameEntities(std::vector<Entity*>& entities, const PrefabTable& table, const std::vector<PrefabInstance>& prefabs, Animator& animator);
+
+// Tekstury tabeli muszą być już w Assets (start gry wgrywa je z wyprzedzeniem) - inaczej wczytuje je getOrLoad
+std::vector<PrefabInstance> resolvePrefabs(const PrefabTable& table, Assets* assets, const AnimationLibrary& library);
+
+Entity* spawn(std::vector<Entity*>& entities, Assets* assets, const char* path, uint32_t width, uint32_t height, float posX, float posY);
+// startTime rozsuwa fazy animacji
+Entity* spawnPrefab(std::vector<Entity*>& entities, Animator& animator, const PrefabInstance& prefab, float posX, float posY, float startTime = 0.0f);
+
+// Zapis/odczyt: encje trafiają do migawki jako POD z hashem ścieżki sprite'a.
+// Stan animacji nie jest zapisywany - encja z teksturą arkusza dostaje po wczytaniu jego pierwszy klip.
+void captureWorld(const World& world, const std::vector<Entity*>& entities, const Assets& assets, WorldSnapshot& out);
+void restoreWorld(const WorldSnapshot& snapshot, World& world, std::vector<Entity*>& entities, Assets* assets, Animator& animator);
@@ -2,12 +2,14 @@
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_vulkan.h>
+#include <vk_utils.h>
 #include <stdexcept>
 #include <cstdio>
 
 void VulkanImGuiApp::initImGui()
 {
     IMGUI_CHECKVERSION();
+    initAllocTracking();
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO(); (void)io;
 
@@ -15,25 +17,25 @@ void VulkanImGuiApp::initImGui()
     ImGui::StyleColorsDark();
 
     // Setup Platform/Renderer bindings
-    ImGui_ImplGlfw_InitForVulkan(window_, true);
-
-    auto indices = findQueueFamilies(physicalDevice_, surface_);
+    // W powtórce wejście z okna jest ignorowane - zdarzenia podaje InputReplay
+    ImGui_ImplGlfw_InitForVulkan(window_, !replaying_);
 
     ImGui_ImplVulkan_InitInfo init_info{};
     init_info.ApiVersion = VK_API_VERSION_1_1;
     init_info.Instance = instance_;
     init_info.PhysicalDevice = physicalDevice_;
     init_info.Device = device_;
-    init_info.QueueFamily = indices.graphicsFamily.value();
+    init_info.QueueFamily = graphicsFamily_;
     init_info.Queue = graphicsQueue_;
     init_info.DescriptorPool = imguiDescriptorPool_;
     init_info.RenderPass = renderPass_;
     init_info.MinImageCount = static_cast<uint32_t>(swapchainImages_.size());
-    init_info.ImageCount = static_cast<uint32_t>(swapchainImages_.size());
+    // x2: RenderDrawData woła się dwa razy na klatkę (świat + UI), a każde wywołanie bierze kolejny bufor wierzchołków
+    init_info.ImageCount = static_cast<uint32_t>(swapchainImages_.size()) * 2;
     init_info.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
-    init_info.PipelineCache = VK_NULL_HANDLE;
+    init_info.PipelineCache = pipelineCache_;
     init_info.Subpass = 0;
-    init_info.Allocator = nullptr;
+    init_info.Allocator = vkutils::allocator();
     init_info.CheckVkResultFn = [](VkResult err) {
         if (err != VK_SUCCESS) fprintf(stderr, "ImGui Vulkan error: %d\n", err);
     };
@@ -53,23 +55,22 @@ void VulkanImGuiApp::reinitImGuiRenderer()
     // Shutdown only Vulkan backend objects
     ImGui_ImplVulkan_Shutdown();
 
-    auto indices = findQueueFamilies(physicalDevice_, surface_);
-
     ImGui_ImplVulkan_InitInfo init_info{};
     init_info.ApiVersion = VK_API_VERSION_1_1;
     init_info.Instance = instance_;
     init_info.PhysicalDevice = physicalDevice_;
     init_info.Device = device_;
-    init_info.QueueFamily = indices.graphicsFamily.value();
+    init_info.QueueFamily = graphicsFamily_;
     init_info.Queue = graphicsQueue_;
     init_info.DescriptorPool = imguiDescriptorPool_;
     init_info.RenderPass = renderPass_;
     init_info.MinImageCount = static_cast<uint32_t>(swapchainImages_.size());
-    init_info.ImageCount = static_cast<uint32_t>(swapchainImages_.size());
+    // x2: RenderDrawData woła się dwa razy na klatkę (świat + UI), a każde wywołanie bierze kolejny bufor wierzchołków
+    init_info.ImageCount = static_cast<uint32_t>(swapchainImages_.size()) * 2;
     init_info.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
-    init_info.PipelineCache = VK_NULL_HANDLE;
+    init_info.PipelineCache = pipelineCache_;
     init_info.Subpass = 0;
-    init_info.Allocator = nullptr;
+    init_info.Allocator = vkutils::allocator();
     init_info.CheckVkResultFn = [](VkResult err) {
         if (err != VK_SUCCESS) fprintf(stderr, "ImGui Vulkan error: %d\n", err);
     };
@@ -0,0 +1,124 @@
+#include "VulkanImGuiApp.h"
+#include <GLFW/glfw3.h>
+#include <imgui.h>
+#include <imgui_impl_glfw.h>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+// Callbacki nagrywające instalujemy przed ImGui_ImplGlfw_InitForVulkan - backend ImGui
+// zapamiętuje poprzednie callbacki i woła je łańcuchowo, więc oba widzą te same zdarzenia.
+namespace {
+InputRecorder* recorderOf(GLFWwindow* w) { return static_cast<InputRecorder*>(glfwGetWindowUserPointer(w)); }
+
+void keyCallback(GLFWwindow* w, int key, int scancode, int action, int mods)
+{
+    recorderOf(w)->record({ InputEventType::Key, static_cast<uint8_t>(action), static_cast<uint16_t>(mods), key, scancode });
+}
+
+void charCallback(GLFWwindow* w, unsigned int c)
+{
+    recorderOf(w)->record({ InputEventType::Char, 0, 0, static_cast<int32_t>(c) });
+}
+
+void mouseButtonCallback(GLFWwindow* w, int button, int action, int mods)
+{
+    recorderOf(w)->record({ InputEventType::MouseButton, static_cast<uint8_t>(action), static_cast<uint16_t>(mods), button });
+}
+
+void cursorPosCallback(GLFWwindow* w, double x, double y)
+{
+    recorderOf(w)->record({ InputEventType::CursorPos, 0, 0, 0, 0, static_cast<float>(x), static_cast<float>(y) });
+}
+
+void scrollCallback(GLFWwindow* w, double x, double y)
+{
+    recorderOf(w)->record({ InputEventType::Scroll, 0, 0, 0, 0, static_cast<float>(x), static_cast<float>(y) });
+}
+
+void focusCallback(GLFWwindow* w, int focused)
+{
+    recorderOf(w)->record({ InputEventType::Focus, static_cast<uint8_t>(focused) });
+}
+
+void cursorEnterCallback(GLFWwindow* w, int entered)
+{
+    recorderOf(w)->record({ InputEventType::CursorEnter, static_cast<uint8_t>(entered) });
+}
+
+// Zdarzenie z nagrania trafia do ImGui tą samą drogą co z okna
+void feed(GLFWwindow* w, const InputEvent& e)
+{
+    switch (e.type) {
+    case InputEventType::Key:         ImGui_ImplGlfw_KeyCallback(w, e.code, e.scancode, e.action, e.mods); break;
+    case InputEventType::Char:        ImGui_ImplGlfw_CharCallback(w, static_cast<unsigned int>(e.code)); break;
+    case InputEventType::MouseButton: ImGui_ImplGlfw_MouseButtonCallback(w, e.code, e.action, e.mods); break;
+    case InputEventType::CursorPos:   ImGui_ImplGlfw_CursorPosCallback(w, e.x, e.y); break;
+    case InputEventType::Scroll:      ImGui_ImplGlfw_ScrollCallback(w, e.x, e.y); break;
+    case InputEventType::Focus:       ImGui_ImplGlfw_WindowFocusCallback(w, e.action); break;
+    case InputEventType::CursorEnter: ImGui_ImplGlfw_CursorEnterCallback(w, e.action); break;
+    }
+}
+}
+
+void VulkanImGuiApp::initInputCapture()
+{
+    uint64_t seed = options_.seed;
+    if (!options_.replayPath.empty()) {
+        if (!replay_.open(options_.replayPath))
+            throw std::runtime_error("Failed to open replay " + options_.replayPath);
+        replaying_ = true;
+        seed = replay_.seed();
+    } else if (seed == 0) {
+        seed = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    }
+    world_.rng.reseed(seed);
+
+    if (replaying_ || options_.recordPath.empty()) return;
+    if (!recorder_.open(options_.recordPath, seed))
+        throw std::runtime_error("Failed to open " + options_.recordPath + " for recording");
+
+    glfwSetWindowUserPointer(window_, &recorder_);
+    glfwSetKeyCallback(window_, keyCallback);
+    glfwSetCharCallback(window_, charCallback);
+    glfwSetMouseButtonCallback(window_, mouseButtonCallback);
+    glfwSetCursorPosCallback(window_, cursorPosCallback);
+    glfwSetScrollCallback(window_, scrollCallback);
+    glfwSetWindowFocusCallback(window_, focusCallback);
+    glfwSetCursorEnterCallback(window_, cursorEnterCallback);
+}
+
+// Wołane po ImGui_ImplGlfw_NewFrame, przed ImGui::NewFrame: podmienia czas klatki
+// (i w powtórce wejście) na wartości z nagrania.
+void VulkanImGuiApp::beginInputFrame()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    if (!replaying_) {
+        recorder_.endFrame(io.DeltaTime);
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    if (replay_.frame() == 0) {
+        replayStart_ = Clock::now();
+        replayTime_ = 0.0;
+    }
+
+    InputReplay::Frame frame;
+    if (replay_.nextFrame(frame)) {
+        for (const InputEvent& e : frame.events) feed(window_, e);
+        io.DeltaTime = frame.dt > 0.0f ? frame.dt : 1.0f / 60.0f;
+        replayTime_ += frame.dt;
+    }
+
+    if (options_.realtime) {
+        const auto due = replayStart_ + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(replayTime_));
+        std::this_thread::sleep_until(due);
+    }
+    if (replay_.finished()) {
+        const double wall = std::chrono::duration<double>(Clock::now() - replayStart_).count();
+        std::cout << "[Replay] " << replay_.frame() << " frames, " << replayTime_ << " s game time in "
+                  << wall << " s (" << (wall > 0.0 ? replay_.frame() / wall : 0.0) << " fps)" << std::endl;
+    }
+}
@@ -0,0 +1,237 @@
+#include "VulkanImGuiApp.h"
+#include "Game.h"
+#include "WorldDraw.h"
+#include "core/AllocTracker.h"
+#include "core/RadixSort.h"
+#include <imgui.h>
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+extern std::vector<Entity*> entities;
+
+namespace {
+constexpr uint32_t kScanBudget = 16384;      // encji sprawdzanych filtrem na klatkę
+constexpr uint32_t kStressEntities = 100000;
+constexpr uint32_t kIndexBits = 24;          // jak drawkey: indeks w dolnych bitach klucza
+constexpr uint64_t kValueMask = (uint64_t(1) << (64 - kIndexBits)) - 1;
+
+enum Column { ColIndex, ColSprite, ColX, ColY, ColSize, ColLayer, ColAnimation, ColCount };
+
+// Float jako liczba bez znaku o tym samym porządku
+uint32_t orderedBits(float f)
+{
+    const uint32_t u = std::bit_cast<uint32_t>(f);
+    return (u & 0x80000000u) ? ~u : u | 0x80000000u;
+}
+
+bool containsNoCase(const std::string& text, const char* needle)
+{
+    const size_t n = std::strlen(needle);
+    return std::search(text.begin(), text.end(), needle, needle + n, [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    }) != text.end();
+}
+}
+
+// Filtr po ścieżce sprite'a: dopasowanie liczone raz na sprite, potem skan encji w porcjach po
+// kScanBudget na klatkę. Dłuższy filtr zawierający poprzedni zawęża poprzedni wynik (już posortowany)
+// zamiast zaczynać od wszystkich encji.
+void VulkanImGuiApp::restartInspectorScan()
+{
+    InspectorView& v = inspector_;
+    const bool narrowing = v.scanned == v.sourceSize && v.entityCount == entities.size() && !v.applied.empty()
+        && std::string_view(v.filter).find(v.applied) != std::string_view::npos;
+    if (narrowing) {
+        v.source.swap(v.rows);
+    } else {
+        v.source.clear();
+        v.sorted = false;
+    }
+    v.narrowing = narrowing;
+    v.sourceSize = narrowing ? v.source.size() : entities.size();
+    v.rows.clear();
+    v.scanned = 0;
+    v.entityCount = entities.size();
+    v.applied = v.filter;
+
+    const std::span<const SpriteGPU> sprites = assets_->sprites();
+    v.spriteMatch.assign(sprites.size(), 0);
+    for (size_t s = 0; s < sprites.size(); ++s)
+        v.spriteMatch[s] = v.applied.empty() || containsNoCase(assets_->path(static_cast<SpriteId>(s)), v.applied.c_str());
+}
+
+void VulkanImGuiApp::scanInspector()
+{
+    InspectorView& v = inspector_;
+    const size_t end = std::min(v.sourceSize, v.scanned + kScanBudget);
+    for (size_t k = v.scanned; k < end; ++k) {
+        const uint32_t index = v.narrowing ? v.source[k] : static_cast<uint32_t>(k);
+        const Entity* e = entities[index];
+        if (!e) continue;
+        const size_t sprite = static_cast<size_t>(e->getSpriteId());
+        if (sprite < v.spriteMatch.size() && v.spriteMatch[sprite]) v.rows.push_back(index);
+    }
+    v.scanned = end;
+}
+
+// Sortowanie indeksów, nie danych: klucz 64-bit = wartość kolumny | indeks encji, radixSort jak lista świata
+void VulkanImGuiApp::sortInspector()
+{
+    InspectorView& v = inspector_;
+    LinearArena& arena = frameArenas_.frame();
+
+    // Ranga sprite'a po ścieżce, żeby kolumna Sprite szła alfabetycznie
+    const uint32_t spriteCount = static_cast<uint32_t>(assets_->sprites().size());
+    uint32_t* order = arena.allocArray<uint32_t>(spriteCount);
+    uint32_t* rank = arena.allocArray<uint32_t>(spriteCount);
+    for (uint32_t s = 0; s < spriteCount; ++s) order[s] = s;
+    std::sort(order, order + spriteCount, [&](uint32_t a, uint32_t b) {
+        return assets_->path(static_cast<SpriteId>(a)) < assets_->path(static_cast<SpriteId>(b));
+    });
+    for (uint32_t r = 0; r < spriteCount; ++r) rank[order[r]] = r;
+
+    const size_t n = v.rows.size();
+    uint64_t* keys = arena.allocArray<uint64_t>(n);
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t index = v.rows[i];
+        const Entity* e = entities[index];
+        uint64_t value = 0;
+        // Encja usunięta po skanie (pusty wpis) - na koniec listy w obu kierunkach
+        if (!e) {
+            keys[i] = kValueMask << kIndexBits | index;
+            continue;
+        }
+        switch (v.sortColumn) {
+        case ColIndex: value = index; break;
+        case ColSprite: value = static_cast<uint32_t>(e->getSpriteId()) < spriteCount ? rank[e->getSpriteId()] : spriteCount; break;
+        case ColX: value = orderedBits(e->getPosition().x); break;
+        case ColY: value = orderedBits(e->getPosition().y); break;
+        case ColSize: value = uint64_t(e->getWidth()) * e->getHeight(); break;
+        case ColLayer: value = e->getLayer(); break;
+        case ColAnimation: value = e->getAnimation() == UINT32_MAX ? 0 : uint64_t(animator_.clip(e->getAnimation())) + 1; break;
+        }
+        value &= kValueMask;
+        if (v.sortDescending) value = kValueMask - value;
+        keys[i] = value << kIndexBits | index;
+    }
+    radixSort(std::span<uint64_t>(keys, n), arena, parallelWorld_ ? jobs_ : nullptr);
+    for (size_t i = 0; i < n; ++i) v.rows[i] = static_cast<uint32_t>(keys[i] & ((uint64_t(1) << kIndexBits) - 1));
+    v.sorted = true;
+}
+
+void VulkanImGuiApp::spawnStressEntities()
+{
+    AllocScope scope(AllocTag::Game);
+    allocFrame_.exempt = true;
+    if (entities.empty()) return;
+    if (inspectorBaseEntities_ == SIZE_MAX) inspectorBaseEntities_ = entities.size();
+    const WorldTarget& wt = worldTarget_;
+    for (uint32_t i = 0; i < kStressEntities; ++i) {
+        const Entity* like = entities[effectsRng_.below(static_cast<uint32_t>(inspectorBaseEntities_))];
+        Entity* e = new Entity(like->getSpriteId(), 16, 16, effectsRng_.unit() * wt.width, effectsRng_.unit() * wt.height);
+        e->setLayer(static_cast<uint8_t>(DrawLayer::Ground));
+        entities.push_back(e);
+    }
+}
+
+void VulkanImGuiApp::removeStressEntities()
+{
+    if (inspectorBaseEntities_ == SIZE_MAX) return;
+    for (size_t i = inspectorBaseEntities_; i < entities.size(); ++i) delete entities[i];
+    entities.resize(inspectorBaseEntities_);
+    inspectorBaseEntities_ = SIZE_MAX;
+    inspector_.selected = UINT32_MAX;
+}
+
+// Tabela przez ImGuiListClipper - układane są tylko widoczne wiersze; filtr i sortowanie działają
+// na wektorze indeksów, więc koszt klatki nie rośnie z liczbą encji
+void VulkanImGuiApp::drawInspectorPanel()
+{
+    InspectorView& v = inspector_;
+    ImGui::Begin("Entities");
+    const auto t0 = std::chrono::steady_clock::now();
+
+    if (ImGui::Button("Spawn 100k")) spawnStressEntities();
+    ImGui::SameLine();
+    ImGui::BeginDisabled(inspectorBaseEntities_ == SIZE_MAX);
+    if (ImGui::Button("Remove spawned")) removeStressEntities();
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(-FLT_MIN);
+    const bool filterChanged = ImGui::InputTextWithHint("##filter", "filter by sprite", v.filter, sizeof(v.filter));
+
+    if (filterChanged || v.entityCount != entities.size()) restartInspectorScan();
+    if (v.scanned < v.sourceSize) scanInspector();
+
+    const ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg
+        | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingFixedFit;
+    const float footer = ImGui::GetFrameHeightWithSpacing();
+    if (ImGui::BeginTable("entities", ColCount, flags, ImVec2(0.0f, -footer))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("#", ImGuiTableColumnFlags_DefaultSort, 0.0f, ColIndex);
+        ImGui::TableSetupColumn("Sprite", ImGuiTableColumnFlags_WidthStretch, 0.0f, ColSprite);
+        ImGui::TableSetupColumn("X", 0, 0.0f, ColX);
+        ImGui::TableSetupColumn("Y", 0, 0.0f, ColY);
+        ImGui::TableSetupColumn("Size", 0, 0.0f, ColSize);
+        ImGui::TableSetupColumn("Layer", 0, 0.0f, ColLayer);
+        ImGui::TableSetupColumn("Animation", 0, 0.0f, ColAnimation);
+        ImGui::TableHeadersRow();
+
+        if (ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs(); specs && specs->SpecsDirty) {
+            if (specs->SpecsCount > 0) {
+                v.sortColumn = static_cast<int>(specs->Specs[0].ColumnUserID);
+                v.sortDescending = specs->Specs[0].SortDirection == ImGuiSortDirection_Descending;
+            }
+            v.sorted = false;
+            specs->SpecsDirty = false;
+        }
+        // Skan od zera daje kolejność indeksów - to już jest sortowanie po „#” rosnąco
+        if (v.scanned == v.sourceSize && !v.sorted) {
+            if (v.sortColumn == ColIndex && !v.sortDescending && !v.narrowing) v.sorted = true;
+            else sortInspector();
+        }
+
+        const AnimationLibrary& library = animator_.library();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(v.rows.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const uint32_t index = v.rows[row];
+                const Entity* e = entities[index];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                char label[16];
+                std::snprintf(label, sizeof(label), "%u", index);
+                if (ImGui::Selectable(label, v.selected == index, ImGuiSelectableFlags_SpanAllColumns)) v.selected = index;
+                if (!e) {
+                    ImGui::TableNextColumn();
+                    ImGui::TextDisabled("(removed)");
+                    continue;
+                }
+                const ImVec2 pos = e->getPosition();
+                ImGui::TableNextColumn();
+                const std::string& path = assets_->path(e->getSpriteId());
+                const size_t slash = path.find_last_of("/\\");
+                ImGui::TextUnformatted(path.c_str() + (slash == std::string::npos ? 0 : slash + 1));
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", pos.x);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", pos.y);
+                ImGui::TableNextColumn(); ImGui::Text("%ux%u", e->getWidth(), e->getHeight());
+                ImGui::TableNextColumn(); ImGui::Text("%u", e->getLayer());
+                ImGui::TableNextColumn();
+                if (e->getAnimation() != UINT32_MAX) ImGui::TextUnformatted(library.clip(animator_.clip(e->getAnimation())).name.c_str());
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    v.buildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    if (v.scanned < v.sourceSize)
+        ImGui::Text("Filtering... %zu / %zu", v.scanned, v.sourceSize);
+    else
+        ImGui::Text("%zu of %zu entities, build %.3f ms", v.rows.size(), entities.size(), v.buildMs);
+    ImGui::End();
+}
@@ -1,9 +1,9 @@
 #include "VulkanImGuiApp.h"
+#include "core/Log.h"
 #include <GLFW/glfw3.h>
 #include <vk_utils.h>
 #include <vector>
 #include <cstring>
-#include <iostream>
 
 namespace {
 static VKAPI_ATTR VkBool32 VKAPI_CALL vkDebugCallback(
@@ -13,11 +13,12 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL vkDebugCallback(
     void* pUserData)
 {
     (void)messageType; (void)pUserData;
-    const char* sev =
-        (messageSeverity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) ? "ERROR" :
-        (messageSeverity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) ? "WARN" :
-        (messageSeverity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT) ? "INFO" : "VERBOSE";
-    std::cerr << "[Vulkan-" << sev << "] " << pCallbackData->pMessage << std::endl;
+    // Wołane z wątku, który wywołał Vulkan (zwykle render) - logger tylko kopiuje tekst do kolejki
+    const LogLevel level =
+        (messageSeverity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) ? LogLevel::Error :
+        (messageSeverity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) ? LogLevel::Warning :
+        (messageSeverity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT) ? LogLevel::Info : LogLevel::Verbose;
+    logger::write(level, LogCategory::Vulkan, "%s", pCallbackData->pMessage);
     return VK_FALSE;
 }
 }
@@ -49,7 +50,7 @@ void VulkanImGuiApp::createInstance()
     ci.enabledLayerCount = static_cast<uint32_t>(layers.size());
     ci.ppEnabledLayerNames = layers.empty() ? nullptr : layers.data();
 
-    vkutils::checkVk(vkCreateInstance(&ci, nullptr, &instance_), "vkCreateInstance failed");
+    vkutils::checkVk(vkCreateInstance(&ci, vkutils::allocator(), &instance_), "vkCreateInstance failed");
 }
 
 void VulkanImGuiApp::setupDebugMessenger()
@@ -63,6 +64,8 @@ void VulkanImGuiApp::setupDebugMessenger()
     ci.messageSeverity =
         VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT |
         VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    if (logger::enabled(LogLevel::Verbose, LogCategory::Vulkan))
+        ci.messageSeverity |= VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT;
     ci.messageType =
         VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT |
         VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT |
@@ -70,9 +73,9 @@ void VulkanImGuiApp::setupDebugMessenger()
     ci.pfnUserCallback = vkDebugCallback;
     ci.pUserData = nullptr;
 
-    VkResult res = vkCreateDebugUtilsMessengerEXT_ptr(instance_, &ci, nullptr, &debugMessenger_);
+    VkResult res = vkCreateDebugUtilsMessengerEXT_ptr(instance_, &ci, vkutils::allocator(), &debugMessenger_);
     if (res != VK_SUCCESS) {
-        std::cerr << "Failed to create Vulkan debug messenger, VkResult=" << res << std::endl;
+        logger::error(LogCategory::Vulkan, "Failed to create debug messenger, VkResult=%d", res);
     }
 #endif
 }
@@ -84,7 +87,7 @@ void VulkanImGuiApp::destroyDebugMessenger()
     auto vkDestroyDebugUtilsMessengerEXT_ptr = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
         vkGetInstanceProcAddr(instance_, "vkDestroyDebugUtilsMessengerEXT"));
     if (vkDestroyDebugUtilsMessengerEXT_ptr)
-        vkDestroyDebugUtilsMessengerEXT_ptr(instance_, debugMessenger_, nullptr);
+        vkDestroyDebugUtilsMessengerEXT_ptr(instance_, debugMessenger_, vkutils::allocator());
     debugMessenger_ = VK_NULL_HANDLE;
 #endif
 }
@@ -0,0 +1,91 @@
+#include "VulkanImGuiApp.h"
+#include <imgui.h>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+constexpr uint32_t kTorchesPerLevel = 24;
+constexpr float kLightmapScale = 3.0f;
+
+const uint32_t kTorchColors[] = { 0x0040A0FFu, 0x0030C0FFu, 0x00FF8060u, 0x0080FF80u };
+}
+
+// Pochodnie na losowych kaflach podłogi; ziarno = piętro, więc po powrocie stoją w tych samych miejscach
+void VulkanImGuiApp::placeTorches()
+{
+    lights_.clear();
+    lights_.setAmbient(lightAmbient_);
+    torches_.clear();
+    const TileMap& tiles = world_.tiles;
+    if (tiles.size() == 0) return;
+    Rng rng(0x70C4ull + level_);
+    for (uint32_t tries = 0; torches_.size() < kTorchesPerLevel && tries < kTorchesPerLevel * 64; ++tries) {
+        const TilePos p{ static_cast<int>(rng.below(static_cast<uint32_t>(tiles.width()))),
+            static_cast<int>(rng.below(static_cast<uint32_t>(tiles.height()))) };
+        if (!tiles.walkable(p.x, p.y)) continue;
+        torches_.push_back(lights_.add({ p, 5 + static_cast<int>(rng.below(4)), kTorchColors[torches_.size() % 4] }));
+    }
+    lightsLevel_ = level_;
+}
+
+// Każda pochodnia o krok w losową stronę - przeliczają się tylko one (i nic poza ich kwadratami)
+void VulkanImGuiApp::moveTorches()
+{
+    static const TilePos kDirs[] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+    for (LightMap::LightId id : torches_) {
+        const TilePos p = lights_.light(id).pos, d = kDirs[effectsRng_.below(4)];
+        if (world_.tiles.walkable(p.x + d.x, p.y + d.y)) lights_.move(id, { p.x + d.x, p.y + d.y });
+    }
+}
+
+// Mapa światła na teksturze dynamicznej: co klatkę tylko obszary zmienione przez update()
+void VulkanImGuiApp::updateLighting()
+{
+    if (lightsLevel_ != level_) placeTorches();
+    const auto t0 = std::chrono::steady_clock::now();
+    lights_.update(world_.tiles, parallelWorld_ ? jobs_ : nullptr);
+    lightingMs_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    if (!assets_ || lights_.width() == 0) return;
+
+    const uint32_t width = static_cast<uint32_t>(lights_.width()), height = static_cast<uint32_t>(lights_.height());
+    bool full = false;
+    if (lightmap_ >= 0 && (assets_->dynamicWidth(lightmap_) != width || assets_->dynamicHeight(lightmap_) != height)) {
+        assets_->destroyDynamicTexture(lightmap_);
+        lightmap_ = -1;
+    }
+    if (lightmap_ < 0) {
+        lightmap_ = assets_->createDynamicTexture(width, height, kFramesInFlight);
+        full = true;
+    }
+    uint32_t* pixels = assets_->dynamicPixels(lightmap_);
+    auto copy = [&](const DirtyRect& rect) {
+        for (uint32_t y = rect.y; y < rect.y + rect.height; ++y)
+            std::copy_n(lights_.pixels() + y * width + rect.x, rect.width, pixels + y * width + rect.x);
+        assets_->markDirty(lightmap_, rect);
+    };
+    if (full) copy({ 0, 0, width, height });
+    else for (const DirtyRect& rect : lights_.dirty().rects()) copy(rect);
+}
+
+void VulkanImGuiApp::drawLightingPanel()
+{
+    updateLighting();
+
+    ImGui::Begin("Lighting");
+    const LightMap::Stats s = lights_.lastUpdate();
+    ImGui::Text("Lights %u, recomputed %u, changed tiles %u", s.lights, s.recomputed, s.changedTiles);
+    ImGui::Text("Update %.3f ms, blended %llu tiles, texels %llu", lightingMs_,
+        static_cast<unsigned long long>(s.blendedTiles), static_cast<unsigned long long>(lights_.dirty().area()));
+    if (ImGui::Button("Move torches")) moveTorches();
+    ImGui::SameLine();
+    int ambient = lightAmbient_;
+    if (ImGui::SliderInt("Ambient", &ambient, 0, 128)) {
+        lightAmbient_ = static_cast<uint8_t>(ambient);
+        lights_.setAmbient(lightAmbient_);
+    }
+    ImGui::Checkbox("Lit minimap", &litMinimap_);
+    if (lightmap_ >= 0)
+        ImGui::Image(assets_->dynamicTexture(lightmap_, currentFrame_),
+            ImVec2(lights_.width() * kLightmapScale, lights_.height() * kLightmapScale));
+    ImGui::End();
+}
@@ -0,0 +1,82 @@
+#include "VulkanImGuiApp.h"
+#include <imgui.h>
+#include <chrono>
+
+namespace {
+constexpr uint32_t kSimActionsPerFrame = 40;     // tempo gry w tle przy włączonym „Simulate”
+constexpr uint32_t kStressMessages = 100000;
+
+ImVec4 kindColor(MessageKind kind)
+{
+    switch (kind) {
+    case MessageKind::Combat: return ImVec4(0.85f, 0.85f, 0.85f, 1.0f);
+    case MessageKind::Hurt: return ImVec4(1.0f, 0.55f, 0.35f, 1.0f);
+    case MessageKind::Death: return ImVec4(1.0f, 0.3f, 0.3f, 1.0f);
+    default: return ImVec4(0.55f, 0.8f, 1.0f, 1.0f);
+    }
+}
+}
+
+// Gra bez okna (game/Simulation.h) jako źródło wiadomości walki; po śmierci gracza następna
+void VulkanImGuiApp::stepLogSimulation(uint32_t actions)
+{
+    for (uint32_t i = 0; i < actions; ++i) {
+        if (!logSim_) {
+            logSim_ = new Simulation(logSimSeed_++);
+            logSim_->setLog(&messages_);
+        }
+        if (!logSim_->step()) {
+            delete logSim_;
+            logSim_ = nullptr;
+        }
+    }
+}
+
+// Wiersze przez ImGuiListClipper: układane są tylko widoczne, koszt nie zależy od długości dziennika
+void VulkanImGuiApp::drawLogPanel()
+{
+    if (logSimRunning_) stepLogSimulation(kSimActionsPerFrame);
+    const auto t0 = std::chrono::steady_clock::now();
+
+    ImGui::Begin("Log");
+    ImGui::Checkbox("Simulate", &logSimRunning_);
+    ImGui::SameLine();
+    if (ImGui::Button("Stress (+100k)")) {
+        allocFrame_.exempt = true;
+        const uint64_t target = messages_.total() + kStressMessages;
+        while (messages_.total() < target) stepLogSimulation(1000);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear")) messages_.clear();
+    ImGui::SameLine();
+    ImGui::Checkbox("Auto-scroll", &logAutoScroll_);
+    ImGui::Text("%u / %u lines (%llu total), %zu distinct texts (%.1f KB), build %.3f ms", messages_.size(),
+        messages_.capacity(), static_cast<unsigned long long>(messages_.total()), messages_.internedCount(),
+        messages_.internedBytes() / 1024.0, logPanelMs_);
+
+    ImGui::BeginChild("lines", ImVec2(0, 0), true);
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(messages_.size()));
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            const MessageLog::Line line = messages_.line(static_cast<uint32_t>(i));
+            ImGui::TextDisabled("%6llu", static_cast<unsigned long long>(line.turn));
+            ImGui::SameLine();
+            ImGui::PushStyleColor(ImGuiCol_Text, kindColor(line.kind));
+            ImGui::TextUnformatted(line.text.data(), line.text.data() + line.text.size());
+            ImGui::PopStyleColor();
+            if (line.repeat > 1) {
+                ImGui::SameLine();
+                ImGui::TextDisabled("x%u", line.repeat);
+            }
+        }
+    }
+    // Przewijanie za nowymi wierszami tylko, gdy użytkownik był na dole
+    if (logAutoScroll_ && messages_.total() != logSeenTotal_ && ImGui::GetScrollY() >= ImGui::GetScrollMaxY() - 1.0f)
+        ImGui::SetScrollHereY(1.0f);
+    logSeenTotal_ = messages_.total();
+    ImGui::EndChild();
+    ImGui::End();
+
+    logPanelMs_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
@@ -0,0 +1,119 @@
+#include "VulkanImGuiApp.h"
+#include "core/AllocTracker.h"
+#include "core/Log.h"
+#include <imgui.h>
+#include <vk_utils.h>
+#include <algorithm>
+#include <cfloat>
+#include <iostream>
+
+// Pamięć hosta sterownika Vulkan i ImGui idzie przez alloctrack, do własnych kategorii
+namespace {
+AllocTag vulkanTag(VkSystemAllocationScope scope)
+{
+    const uint32_t s = std::min<uint32_t>(scope, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    return static_cast<AllocTag>(static_cast<uint32_t>(AllocTag::VkCommand) + s);
+}
+
+VKAPI_ATTR void* VKAPI_CALL vulkanAlloc(void*, size_t size, size_t alignment, VkSystemAllocationScope scope)
+{
+    return alloctrack::allocate(size, alignment, vulkanTag(scope));
+}
+
+VKAPI_ATTR void* VKAPI_CALL vulkanRealloc(void*, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope)
+{
+    return alloctrack::reallocate(original, size, alignment, vulkanTag(scope));
+}
+
+VKAPI_ATTR void VKAPI_CALL vulkanFree(void*, void* memory)
+{
+    alloctrack::release(memory);
+}
+
+const VkAllocationCallbacks kVulkanCallbacks{ nullptr, vulkanAlloc, vulkanRealloc, vulkanFree, nullptr, nullptr };
+
+void* imguiAlloc(size_t size, void*) { return alloctrack::allocate(size, 16, AllocTag::ImGui); }
+void imguiFree(void* ptr, void*) { alloctrack::release(ptr); }
+
+constexpr uint32_t kAllocWarmupFrames = 120;   // ładowanie fontów, pierwsze okna ImGui, pule
+}
+
+const VkAllocationCallbacks* vkutils::allocator()
+{
+    return &kVulkanCallbacks;
+}
+
+void VulkanImGuiApp::initAllocTracking()
+{
+    ImGui::SetAllocatorFunctions(imguiAlloc, imguiFree);   // przed CreateContext
+}
+
+// Początek iteracji pętli: domyka liczniki poprzedniej klatki (wątek główny)
+void VulkanImGuiApp::tickAllocFrame()
+{
+    AllocFrameStats& s = allocFrame_;
+    const uint64_t allocs = alloctrack::threadAllocs();
+    const uint64_t bytes = alloctrack::threadBytes();
+    if (s.frames > 0) {
+        s.lastAllocs = allocs - s.markAllocs;
+        s.lastBytes = bytes - s.markBytes;
+        s.history[s.historyPos] = static_cast<float>(s.lastAllocs);
+        s.historyPos = (s.historyPos + 1) % AllocFrameStats::kHistory;
+
+        if (s.frames > kAllocWarmupFrames && !s.exempt) {
+            s.worstAllocs = std::max(s.worstAllocs, s.lastAllocs);
+            if (options_.allocBudget >= 0 && s.lastAllocs > static_cast<uint64_t>(options_.allocBudget)) {
+                if (++s.overBudget <= 10)
+                    logger::warning(LogCategory::Alloc, "frame %llu: %llu allocations (%llu B), budget %d",
+                        s.frames, s.lastAllocs, s.lastBytes, options_.allocBudget);
+            }
+        }
+    }
+    s.markAllocs = allocs;
+    s.markBytes = bytes;
+    s.exempt = false;
+    ++s.frames;
+}
+
+bool VulkanImGuiApp::allocBudgetPassed() const
+{
+    if (options_.allocBudget < 0) return true;
+    const AllocFrameStats& s = allocFrame_;
+    std::cout << "[Alloc] budget " << options_.allocBudget << "/frame: worst steady-state frame "
+              << s.worstAllocs << ", " << s.overBudget << " frame(s) over budget" << std::endl;
+    if (s.frames <= kAllocWarmupFrames)
+        std::cerr << "[Alloc] only " << s.frames << " frames - steady state never reached" << std::endl;
+    return s.overBudget == 0 && s.frames > kAllocWarmupFrames;
+}
+
+void VulkanImGuiApp::drawMemoryPanel()
+{
+    const AllocFrameStats& s = allocFrame_;
+    ImGui::Begin("Memory");
+    if (!alloctrack::hooksInstalled()) ImGui::TextDisabled("operator new not hooked - heap counters incomplete");
+    ImGui::Text("Last frame: %llu allocs, %llu B", static_cast<unsigned long long>(s.lastAllocs),
+        static_cast<unsigned long long>(s.lastBytes));
+    ImGui::Text("Worst after warm-up: %llu allocs", static_cast<unsigned long long>(s.worstAllocs));
+    ImGui::PlotHistogram("##allocs", s.history, AllocFrameStats::kHistory, static_cast<int>(s.historyPos),
+        "allocs/frame", 0.0f, FLT_MAX, ImVec2(0, 50));
+    ImGui::Text("Live %.1f KiB, peak %.1f KiB", alloctrack::liveBytes() / 1024.0, alloctrack::peakBytes() / 1024.0);
+
+    if (ImGui::BeginTable("tags", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("Tag");
+        ImGui::TableSetupColumn("Allocs");
+        ImGui::TableSetupColumn("Frees");
+        ImGui::TableSetupColumn("Live KiB");
+        ImGui::TableHeadersRow();
+        for (uint32_t i = 0; i < static_cast<uint32_t>(AllocTag::Count); ++i) {
+            const AllocCounters c = alloctrack::counters(static_cast<AllocTag>(i));
+            if (c.allocs == 0) continue;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(allocTagName(static_cast<AllocTag>(i)));
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(c.allocs));
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(c.frees));
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", c.liveBytes() / 1024.0);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
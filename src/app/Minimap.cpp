@@ -0,0 +1,83 @@
+#include "VulkanImGuiApp.h"
+#include <imgui.h>
+#include <cstring>
+
+namespace {
+constexpr float kMinimapScale = 3.0f;
+
+// RGBA8 w pamięci (R w najniższym bajcie) po bitach kafla
+uint32_t tileColor(uint8_t flags)
+{
+    switch (flags & (TileWalkable | TileTransparent)) {
+    case TileFloor: return 0xFF383838u;
+    case TileWalkable: return 0xFF305878u;      // przechodni, ale zasłania widok
+    case TileTransparent: return 0xFF784818u;   // widać przez niego, ale nie przejdzie się
+    default: return 0xFFB4B4B4u;                // ściana
+    }
+}
+
+// Kolor kafla przemnożony przez światło (po kanale, alfa bez zmian)
+uint32_t litColor(uint32_t color, uint32_t light)
+{
+    uint32_t out = color & 0xFF000000u;
+    for (uint32_t shift = 0; shift < 24; shift += 8)
+        out |= (((color >> shift) & 0xFF) * ((light >> shift) & 0xFF) / 255) << shift;
+    return out;
+}
+}
+
+// Kafle porównywane z kopią CPU przy każdej zmianie mapy (wiersze memcmp, po bajtach tylko różne,
+// jak LightMap::detectChanges); na GPU idą tylko zmienione piksele (sąsiednie scalone
+// w prostokąty), osobno dla każdej klatki w locie
+void VulkanImGuiApp::drawMinimapPanel()
+{
+    const TileMap& tiles = world_.tiles;
+    if (tiles.size() == 0 || !assets_) return;
+    const uint32_t width = static_cast<uint32_t>(tiles.width()), height = static_cast<uint32_t>(tiles.height());
+
+    if (minimap_ >= 0 && (assets_->dynamicWidth(minimap_) != width || assets_->dynamicHeight(minimap_) != height)) {
+        assets_->destroyDynamicTexture(minimap_);
+        minimap_ = -1;
+    }
+    if (minimap_ < 0) {
+        minimap_ = assets_->createDynamicTexture(width, height, kFramesInFlight, tileColor(TileWall));
+        minimapTiles_.clear();
+    }
+    const bool lit = litMinimap_ && lights_.width() == tiles.width() && lights_.height() == tiles.height();
+    auto pixel = [&](uint32_t x, uint32_t y) {
+        const uint32_t color = tileColor(tiles.at(static_cast<int>(x), static_cast<int>(y)));
+        assets_->setPixel(minimap_, x, y, lit ? litColor(color, lights_.at(static_cast<int>(x), static_cast<int>(y))) : color);
+    };
+    if (minimapTiles_.size() != tiles.size() || minimapLit_ != lit) {
+        // Nowa tekstura albo przełączone światło - wszystkie piksele
+        for (uint32_t y = 0; y < height; ++y)
+            for (uint32_t x = 0; x < width; ++x) pixel(x, y);
+        minimapTiles_.assign(tiles.data(), tiles.data() + tiles.size());
+        minimapRevision_ = tiles.revision();
+        minimapLit_ = lit;
+    } else {
+        if (minimapRevision_ != tiles.revision()) {
+            for (uint32_t y = 0; y < height; ++y) {
+                const size_t row = static_cast<size_t>(y) * width;
+                if (std::memcmp(minimapTiles_.data() + row, tiles.data() + row, width) == 0) continue;
+                for (uint32_t x = 0; x < width; ++x)
+                    if (minimapTiles_[row + x] != tiles.data()[row + x]) pixel(x, y);
+                std::memcpy(minimapTiles_.data() + row, tiles.data() + row, width);
+            }
+            minimapRevision_ = tiles.revision();
+        }
+        if (lit) {
+            // Światło zmienione w tej klatce (drawLightingPanel idzie wcześniej)
+            for (const DirtyRect& rect : lights_.dirty().rects())
+                for (uint32_t y = rect.y; y < rect.y + rect.height; ++y)
+                    for (uint32_t x = rect.x; x < rect.x + rect.width; ++x) pixel(x, y);
+        }
+    }
+
+    ImGui::Begin("Minimap");
+    ImGui::Image(assets_->dynamicTexture(minimap_, currentFrame_), ImVec2(width * kMinimapScale, height * kMinimapScale));
+    const Assets::DynamicUploadStats upload = assets_->lastDynamicUpload();
+    ImGui::Text("Last upload: %u regions, %llu B (full map %llu B)", upload.regions,
+        static_cast<unsigned long long>(upload.bytes), static_cast<unsigned long long>(width) * height * 4);
+    ImGui::End();
+}
@@ -0,0 +1,146 @@
+#include "VulkanImGuiApp.h"
+#include "Game.h"
+#include "GameSetup.h"
+#include "core/AllocTracker.h"
+#include <vk_utils.h>
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+extern std::vector<Entity*> entities;
+
+namespace {
+const char* kPipelineCachePath = "pipeline.cache";
+// Tabelę prefabów kompiluje build do swojego katalogu; bez CMake - obok źródeł
+#ifdef ROGUELIKE_PREFAB_TABLE
+const char* kPrefabTable = ROGUELIKE_PREFAB_TABLE;
+#else
+const char* kPrefabTable = "assets/prefabs.rlpf";
+#endif
+
+// Przy wyjątku na wątku głównym zadania nadal piszą do składowych aplikacji - czekamy na nie
+struct JoinJobs {
+    JobSystem& jobs;
+    JobCounter* counters[3];
+    ~JoinJobs() { for (JobCounter* c : counters) jobs.wait(*c); }
+};
+}
+
+// Start aplikacji jako graf zależności na JobSystemie:
+//   animations.txt -> dekodowanie PNG arkuszy (równolegle) --+
+//   setupWorld ----------------------------------------------+--> upload sprite'ów + encje -> pętla
+//   okno -> Vulkan -> ImGui -> WorldTarget (wątek główny) ----+
+// GLFW i Vulkan zostają na wątku głównym; na wątkach roboczych jest tylko praca bez API okna/GPU.
+void VulkanImGuiApp::startup()
+{
+    JobCounter libraryReady, spritesDecoded, levelReady;
+    std::exception_ptr libraryError, levelError;
+    JoinJobs join{ *jobs_, { &libraryReady, &spritesDecoded, &levelReady } };
+
+    jobs_->schedule(libraryReady, [this, &libraryError, &spritesDecoded] {
+        StartupProfile::Scope phase(startupProfile_, "animations + prefabs + decode jobs");
+        try {
+            AllocScope scope(AllocTag::Assets);
+            animations_.loadFile("assets/animations.txt");
+            prefabTable_.loadFiles(kPrefabTable, "assets/prefabs.txt", "assets/animations.txt", animations_);
+            std::vector<std::string> paths;
+            auto addPath = [&](std::string_view path) {
+                if (std::find(paths.begin(), paths.end(), path) == paths.end()) paths.emplace_back(path);
+            };
+            for (uint32_t i = 0; i < prefabTable_.pathCount(); ++i) addPath(prefabTable_.path(i));
+            for (const SpriteSheet& sheet : animations_.sheets()) addPath(sheet.path);
+            preloaded_.resize(paths.size());
+            for (size_t i = 0; i < paths.size(); ++i) {
+                preloaded_[i].path = paths[i];   // decode() czyta ścieżkę ze slotu
+                jobs_->schedule(spritesDecoded, [this, i] {
+                    StartupProfile::Scope decode(startupProfile_, "sprite decode");
+                    preloaded_[i] = Assets::decode(preloaded_[i].path);
+                });
+            }
+        } catch (...) {
+            libraryError = std::current_exception();
+        }
+    });
+    // setupWorld dotyka tylko kafli i tury; rng ustawia initInputCapture na wątku głównym
+    jobs_->schedule(levelReady, [this, &levelError] {
+        StartupProfile::Scope phase(startupProfile_, "level");
+        try {
+            AllocScope scope(AllocTag::Game);
+            setupWorld(world_);
+        } catch (...) {
+            levelError = std::current_exception();
+        }
+    });
+
+    { StartupProfile::Scope phase(startupProfile_, "window"); initWindow(); }
+    { StartupProfile::Scope phase(startupProfile_, "vulkan"); initVulkan(); }
+    // przed ImGui - backend łańcuchowo woła nasze callbacki
+    { StartupProfile::Scope phase(startupProfile_, "input capture"); initInputCapture(); }
+    { StartupProfile::Scope phase(startupProfile_, "imgui"); initImGui(); }
+    { StartupProfile::Scope phase(startupProfile_, "world target"); createWorldTarget(); }
+
+    {
+        StartupProfile::Scope phase(startupProfile_, "wait for cpu tasks");
+        jobs_->wait(libraryReady);
+        jobs_->wait(spritesDecoded);
+        jobs_->wait(levelReady);
+    }
+    if (libraryError) std::rethrow_exception(libraryError);
+    if (levelError) std::rethrow_exception(levelError);
+
+    {
+        StartupProfile::Scope phase(startupProfile_, "sprite upload + entities");
+        AllocScope scope(AllocTag::Game);
+        for (DecodedImage& image : preloaded_) assets_->addDecoded(std::move(image));
+        preloaded_.clear();
+        prefabs_ = resolvePrefabs(prefabTable_, assets_, animations_);
+        setupGameEntities(entities, prefabTable_, prefabs_, animator_);
+    }
+}
+
+void VulkanImGuiApp::onFramePresented()
+{
+    firstFramePresented_ = true;
+    startupProfile_.mark("first interactive frame");
+    if (!options_.startupReport) return;
+    startupProfile_.print(std::cout);
+    std::cout << "[Startup] total " << startupProfile_.elapsedMs() << " ms" << std::endl;
+}
+
+// --- Cache potoków (pipeline.cache obok pliku wykonywalnego) ---
+void VulkanImGuiApp::createPipelineCache()
+{
+    std::vector<char> data;
+    if (std::ifstream in{ kPipelineCachePath, std::ios::binary })
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+    VkPipelineCacheCreateInfo ci{ VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+    ci.initialDataSize = data.size();
+    ci.pInitialData = data.empty() ? nullptr : data.data();
+    if (vkCreatePipelineCache(device_, &ci, vkutils::allocator(), &pipelineCache_) == VK_SUCCESS) return;
+
+    // Plik z innego sterownika/GPU albo uszkodzony - zaczynamy od pustego cache
+    ci.initialDataSize = 0;
+    ci.pInitialData = nullptr;
+    if (vkCreatePipelineCache(device_, &ci, vkutils::allocator(), &pipelineCache_) != VK_SUCCESS)
+        throw std::runtime_error("Failed to create pipeline cache");
+}
+
+void VulkanImGuiApp::destroyPipelineCache()
+{
+    if (!pipelineCache_) return;
+    size_t size = 0;
+    if (vkGetPipelineCacheData(device_, pipelineCache_, &size, nullptr) == VK_SUCCESS && size > 0) {
+        std::vector<char> data(size);
+        if (vkGetPipelineCacheData(device_, pipelineCache_, &size, data.data()) == VK_SUCCESS) {
+            std::ofstream out(kPipelineCachePath, std::ios::binary | std::ios::trunc);
+            out.write(data.data(), static_cast<std::streamsize>(size));
+            if (!out) std::cerr << "[Vulkan] Failed to write " << kPipelineCachePath << std::endl;
+        }
+    }
+    vkDestroyPipelineCache(device_, pipelineCache_, vkutils::allocator());
+    pipelineCache_ = VK_NULL_HANDLE;
+}
@@ -1,13 +1,14 @@
 #include "VulkanImGuiApp.h"
 #include <GLFW/glfw3.h>
 #include <vk_utils.h>
+#include "core/AllocTracker.h"
 #include <imgui.h>
 #include <imgui_impl_vulkan.h>
 #include <algorithm>
 
-VulkanImGuiApp::SwapChainSupportDetails VulkanImGuiApp::querySwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface)
+VulkanImGuiApp::SwapChainSupportDetails VulkanImGuiApp::querySwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface, LinearArena& arena)
 {
-    SwapChainSupportDetails d{};
+    SwapChainSupportDetails d(arena);
     vkGetPhysicalDeviceSurfaceCapabilitiesKHR(device, surface, &d.capabilities);
     uint32_t fmtCount = 0, pmCount = 0;
     vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &fmtCount, nullptr);
@@ -17,7 +18,7 @@ VulkanImGuiApp::SwapChainSupportDetails VulkanImGuiApp::querySwapChainSupport(Vk
     return d;
 }
 
-VkSurfaceFormatKHR VulkanImGuiApp::chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& formats)
+VkSurfaceFormatKHR VulkanImGuiApp::chooseSwapSurfaceFormat(std::span<const VkSurfaceFormatKHR> formats)
 {
     for (const auto& f : formats) {
         if (f.format == VK_FORMAT_B8G8R8A8_UNORM && f.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR)
@@ -26,8 +27,11 @@ VkSurfaceFormatKHR VulkanImGuiApp::chooseSwapSurfaceFormat(const std::vector<VkS
     return formats[0];
 }
 
-VkPresentModeKHR VulkanImGuiApp::choosePresentMode(const std::vector<VkPresentModeKHR>& modes)
+VkPresentModeKHR VulkanImGuiApp::choosePresentMode(std::span<const VkPresentModeKHR> modes, bool uncapped)
 {
+    // Bez vsync (powtórka na czas) - klatki nie czekają na odświeżenie ekranu
+    if (uncapped)
+        for (auto m : modes) if (m == VK_PRESENT_MODE_IMMEDIATE_KHR) return m;
     for (auto m : modes) if (m == VK_PRESENT_MODE_MAILBOX_KHR) return m;
     return VK_PRESENT_MODE_FIFO_KHR;
 }
@@ -44,9 +48,9 @@ VkExtent2D VulkanImGuiApp::chooseExtent(const VkSurfaceCapabilitiesKHR& caps, GL
 
 void VulkanImGuiApp::createSwapchain()
 {
-    auto support = querySwapChainSupport(physicalDevice_, surface_);
+    auto support = querySwapChainSupport(physicalDevice_, surface_, frameArenas_.frame());
     auto surfaceFormat = chooseSwapSurfaceFormat(support.formats);
-    auto presentMode = choosePresentMode(support.presentModes);
+    auto presentMode = choosePresentMode(support.presentModes, replaying_ && !options_.realtime);
     auto extent = chooseExtent(support.capabilities, window_);
 
     uint32_t imageCount = support.capabilities.minImageCount + 1;
@@ -62,7 +66,7 @@ void VulkanImGuiApp::createSwapchain()
     ci.imageArrayLayers = 1;
     ci.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 
-    auto indices = findQueueFamilies(physicalDevice_, surface_);
+    const QueueFamilyIndices& indices = caps_.queues;
     uint32_t queueFamilyIndices[] = { indices.graphicsFamily.value(), indices.presentFamily.value() };
     if (indices.graphicsFamily != indices.presentFamily) {
         ci.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
@@ -76,7 +80,7 @@ void VulkanImGuiApp::createSwapchain()
     ci.presentMode = presentMode;
     ci.clipped = VK_TRUE;
 
-    vkutils::checkVk(vkCreateSwapchainKHR(device_, &ci, nullptr, &swapchain_), "vkCreateSwapchain failed");
+    vkutils::checkVk(vkCreateSwapchainKHR(device_, &ci, vkutils::allocator(), &swapchain_), "vkCreateSwapchain failed");
 
     uint32_t count = 0;
     vkGetSwapchainImagesKHR(device_, swapchain_, &count, nullptr);
@@ -99,49 +103,15 @@ void VulkanImGuiApp::createSwapchain()
         ivci.subresourceRange.baseArrayLayer = 0;
         ivci.subresourceRange.layerCount = 1;
         ImageWithView iw{}; iw.image = img;
-        vkutils::checkVk(vkCreateImageView(device_, &ivci, nullptr, &iw.view), "vkCreateImageView failed");
+        vkutils::checkVk(vkCreateImageView(device_, &ivci, vkutils::allocator(), &iw.view), "vkCreateImageView failed");
         swapchainImages_.push_back(iw);
     }
 }
 
 void VulkanImGuiApp::createRenderPass()
 {
-    VkAttachmentDescription color{};
-    color.format = swapchainImageFormat_;
-    color.samples = VK_SAMPLE_COUNT_1_BIT;
-    color.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    color.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    color.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    color.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    color.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    color.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-    VkAttachmentReference colorRef{};
-    colorRef.attachment = 0;
-    colorRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-    VkSubpassDescription subpass{};
-    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-    subpass.colorAttachmentCount = 1;
-    subpass.pColorAttachments = &colorRef;
-
-    VkSubpassDependency dep{};
-    dep.srcSubpass = VK_SUBPASS_EXTERNAL;
-    dep.dstSubpass = 0;
-    dep.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dep.srcAccessMask = 0;
-    dep.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dep.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-    VkRenderPassCreateInfo rpci{ VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO };
-    rpci.attachmentCount = 1;
-    rpci.pAttachments = &color;
-    rpci.subpassCount = 1;
-    rpci.pSubpasses = &subpass;
-    rpci.pDependencies = &dep;
-    rpci.dependencyCount = 1;
-
-    vkutils::checkVk(vkCreateRenderPass(device_, &rpci, nullptr, &renderPass_), "vkCreateRenderPass failed");
+    // Przejścia UNDEFINED/PRESENT_SRC i czekanie na acquire robi graf klatki (createWorldTarget)
+    renderPass_ = createColorRenderPass(device_, swapchainImageFormat_);
 }
 
 void VulkanImGuiApp::createFramebuffers()
@@ -156,21 +126,23 @@ void VulkanImGuiApp::createFramebuffers()
         fbci.width = swapchainExtent_.width;
         fbci.height = swapchainExtent_.height;
         fbci.layers = 1;
-        vkutils::checkVk(vkCreateFramebuffer(device_, &fbci, nullptr, &framebuffers_[i]), "vkCreateFramebuffer failed");
+        vkutils::checkVk(vkCreateFramebuffer(device_, &fbci, vkutils::allocator(), &framebuffers_[i]), "vkCreateFramebuffer failed");
     }
 }
 
 void VulkanImGuiApp::cleanupSwapchain()
 {
-    for (auto fb : framebuffers_) vkDestroyFramebuffer(device_, fb, nullptr);
+    for (auto fb : framebuffers_) vkDestroyFramebuffer(device_, fb, vkutils::allocator());
     framebuffers_.clear();
-    for (auto& iw : swapchainImages_) vkDestroyImageView(device_, iw.view, nullptr);
+    for (auto& iw : swapchainImages_) vkDestroyImageView(device_, iw.view, vkutils::allocator());
     swapchainImages_.clear();
-    if (swapchain_) { vkDestroySwapchainKHR(device_, swapchain_, nullptr); swapchain_ = VK_NULL_HANDLE; }
+    if (swapchain_) { vkDestroySwapchainKHR(device_, swapchain_, vkutils::allocator()); swapchain_ = VK_NULL_HANDLE; }
 }
 
 void VulkanImGuiApp::recreateSwapchain()
 {
+    AllocScope scope(AllocTag::Render);
+    allocFrame_.exempt = true;
     int w = 0, h = 0;
     while (w == 0 || h == 0) {
         glfwGetFramebufferSize(window_, &w, &h);
@@ -182,7 +154,7 @@ void VulkanImGuiApp::recreateSwapchain()
     cleanupSwapchain();
 
     if (renderPass_) {
-        vkDestroyRenderPass(device_, renderPass_, nullptr);
+        vkDestroyRenderPass(device_, renderPass_, vkutils::allocator());
         renderPass_ = VK_NULL_HANDLE;
     }
 
@@ -192,13 +164,15 @@ void VulkanImGuiApp::recreateSwapchain()
     createFramebuffers();
 
     if (commandPool_) {
-        vkDestroyCommandPool(device_, commandPool_, nullptr);
+        vkDestroyCommandPool(device_, commandPool_, vkutils::allocator());
         commandPool_ = VK_NULL_HANDLE;
     }
     createCommandPoolAndBuffers();
 
     // Re-init ImGui Vulkan backend with the new render pass and image counts
+    destroyWorldTarget();
     reinitImGuiRenderer();
+    createWorldTarget();
 
     ImGui_ImplVulkan_SetMinImageCount(static_cast<uint32_t>(swapchainImages_.size()));
 }
@@ -208,11 +182,35 @@ void VulkanImGuiApp::recordCommandBuffer(VkCommandBuffer cmd, uint32_t imageInde
     VkCommandBufferBeginInfo bi{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
     vkutils::checkVk(vkBeginCommandBuffer(cmd, &bi), "vkBeginCommandBuffer failed");
 
+    if (assets_) {
+        assets_->recordAcquires(cmd);
+        assets_->recordDynamicUploads(cmd, currentFrame_);
+    }
+
+    VkQueryPool timestamps = worldTarget_.timestamps;
+    if (timestamps) {
+        vkCmdResetQueryPool(cmd, timestamps, currentFrame_ * 2, 2);
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestamps, currentFrame_ * 2);
+    }
+    acquiredImage_ = imageIndex;
+    frameGraph_.setImage(backbuffer_, swapchainImages_[imageIndex].image);
+    frameGraph_.execute(cmd);
+
+    if (timestamps) {
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestamps, currentFrame_ * 2 + 1);
+        worldTarget_.timestampWritten[currentFrame_] = 1;
+    }
+
+    vkutils::checkVk(vkEndCommandBuffer(cmd), "vkEndCommandBuffer failed");
+}
+
+void VulkanImGuiApp::recordUiPass(VkCommandBuffer cmd)
+{
     VkClearValue clear{}; clear.color = { { 0.10f, 0.15f, 0.20f, 1.0f } };
 
     VkRenderPassBeginInfo rpbi{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
     rpbi.renderPass = renderPass_;
-    rpbi.framebuffer = framebuffers_[imageIndex];
+    rpbi.framebuffer = framebuffers_[acquiredImage_];
     rpbi.renderArea.offset = {0,0};
     rpbi.renderArea.extent = swapchainExtent_;
     rpbi.clearValueCount = 1;
@@ -221,6 +219,4 @@ void VulkanImGuiApp::recordCommandBuffer(VkCommandBuffer cmd, uint32_t imageInde
     vkCmdBeginRenderPass(cmd, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
     ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), cmd);
     vkCmdEndRenderPass(cmd);
-
-    vkutils::checkVk(vkEndCommandBuffer(cmd), "vkEndCommandBuffer failed");
 }
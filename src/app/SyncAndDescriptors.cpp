@@ -3,11 +3,10 @@
 
 void VulkanImGuiApp::createCommandPoolAndBuffers()
 {
-    auto indices = findQueueFamilies(physicalDevice_, surface_);
     VkCommandPoolCreateInfo cpci{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
-    cpci.queueFamilyIndex = indices.graphicsFamily.value();
+    cpci.queueFamilyIndex = graphicsFamily_;
     cpci.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    vkutils::checkVk(vkCreateCommandPool(device_, &cpci, nullptr, &commandPool_), "vkCreateCommandPool failed");
+    vkutils::checkVk(vkCreateCommandPool(device_, &cpci, vkutils::allocator(), &commandPool_), "vkCreateCommandPool failed");
 
     commandBuffers_.resize(framebuffers_.size());
     VkCommandBufferAllocateInfo cbai{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
@@ -19,17 +18,16 @@ void VulkanImGuiApp::createCommandPoolAndBuffers()
 
 void VulkanImGuiApp::createSyncObjects()
 {
-    const size_t MAX_FRAMES_IN_FLIGHT = 2;
-    frames_.resize(MAX_FRAMES_IN_FLIGHT);
+    frames_.resize(kFramesInFlight);
 
     VkSemaphoreCreateInfo sci{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
     VkFenceCreateInfo fci{ VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
     fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
     for (auto& f : frames_) {
-        vkutils::checkVk(vkCreateSemaphore(device_, &sci, nullptr, &f.imageAvailable), "vkCreateSemaphore failed");
-        vkutils::checkVk(vkCreateSemaphore(device_, &sci, nullptr, &f.renderFinished), "vkCreateSemaphore failed");
-        vkutils::checkVk(vkCreateFence(device_, &fci, nullptr, &f.inFlight), "vkCreateFence failed");
+        vkutils::checkVk(vkCreateSemaphore(device_, &sci, vkutils::allocator(), &f.imageAvailable), "vkCreateSemaphore failed");
+        vkutils::checkVk(vkCreateSemaphore(device_, &sci, vkutils::allocator(), &f.renderFinished), "vkCreateSemaphore failed");
+        vkutils::checkVk(vkCreateFence(device_, &fci, vkutils::allocator(), &f.inFlight), "vkCreateFence failed");
     }
 }
 
@@ -53,6 +51,6 @@ void VulkanImGuiApp::createDescriptorPoolForImGui()
     pool_info.maxSets = 1000 * static_cast<uint32_t>(pool_sizes.size());
     pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
     pool_info.pPoolSizes = pool_sizes.data();
-    vkutils::checkVk(vkCreateDescriptorPool(device_, &pool_info, nullptr, &imguiDescriptorPool_), "vkCreateDescriptorPool failed");
+    vkutils::checkVk(vkCreateDescriptorPool(device_, &pool_info, vkutils::allocator(), &imguiDescriptorPool_), "vkCreateDescriptorPool failed");
 }
 
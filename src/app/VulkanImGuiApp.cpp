@@ -1,34 +1,58 @@
 #include "VulkanImGuiApp.h"
 #include "Game.h"
 #include "GameSetup.h"
+#include "WorldDraw.h"
+#include "core/AllocTracker.h"
+#include "core/Log.h"
+#include "core/RadixSort.h"
 #include <GLFW/glfw3.h>
 #include <imgui.h>
+#include <imgui_internal.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_vulkan.h>
 #include <vk_utils.h>
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
 
+namespace {
+constexpr uint32_t kSettleFrames = 3;         // po zdarzeniu: hover, układ i animacje ImGui dochodzą do stanu
+constexpr double kLoadingPoll = 1.0 / 60.0;   // jak często sprawdzać wgrywane tekstury w bezczynności
+constexpr float kMaxAnimationStep = 0.25f;    // dt po długim śnie nie przewija animacji o wiele cykli
+
+// Średnia krocząca czasu w ms (pierwsza próbka wprost)
+float smoothMs(float average, std::chrono::steady_clock::time_point t0, std::chrono::steady_clock::time_point t1)
+{
+    const float ms = std::chrono::duration<float, std::milli>(t1 - t0).count();
+    return average > 0.0f ? average * 0.9f + ms * 0.1f : ms;
+}
+}
+
 //tymczasowo tu zeby bylo widac ale kiedys do refaktoryzaji
 std::vector<Entity*> entities;
 
-int VulkanImGuiApp::run()
+int VulkanImGuiApp::run(const RunOptions& options)
 {
     try {
-        initWindow();
-        initVulkan();
-        initImGui();
-        // --- Wczytaj ikonę jako teksturę i zarejestruj w ImGui ---        
-        setupGameEntities(entities, assets_);
+        options_ = options;
+        replaying_ = !options_.replayPath.empty();
+        idleRendering_ = options_.idle;
+        startupProfile_.start();
+        jobs_ = new JobSystem();
+        startup();   // Startup.cpp
         mainLoop();
         vkDeviceWaitIdle(device_);
+        logger::flush();   // raport poniżej idzie prosto na stdout
+        alloctrack::printReport(std::cout);
+        const bool budgetOk = allocBudgetPassed();
         cleanup();
+        return budgetOk ? EXIT_SUCCESS : EXIT_FAILURE;
     } catch (const std::exception& e) {
+        logger::flush();
         std::cerr << "Fatal: " << e.what() << std::endl;
         cleanup();
         return EXIT_FAILURE;
     }
-    return EXIT_SUCCESS;
 }
 
 int VulkanImGuiApp::runSmokeTest()
@@ -53,12 +77,14 @@ int VulkanImGuiApp::runSmokeTest()
 
 void VulkanImGuiApp::initVulkan()
 {
+    AllocScope scope(AllocTag::Render);
     createInstance();
     setupDebugMessenger();
-    if (glfwCreateWindowSurface(instance_, window_, nullptr, &surface_) != VK_SUCCESS)
+    if (glfwCreateWindowSurface(instance_, window_, vkutils::allocator(), &surface_) != VK_SUCCESS)
         throw std::runtime_error("Failed to create window surface");
     pickPhysicalDevice();
     createLogicalDevice();
+    createPipelineCache();
     createSwapchain();
     createRenderPass();
     createFramebuffers();
@@ -66,7 +92,7 @@ void VulkanImGuiApp::initVulkan()
     createSyncObjects();
     createDescriptorPoolForImGui();
     //tymczasowo tu zeby bylo widac ale kiedys do refaktoryzaji
-    Assets::Ctx actx{ physicalDevice_, device_, graphicsQueue_, commandPool_ };
+    Assets::Ctx actx{ physicalDevice_, caps_.memory, device_, graphicsQueue_, graphicsFamily_, transferQueue_, transferFamily_ };
     assets_ = new Assets(actx);
 }
 
@@ -76,23 +102,36 @@ void VulkanImGuiApp::mainLoop()
     bool show_window = true;
 
     while (!glfwWindowShouldClose(window_)) {
-        glfwPollEvents();
+        tickAllocFrame();
+        if (options_.maxFrames && allocFrame_.frames > options_.maxFrames) break;
+        waitForRedraw();
+        if (replaying_ && replay_.finished()) break;
 
         VulkanImGuiApp::FrameSync& fs = frames_[currentFrame_];
         vkWaitForFences(device_, 1, &fs.inFlight, VK_TRUE, UINT64_MAX);
         vkResetFences(device_, 1, &fs.inFlight);
+        frameArenas_.beginFrame(currentFrame_);
+        assets_->pollUploads();
+        readGpuTimings();
+        updateRenderScale();
 
         uint32_t imageIndex = 0;
         VkResult acq = vkAcquireNextImageKHR(device_, swapchain_, UINT64_MAX, fs.imageAvailable, VK_NULL_HANDLE, &imageIndex);
         if (acq == VK_ERROR_OUT_OF_DATE_KHR) { recreateSwapchain(); continue; }
         else if (acq != VK_SUCCESS && acq != VK_SUBOPTIMAL_KHR) {
-            std::cerr << "Failed to acquire swapchain image: " << acq << std::endl; break;
+            logger::error(LogCategory::Render, "Failed to acquire swapchain image: %d", acq); break;
         }
 
         ImGui_ImplVulkan_NewFrame();
         ImGui_ImplGlfw_NewFrame();
+        beginInputFrame();
         ImGui::NewFrame();
 
+        if (ImGui::IsKeyPressed(ImGuiKey_F5, false)) quickSave();
+        if (ImGui::IsKeyPressed(ImGuiKey_F9, false)) quickLoad();
+        animator_.update(std::min(ImGui::GetIO().DeltaTime, kMaxAnimationStep));
+        updateParticles(std::min(ImGui::GetIO().DeltaTime, kMaxAnimationStep));
+
         // --- Rysowanie świata/tła (poza oknami) ---
         drawWorld();
 
@@ -103,9 +142,18 @@ void VulkanImGuiApp::mainLoop()
             if (ImGui::Button("Zamknij")) show_window = false;
             ImGui::End();
         }
+        drawRenderPanel();
+        drawMemoryPanel();
+        drawLightingPanel();
+        drawMinimapPanel();
+        drawDungeonPanel();
+        drawEffectsPanel();
+        drawLogPanel();
+        drawInspectorPanel();
         if (show_demo) ImGui::ShowDemoWindow(&show_demo);
 
         ImGui::Render();
+        scheduleRedraw();
 
         VkCommandBuffer cmd = commandBuffers_[imageIndex];
         vkResetCommandBuffer(cmd, 0);
@@ -125,13 +173,53 @@ void VulkanImGuiApp::mainLoop()
         if (pres == VK_ERROR_OUT_OF_DATE_KHR || pres == VK_SUBOPTIMAL_KHR) {
             recreateSwapchain();
         } else if (pres != VK_SUCCESS) {
-            std::cerr << "vkQueuePresentKHR failed: " << pres << std::endl; break;
+            logger::error(LogCategory::Render, "vkQueuePresentKHR failed: %d", pres); break;
         }
+        if (!firstFramePresented_) onFramePresented();
 
         currentFrame_ = (currentFrame_ + 1) % static_cast<uint32_t>(frames_.size());
     }
 }
 
+// Zamiast glfwPollEvents: gdy żadna klatka nie jest potrzebna, śpi do zdarzenia albo budzika.
+// Powtórka i --frames zawsze rysują (liczą się kolejne klatki, nie czas).
+void VulkanImGuiApp::waitForRedraw()
+{
+    double now = glfwGetTime();
+    if (!idleRendering_ || replaying_ || options_.maxFrames) {
+        glfwPollEvents();
+        redraw_.requestFrames(RedrawScheduler::Input);
+    } else if (redraw_.frameDue(now)) {
+        glfwPollEvents();
+    } else {
+        redraw_.countWait();
+        const double timeout = redraw_.timeout(now);
+        if (timeout >= RedrawScheduler::kNever) glfwWaitEvents();
+        else glfwWaitEventsTimeout(timeout);
+        now = glfwGetTime();
+        // Nie budzik - więc zdarzenie (także zmiana rozmiaru czy odsłonięcie okna)
+        if (!redraw_.frameDue(now)) redraw_.requestFrames(RedrawScheduler::Input, kSettleFrames);
+    }
+    // Wejście zebrane przez backend GLFW czeka w kolejce ImGui na następne NewFrame
+    if (ImGui::GetCurrentContext()->InputEventsQueue.Size > 0)
+        redraw_.requestFrames(RedrawScheduler::Input, kSettleFrames);
+    redraw_.beginFrame(now);
+}
+
+// Po zbudowaniu UI: co wymaga następnych klatek
+void VulkanImGuiApp::scheduleRedraw()
+{
+    const double now = glfwGetTime();
+    const ImGuiIO& io = ImGui::GetIO();
+    if (ImGui::IsAnyItemActive() || io.WantTextInput) redraw_.requestFrames(RedrawScheduler::Interaction);
+    if (assets_->pendingUploads()) redraw_.wakeAt(now + kLoadingPoll, RedrawScheduler::Loading);
+    const float animation = animator_.timeToNextFrame();
+    if (animation < kMaxAnimationStep) redraw_.wakeAt(now + animation, RedrawScheduler::Animation);
+    else if (std::isfinite(animation)) redraw_.wakeAt(now + kMaxAnimationStep, RedrawScheduler::Animation);
+    if (particles_ && particles_->alive()) redraw_.requestFrames(RedrawScheduler::Animation);
+    if (logSimRunning_ || inspector_.scanned < inspector_.sourceSize) redraw_.requestFrames(RedrawScheduler::Simulation);
+}
+
 void VulkanImGuiApp::cleanup()
 {
     if (assets_) { assets_->clear(); delete assets_; assets_ = nullptr; }
@@ -141,49 +229,128 @@ void VulkanImGuiApp::cleanup()
     entities.clear();
 
     // ImGui
+    destroyWorldTarget();
+    if (worldTarget_.drawList) { IM_DELETE(worldTarget_.drawList); worldTarget_.drawList = nullptr; }
+    for (ImDrawList* list : worldTarget_.batchLists) IM_DELETE(list);
+    worldTarget_.batchLists.clear();
+    if (worldTarget_.effectsList) { IM_DELETE(worldTarget_.effectsList); worldTarget_.effectsList = nullptr; }
     ImGui_ImplVulkan_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
 
     // Vulkan sync
     for (auto& f : frames_) {
-        if (f.imageAvailable) vkDestroySemaphore(device_, f.imageAvailable, nullptr);
-        if (f.renderFinished) vkDestroySemaphore(device_, f.renderFinished, nullptr);
-        if (f.inFlight) vkDestroyFence(device_, f.inFlight, nullptr);
+        if (f.imageAvailable) vkDestroySemaphore(device_, f.imageAvailable, vkutils::allocator());
+        if (f.renderFinished) vkDestroySemaphore(device_, f.renderFinished, vkutils::allocator());
+        if (f.inFlight) vkDestroyFence(device_, f.inFlight, vkutils::allocator());
     }
 
-    if (imguiDescriptorPool_) vkDestroyDescriptorPool(device_, imguiDescriptorPool_, nullptr);
+    if (imguiDescriptorPool_) vkDestroyDescriptorPool(device_, imguiDescriptorPool_, vkutils::allocator());
 
-    if (commandPool_) vkDestroyCommandPool(device_, commandPool_, nullptr);
+    if (commandPool_) vkDestroyCommandPool(device_, commandPool_, vkutils::allocator());
 
     cleanupSwapchain();
 
-    if (renderPass_) vkDestroyRenderPass(device_, renderPass_, nullptr);
+    if (renderPass_) vkDestroyRenderPass(device_, renderPass_, vkutils::allocator());
 
-    if (device_) vkDestroyDevice(device_, nullptr);
-    if (surface_) vkDestroySurfaceKHR(instance_, surface_, nullptr);
+    destroyPipelineCache();
+    if (device_) vkDestroyDevice(device_, vkutils::allocator());
+    if (surface_) vkDestroySurfaceKHR(instance_, surface_, vkutils::allocator());
     destroyDebugMessenger();
-    if (instance_) vkDestroyInstance(instance_, nullptr);
+    if (instance_) vkDestroyInstance(instance_, vkutils::allocator());
 
     if (window_) { glfwDestroyWindow(window_); window_ = nullptr; }
     glfwTerminate();
+
+    recorder_.close();
+    delete saves_;   // czeka na trwający zapis
+    saves_ = nullptr;
+    delete levels_;   // usuwa plik wymiany
+    levels_ = nullptr;
+    delete particles_;
+    particles_ = nullptr;
+    delete logSim_;
+    logSim_ = nullptr;
+    delete jobs_;
+    jobs_ = nullptr;
+}
+
+// --- Szybki zapis / wczytanie (F5 / F9) ---
+SaveSystem& VulkanImGuiApp::saves()
+{
+    // Wątek zapisu startuje dopiero przy pierwszym F5/F9
+    if (!saves_) saves_ = new SaveSystem("savegame.rlsv");
+    return *saves_;
+}
+
+void VulkanImGuiApp::quickSave()
+{
+    AllocScope scope(AllocTag::Save);
+    allocFrame_.exempt = true;
+    // Poprzedni zapis jeszcze trwa - pomijamy zamiast blokować klatkę
+    WorldSnapshot* snapshot = saves().beginSave();
+    if (!snapshot) return;
+    captureWorld(world_, entities, *assets_, *snapshot);
+    saves().commitSave(true);
+    messages_.add(MessageKind::Info, world_.turn, "Game saved.");
+}
+
+void VulkanImGuiApp::quickLoad()
+{
+    AllocScope scope(AllocTag::Save);
+    allocFrame_.exempt = true;
+    saves().waitIdle();
+    WorldSnapshot snapshot;
+    try {
+        if (!loadWorld(saves().path(), snapshot)) return;
+    } catch (const std::exception& e) {
+        logger::error(LogCategory::Save, "Load failed: %s", e.what());
+        return;
+    }
+    vkDeviceWaitIdle(device_);   // encje (i ich sprite'y) mogą być jeszcze w nagranych klatkach
+    restoreWorld(snapshot, world_, entities, assets_, animator_);
+    inspectorBaseEntities_ = SIZE_MAX;   // zapis ma już encje testowe jako zwykłe
+    inspector_.entityCount = SIZE_MAX;   // inne encje pod tymi samymi indeksami - filtr od nowa
+    inspector_.selected = UINT32_MAX;
+    messages_.add(MessageKind::Info, world_.turn, "Game loaded.");
+    redraw_.requestFrames(RedrawScheduler::Simulation, kSettleFrames);
 }
 
 // --- Rysowanie tła i innych obiektów (poza oknami ImGui) ---
 void VulkanImGuiApp::drawWorld()
 {
-    ImDrawList* bg = ImGui::GetBackgroundDrawList();
-
-    //wyswietlanie wszystkich spritow
-    for (Entity* e : entities) {
-        if (!e) continue;
+    // Współrzędne świata = piksele celu o rozdzielczości wewnętrznej (WorldTarget.cpp)
+    beginWorldFrame();
 
-        ImVec2 pos = e->getPosition();
-        uint32_t width = e->getWidth();
-        uint32_t height = e->getHeight();
-        auto& sprite = assets_->sprite(e->getSpriteId());
+    //wyswietlanie wszystkich spritow: widoczne encje posortowane kluczem (warstwa, głębokość,
+    //tekstura), potem paczkami, równolegle na wątkach roboczych
+    WorldTarget& wt = worldTarget_;
+    JobSystem* jobs = parallelWorld_ ? jobs_ : nullptr;
+    const ImVec2 clipMin(0.0f, 0.0f), clipMax(static_cast<float>(wt.width), static_cast<float>(wt.height));
+    LinearArena& arena = frameArenas_.frame();
 
-        bg->AddImage(sprite.imTex, pos, ImVec2(pos.x + width, pos.y + height),
-            ImVec2(0, 0), ImVec2(1, 1), IM_COL32_WHITE);
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t* keys = arena.allocArray<uint64_t>(entities.size());
+    const size_t visible = buildDrawKeys(keys, entities, assets_->sprites(), clipMin, clipMax);
+    radixSort(std::span<uint64_t>(keys, visible), arena, jobs);
+    Entity** sorted = arena.allocArray<Entity*>(visible);
+    uint32_t switches = 0;
+    for (size_t i = 0; i < visible; ++i) {
+        sorted[i] = entities[drawkey::index(keys[i])];
+        switches += i > 0 && drawkey::texture(keys[i]) != drawkey::texture(keys[i - 1]);
     }
+    auto t1 = std::chrono::steady_clock::now();
+    wt.sortMs = smoothMs(wt.sortMs, t0, t1);
+    wt.drawnEntities = static_cast<uint32_t>(visible);
+    wt.textureSwitches = switches;
+
+    wt.batchCount = entityBatchCount(visible);
+    while (wt.batchLists.size() < wt.batchCount) wt.batchLists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+    t0 = std::chrono::steady_clock::now();
+    drawEntityBatches(jobs, std::span<ImDrawList* const>(wt.batchLists.data(), wt.batchCount), clipMin, clipMax,
+        std::span<Entity* const>(sorted, visible), assets_->sprites(), animator_);
+    wt.buildMs = smoothMs(wt.buildMs, t0, std::chrono::steady_clock::now());
+
+    drawParticleLayer();
+    presentWorld();
 }
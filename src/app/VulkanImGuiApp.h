@@ -4,30 +4,71 @@
 #include <imgui.h>
 #include <string>
 #include "Assets.h"
+#include "FrameGraphVulkan.h"
+#include "core/FrameArena.h"
+#include "core/InputRecording.h"
+#include "core/JobSystem.h"
+#include "core/RedrawScheduler.h"
+#include "core/StartupProfile.h"
+#include "game/Animation.h"
+#include "game/ChunkStore.h"
+#include "game/Lighting.h"
+#include "game/Particles.h"
+#include "game/MessageLog.h"
+#include "game/Prefab.h"
+#include "game/SaveGame.h"
+#include "game/Simulation.h"
+#include "game/World.h"
+#include "GameSetup.h"
 
 // Forward declaration to avoid including GLFW in public header
 struct GLFWwindow;
 
+#include <chrono>
 #include <cstdint>
 #include <vector>
 #include <optional>
+#include <span>
+
+// Opcje z linii poleceń (patrz main.cpp)
+struct RunOptions {
+    std::string recordPath;   // --record <plik>: nagrywaj wejście do pliku
+    std::string replayPath;   // --replay <plik>: odtwórz nagranie zamiast wejścia z okna
+    bool realtime = false;    // --realtime: powtórka w tempie nagrania (domyślnie najszybciej jak się da)
+    bool startupReport = false; // --startup-report: czasy faz startu do pierwszej klatki
+    uint64_t seed = 0;        // --seed <n>: ziarno RNG świata (0 = z zegara; powtórka bierze z nagrania)
+    uint32_t maxFrames = 0;   // --frames <n>: zakończ po n klatkach (0 = bez limitu)
+    int allocBudget = -1;     // --alloc-budget <n>: błąd, gdy klatka po rozgrzewce alokuje więcej niż n razy
+    bool idle = true;         // --no-idle: rysuj bez przerwy zamiast czekać na zdarzenia
+};
 
 class VulkanImGuiApp {
 public:
-    int run();
+    int run(const RunOptions& options = {});
     int runSmokeTest();
 
 private:
     struct QueueFamilyIndices {
         std::optional<uint32_t> graphicsFamily;
         std::optional<uint32_t> presentFamily;
+        std::optional<uint32_t> transferFamily;   // opcjonalna, bez VK_QUEUE_GRAPHICS_BIT
         [[nodiscard]] bool isComplete() const { return graphicsFamily.has_value() && presentFamily.has_value(); }
     };
 
+    // Zapytania o wybrane GPU - raz w pickPhysicalDevice, potem tylko odczyt
+    struct DeviceCaps {
+        QueueFamilyIndices queues;
+        VkPhysicalDeviceProperties properties{};
+        VkPhysicalDeviceMemoryProperties memory{};
+        std::vector<VkQueueFamilyProperties> families;
+    };
+
+    // Tylko na czas tworzenia swapchaina - listy w arenie bieżącej klatki
     struct SwapChainSupportDetails {
         VkSurfaceCapabilitiesKHR capabilities{};
-        std::vector<VkSurfaceFormatKHR> formats;
-        std::vector<VkPresentModeKHR> presentModes;
+        ArenaVector<VkSurfaceFormatKHR> formats;
+        ArenaVector<VkPresentModeKHR> presentModes;
+        explicit SwapChainSupportDetails(LinearArena& arena) : formats(arena), presentModes(arena) {}
     };
 
     struct FrameSync {
@@ -48,9 +89,14 @@ private:
     VkSurfaceKHR surface_{};
 
     VkPhysicalDevice physicalDevice_{};
+    DeviceCaps caps_;
     VkDevice device_{};
+    VkPipelineCache pipelineCache_{};   // z/do pipeline.cache - ciepły start bez kompilacji potoków
     VkQueue graphicsQueue_{};
     VkQueue presentQueue_{};
+    VkQueue transferQueue_{};       // == graphicsQueue_, gdy urządzenie nie ma osobnej rodziny
+    uint32_t graphicsFamily_ = 0;
+    uint32_t transferFamily_ = 0;
 
     VkDebugUtilsMessengerEXT debugMessenger_{};
 
@@ -67,17 +113,146 @@ private:
 
     VkDescriptorPool imguiDescriptorPool_{};
 
+    static constexpr uint32_t kFramesInFlight = 2;
     std::vector<FrameSync> frames_;
     uint32_t currentFrame_ = 0;
+    // Dane żyjące jedną klatkę (listy, scratch zadań); reset po fence klatki
+    FrameArenas frameArenas_{ kFramesInFlight, 256 * 1024, 64 * 1024, AllocTag::Render };
 
     Assets* assets_ = nullptr; // lub jako wartość: Assets assets_{...}
+    JobSystem* jobs_ = nullptr; // wspólne wątki robocze (assety, generowanie poziomów, AI)
+    // Cel renderowania świata: stała rozdzielczość wewnętrzna, aktualnie używany fragment
+    // to renderScale_ * (width, height). Zmiana skali nie realokuje obrazu.
+    enum class UpscaleMode { Integer, Fit };
+    struct WorldTarget {
+        uint32_t width = 480;
+        uint32_t height = 270;
+        FrameGraph::ResourceId image = 0;   // obraz przejściowy grafu klatki
+        VkImageView view{};
+        VkRenderPass renderPass{};      // zgodny z potokiem ImGui (ten sam format, 1 próbka)
+        VkFramebuffer framebuffer{};
+        VkSampler nearest{};
+        VkSampler linear{};
+        ImTextureID texNearest{};
+        ImTextureID texLinear{};
+        ImDrawList* drawList = nullptr;
+        std::vector<ImDrawList*> batchLists;   // paczki encji budowane równolegle (WorldDraw.h)
+        uint32_t batchCount = 0;               // paczek w bieżącej klatce
+        float buildMs = 0.0f;                  // średnia krocząca czasu budowania list encji
+        float sortMs = 0.0f;                   // klucze + sortowanie + odrzucanie niewidocznych
+        uint32_t drawnEntities = 0;
+        uint32_t textureSwitches = 0;          // zmiany tekstury między kolejnymi sprite'ami
+        ImDrawList* effectsList = nullptr;     // cząstki, nad encjami (Effects.cpp)
+        uint32_t drawnParticles = 0;
+        float particleMs = 0.0f;               // update cząstek + budowanie ich listy
+        ImDrawData drawData;
+        VkQueryPool timestamps{};       // 2 na klatkę w locie: początek/koniec bufora poleceń
+        float timestampPeriodNs = 0.0f;
+        std::vector<uint8_t> timestampWritten;
+    };
+    WorldTarget worldTarget_;
+    // Graf klatki: pass świata -> pass UI -> prezentacja; bariery i pamięć obrazów przejściowych
+    FrameGraphVulkan frameGraph_;
+    FrameGraph::ResourceId backbuffer_ = 0;
+    uint32_t acquiredImage_ = 0;        // obraz swapchaina nagrywanej klatki (pass UI)
+    std::string frameGraphDump_;        // opis po compile() dla panelu Render
+    UpscaleMode upscaleMode_ = UpscaleMode::Integer;
+    float renderScale_ = 1.0f;
+    bool dynamicScale_ = true;
+    float gpuBudgetMs_ = 8.0f;
+    float gpuMs_ = 0.0f;                // średnia krocząca czasu GPU klatki
+    int scaleCooldown_ = 0;
+    bool parallelWorld_ = true;         // listy świata na wątkach roboczych (panel Render)
+    // Tryb bezczynności: bez zdarzeń, animacji i aktywnego UI pętla śpi zamiast rysować.
+    // Wyłączony w powtórce i przy --frames (tam liczą się kolejne klatki).
+    RedrawScheduler redraw_;
+    bool idleRendering_ = true;
+
+    World world_;
+    DynamicTextureId minimap_ = -1;             // kafel = piksel (Minimap.cpp)
+    uint32_t minimapRevision_ = 0;              // world_.tiles.revision() ostatniej synchronizacji
+    std::vector<uint8_t> minimapTiles_;         // kafle z ostatniej synchronizacji (diff zamiast pełnego skanu)
+    bool minimapLit_ = false;                   // czy minimap_ ma kolory z mapą światła
+    LightMap lights_;                           // pochodnie piętra (Lights.cpp)
+    std::vector<LightMap::LightId> torches_;
+    uint32_t lightsLevel_ = UINT32_MAX;         // piętro, dla którego rozstawiono pochodnie
+    DynamicTextureId lightmap_ = -1;            // lights_.pixels() na GPU, kafel = teksel
+    uint8_t lightAmbient_ = 24;
+    bool litMinimap_ = true;
+    float lightingMs_ = 0.0f;
+
+    // Dziennik i inspektor encji - wirtualizowane listy (LogPanel.cpp, Inspector.cpp)
+    MessageLog messages_;
+    Simulation* logSim_ = nullptr;              // gra w tle zasilająca dziennik („Simulate”)
+    uint64_t logSimSeed_ = 1;
+    bool logSimRunning_ = false;
+    bool logAutoScroll_ = true;
+    uint64_t logSeenTotal_ = 0;
+    float logPanelMs_ = 0.0f;
+    struct InspectorView {
+        char filter[64] = "";
+        std::string applied;                    // filtr bieżącego skanu
+        std::vector<uint8_t> spriteMatch;       // SpriteId -> pasuje do filtra
+        std::vector<uint32_t> rows;             // indeksy do entities: przefiltrowane, potem posortowane
+        std::vector<uint32_t> source;           // przy zawężaniu: poprzednie rows
+        bool narrowing = false;
+        size_t sourceSize = 0;                  // ile skanować (source albo wszystkie encje)
+        size_t scanned = 0;
+        size_t entityCount = 0;                 // entities.size() przy starcie skanu
+        bool sorted = false;
+        int sortColumn = 0;
+        bool sortDescending = false;
+        uint32_t selected = UINT32_MAX;
+        float buildMs = 0.0f;
+    };
+    InspectorView inspector_;
+    size_t inspectorBaseEntities_ = SIZE_MAX;   // liczba encji przed „Spawn 100k”
+    ChunkStore* levels_ = nullptr;              // opuszczone piętra (Dungeon.cpp); tworzony przy pierwszej zmianie piętra
+    uint32_t level_ = 0;                        // piętro w world_.tiles
+    ParticleSystem* particles_ = nullptr;       // efekty (Effects.cpp); tworzony przy pierwszym wybuchu
+    Rng effectsRng_;                            // miejsca wybuchów; osobno, żeby nie ruszać world_.rng
+    AnimationLibrary animations_;               // assets/animations.txt
+    Animator animator_{ animations_ };          // stan klatek wszystkich encji, tyka raz na klatkę
+    PrefabTable prefabTable_;                   // <build>/assets/prefabs.rlpf (albo prefabs.txt skompilowany przy starcie)
+    std::vector<PrefabInstance> prefabs_;       // prefabTable_ z rozwiązanymi sprite'ami i klipami
+    RunOptions options_;
+    InputRecorder recorder_;
+    InputReplay replay_;
+    bool replaying_ = false;
+    std::chrono::steady_clock::time_point replayStart_{};
+    double replayTime_ = 0.0;   // suma dt z nagrania (tempo --realtime)
+    SaveSystem* saves_ = nullptr; // zapis w tle: F5 szybki zapis (przyrostowy), F9 wczytanie; tworzony przy pierwszym użyciu
+
+    // Start (Startup.cpp)
+    StartupProfile startupProfile_;
+    std::vector<DecodedImage> preloaded_;   // sprite'y zdekodowane na wątkach w trakcie tworzenia urządzenia
+    bool firstFramePresented_ = false;
+
+    // Alokacje wątku głównego na klatkę (MemoryTracking.cpp)
+    struct AllocFrameStats {
+        static constexpr int kHistory = 120;
+        uint64_t lastAllocs = 0;
+        uint64_t lastBytes = 0;
+        uint64_t markAllocs = 0;
+        uint64_t markBytes = 0;
+        uint64_t worstAllocs = 0;     // po rozgrzewce
+        uint32_t frames = 0;
+        uint32_t overBudget = 0;
+        bool exempt = false;          // klatka z przebudową swapchaina albo zapisem - poza budżetem
+        float history[kHistory] = {};
+        int historyPos = 0;
+    };
+    AllocFrameStats allocFrame_;
 
 private:
     // High-level steps
+    void startup();
     void initWindow();
     void initVulkan();
     void initImGui();
     void mainLoop();
+    void waitForRedraw();
+    void scheduleRedraw();
     void cleanup();
 
     // Vulkan helpers
@@ -95,18 +270,77 @@ private:
     void cleanupSwapchain();
     void recreateSwapchain();
     void recordCommandBuffer(VkCommandBuffer cmd, uint32_t imageIndex);
+    void recordUiPass(VkCommandBuffer cmd);
     void reinitImGuiRenderer();
 
     // Rysowanie świata
     void drawWorld();
 
+    // Nagrywanie / powtórka wejścia (InputCapture.cpp)
+    void initInputCapture();
+    void beginInputFrame();
+
+    // Świat w niskiej rozdzielczości + skalowanie do swapchaina (WorldTarget.cpp)
+    void createWorldTarget();
+    void destroyWorldTarget();
+    ImDrawList* beginWorldFrame();
+    void presentWorld();
+    void recordWorldPass(VkCommandBuffer cmd);
+    void readGpuTimings();
+    void updateRenderScale();
+    void drawRenderPanel();
+
+    // Liczniki pamięci (MemoryTracking.cpp)
+    void initAllocTracking();
+    void tickAllocFrame();
+    bool allocBudgetPassed() const;
+    void drawMemoryPanel();
+
+    // Minimapa na teksturze dynamicznej (Minimap.cpp)
+    void drawMinimapPanel();
+
+    // Oświetlenie kafli (Lights.cpp); przed minimapą, która bierze z niego kolory
+    void placeTorches();
+    void moveTorches();
+    void updateLighting();
+    void drawLightingPanel();
+
+    // Dziennik wiadomości (LogPanel.cpp) i inspektor encji (Inspector.cpp)
+    void stepLogSimulation(uint32_t actions);
+    void drawLogPanel();
+    void restartInspectorScan();
+    void scanInspector();
+    void sortInspector();
+    void spawnStressEntities();
+    void removeStressEntities();
+    void drawInspectorPanel();
+
+    // Piętra w magazynie chunków (Dungeon.cpp)
+    void drawDungeonPanel();
+    void changeLevel(int delta);
+
+    // Cząstki: update i lista nad encjami, panel Effects (Effects.cpp)
+    void updateParticles(float dt);
+    void drawParticleLayer();
+    void drawEffectsPanel();
+    void emitParticles(const ParticleBurst& burst, uint32_t count);
+
+    // Start: cache potoków, raport
+    void createPipelineCache();
+    void destroyPipelineCache();
+    void onFramePresented();
+
+    // Zapis gry
+    SaveSystem& saves();
+    void quickSave();
+    void quickLoad();
+
     // --- Helpery Vulkan używane przy ładowaniu tekstur ---
     uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
     VkCommandBuffer beginSingleTimeCommands();
     void endSingleTimeCommands(VkCommandBuffer cmd);
     void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
                       VkBuffer& buffer, VkDeviceMemory& bufferMemory);
-    void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout);
     void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
     VkImageView createImageView(VkImage image, VkFormat format);
 
@@ -115,9 +349,9 @@ private:
     static bool checkValidationLayerSupport(const std::vector<const char*>& layers);
     static QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface);
     static bool isDeviceSuitable(VkPhysicalDevice device, VkSurfaceKHR surface);
-    static SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface);
-    static VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& formats);
-    static VkPresentModeKHR choosePresentMode(const std::vector<VkPresentModeKHR>& modes);
+    static SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface, LinearArena& arena);
+    static VkSurfaceFormatKHR chooseSwapSurfaceFormat(std::span<const VkSurfaceFormatKHR> formats);
+    static VkPresentModeKHR choosePresentMode(std::span<const VkPresentModeKHR> modes, bool uncapped);
     static VkExtent2D chooseExtent(const VkSurfaceCapabilitiesKHR& caps, GLFWwindow* window);
     static bool wantValidationLayers();
 };
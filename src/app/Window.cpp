@@ -1,10 +1,10 @@
 #include "VulkanImGuiApp.h"
+#include "core/Log.h"
 #include <GLFW/glfw3.h>
 #include <stdexcept>
-#include <iostream>
 
 static void glfwErrorCallback(int error, const char* description) {
-    std::cerr << "[GLFW] Error " << error << ": " << description << std::endl;
+    logger::error(LogCategory::Window, "%d: %s", error, description);
 }
 
 void VulkanImGuiApp::initWindow()
@@ -14,6 +14,8 @@ void VulkanImGuiApp::initWindow()
     if (!glfwVulkanSupported()) throw std::runtime_error("GLFW reports Vulkan not supported");
 
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+    // Powtórka na czas działa bez widocznego okna (i bez wejścia z systemu)
+    glfwWindowHint(GLFW_VISIBLE, (replaying_ && !options_.realtime) ? GLFW_FALSE : GLFW_TRUE);
     window_ = glfwCreateWindow(1280, 720, "RogueLikeGame", nullptr, nullptr);
     if (!window_) throw std::runtime_error("Failed to create GLFW window");
 }
@@ -0,0 +1,123 @@
+#include "WorldDraw.h"
+#include "Assets.h"
+#include "Game.h"
+#include "core/JobSystem.h"
+#include "game/Animation.h"
+#include "game/Particles.h"
+#include <imgui.h>
+#include <algorithm>
+#include <stdexcept>
+
+void drawEntities(ImDrawList* dl, std::span<Entity* const> entities, std::span<const SpriteGPU> sprites, const Animator& animator)
+{
+    const AnimationLibrary& library = animator.library();
+    for (Entity* e : entities) {
+        if (!e) continue;
+
+        ImVec2 pos = e->getPosition();
+        uint32_t width = e->getWidth();
+        uint32_t height = e->getHeight();
+        const SpriteGPU& sprite = sprites[e->getSpriteId()];
+        if (!sprite.ready) continue;   // tekstura jeszcze w drodze
+
+        // Klatka animacji to tylko inny prostokąt UV tej samej tekstury - bez zmiany
+        // deskryptora, więc ImGui składa sąsiednie sprite'y z arkusza w jedno wywołanie rysowania
+        ImVec2 uv0(0, 0), uv1(1, 1);
+        if (e->getAnimation() != UINT32_MAX) {
+            const SpriteSheet& sheet = library.sheets()[library.clip(animator.clip(e->getAnimation())).sheet];
+            const FrameRect r = frameRect(sheet, animator.frame(e->getAnimation()), sprite.width, sprite.height);
+            uv0 = ImVec2(r.u0, r.v0);
+            uv1 = ImVec2(r.u1, r.v1);
+        }
+        dl->AddImage(sprite.imTex, pos, ImVec2(pos.x + width, pos.y + height), uv0, uv1, IM_COL32_WHITE);
+    }
+}
+
+size_t buildDrawKeys(uint64_t* out, std::span<Entity* const> entities, std::span<const SpriteGPU> sprites,
+    const ImVec2& clipMin, const ImVec2& clipMax)
+{
+    if (entities.size() > drawkey::kIndexMask + 1) throw std::runtime_error("Too many entities for draw keys");
+    constexpr float kMaxDepth = float((1u << drawkey::kDepthBits) - 1);
+    size_t count = 0;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        const Entity* e = entities[i];
+        if (!e) continue;
+        const int spriteId = e->getSpriteId();
+        if (!sprites[spriteId].ready) continue;
+        const ImVec2 pos = e->getPosition();
+        const float bottom = pos.y + static_cast<float>(e->getHeight());
+        if (pos.x + static_cast<float>(e->getWidth()) <= clipMin.x || pos.x >= clipMax.x || bottom <= clipMin.y || pos.y >= clipMax.y)
+            continue;
+
+        const uint32_t layer = e->getLayer();
+        const uint32_t depth = layer == static_cast<uint32_t>(DrawLayer::Ground)
+            ? 0u : static_cast<uint32_t>(std::min((bottom - clipMin.y) * drawkey::kDepthScale, kMaxDepth));
+        out[count++] = drawkey::make(layer, depth, static_cast<uint32_t>(spriteId) & 0xFFFF, static_cast<uint32_t>(i));
+    }
+    return count;
+}
+
+void drawEntityBatches(JobSystem* jobs, std::span<ImDrawList* const> lists, const ImVec2& clipMin, const ImVec2& clipMax,
+    std::span<Entity* const> entities, std::span<const SpriteGPU> sprites, const Animator& animator)
+{
+    const uint32_t batches = entityBatchCount(entities.size());
+    // Wszystkie alokacje list tutaj: wątki robocze tylko dopisują do zarezerwowanych buforów
+    // (alokator ImGui aktualizuje liczniki kontekstu, który nie jest wielowątkowy)
+    for (uint32_t b = 0; b < batches; ++b) {
+        ImDrawList* dl = lists[b];
+        const int count = static_cast<int>(std::min<size_t>(kEntityBatch, entities.size() - size_t(b) * kEntityBatch));
+        dl->_ResetForNewFrame();
+        dl->PushClipRect(clipMin, clipMax);
+        dl->PushTextureID(ImTextureID{});   // stos tekstur rośnie przy pierwszej zmianie tekstury
+        dl->PopTextureID();
+        dl->VtxBuffer.reserve(count * 4);
+        dl->IdxBuffer.reserve(count * 6);
+        dl->CmdBuffer.reserve(dl->CmdBuffer.Size + count + 1);
+    }
+
+    auto build = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t b = begin; b < end; ++b) {
+            const size_t first = size_t(b) * kEntityBatch;
+            drawEntities(lists[b], entities.subspan(first, std::min<size_t>(kEntityBatch, entities.size() - first)), sprites, animator);
+        }
+    };
+    if (jobs) jobs->parallelFor(0, batches, 1, build);
+    else build(0, batches);
+}
+
+uint32_t drawParticles(ImDrawList* dl, const ParticleSystem& particles, uint32_t maxQuads)
+{
+    // Rezerwacja kawałkami: PrimReserve przesuwa VtxOffset, gdy 16-bitowe indeksy się kończą
+    constexpr uint32_t kChunk = 8192;
+    const ImVec2 uv = ImGui::GetFontTexUvWhitePixel();
+    uint32_t drawn = 0;
+    for (uint32_t b = 0; b < particles.blockCount() && drawn < maxQuads; ++b) {
+        const ParticleSystem::Block block = particles.block(b);
+        for (uint32_t first = 0; first < block.count && drawn < maxQuads;) {
+            const uint32_t n = std::min({ kChunk, block.count - first, maxQuads - drawn });
+            dl->PrimReserve(static_cast<int>(n * 6), static_cast<int>(n * 4));
+            ImDrawVert* vtx = dl->_VtxWritePtr;
+            ImDrawIdx* idx = dl->_IdxWritePtr;
+            ImDrawIdx base = static_cast<ImDrawIdx>(dl->_VtxCurrentIdx);
+            for (uint32_t i = first; i < first + n; ++i) {
+                const float x = block.x[i], y = block.y[i], s = block.size[i];
+                const ImU32 col = block.color[i];
+                vtx[0] = { ImVec2(x - s, y - s), uv, col };
+                vtx[1] = { ImVec2(x + s, y - s), uv, col };
+                vtx[2] = { ImVec2(x + s, y + s), uv, col };
+                vtx[3] = { ImVec2(x - s, y + s), uv, col };
+                idx[0] = base; idx[1] = static_cast<ImDrawIdx>(base + 1); idx[2] = static_cast<ImDrawIdx>(base + 2);
+                idx[3] = base; idx[4] = static_cast<ImDrawIdx>(base + 2); idx[5] = static_cast<ImDrawIdx>(base + 3);
+                vtx += 4;
+                idx += 6;
+                base = static_cast<ImDrawIdx>(base + 4);
+            }
+            dl->_VtxWritePtr = vtx;
+            dl->_IdxWritePtr = idx;
+            dl->_VtxCurrentIdx += n * 4;
+            first += n;
+            drawn += n;
+        }
+    }
+    return drawn;
+}
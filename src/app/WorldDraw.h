@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+class Entity;
+class Animator;
+class JobSystem;
+class ParticleSystem;
+struct SpriteGPU;
+struct ImDrawList;
+struct ImVec2;
+
+// Sprite'y encji na liście świata. Wydzielone z drawWorld, żeby roguelike_bench mierzył
+// dokładnie ten sam kod budowania listy (bez okna i urządzenia).
+void drawEntities(ImDrawList* dl, std::span<Entity* const> entities, std::span<const SpriteGPU> sprites, const Animator& animator);
+
+// Warstwy rysowania (Entity::getLayer), od spodu. Na warstwie podłoża nic na siebie nie
+// zachodzi, więc klucz pomija głębokość i grupuje tylko po teksturze.
+enum class DrawLayer : uint8_t { Ground, Actors, Overhead };
+
+// Klucz sortowania: warstwa | głębokość (dół sprite'a) | tekstura | indeks encji.
+// Rosnąco daje kolejność malarza, a przy równej głębokości sąsiadują sprite'y jednej tekstury.
+namespace drawkey {
+constexpr uint32_t kIndexBits = 24;
+constexpr uint32_t kTextureBits = 16;
+constexpr uint32_t kDepthBits = 16;
+constexpr uint64_t kIndexMask = (uint64_t(1) << kIndexBits) - 1;
+constexpr float kDepthScale = 32.0f;   // 1/32 piksela, zakres 2048 pikseli od górnej krawędzi
+
+constexpr uint64_t make(uint32_t layer, uint32_t depth, uint32_t texture, uint32_t index)
+{
+    return uint64_t(layer) << (kIndexBits + kTextureBits + kDepthBits) | uint64_t(depth) << (kIndexBits + kTextureBits)
+        | uint64_t(texture) << kIndexBits | index;
+}
+constexpr uint32_t texture(uint64_t key) { return static_cast<uint32_t>(key >> kIndexBits) & ((1u << kTextureBits) - 1); }
+constexpr uint32_t index(uint64_t key) { return static_cast<uint32_t>(key & kIndexMask); }
+} // namespace drawkey
+
+// Klucze widocznych encji (prostokąt przecina clip, tekstura gotowa) do out; zwraca ich liczbę.
+// out musi pomieścić entities.size() kluczy.
+size_t buildDrawKeys(uint64_t* out, std::span<Entity* const> entities, std::span<const SpriteGPU> sprites,
+    const ImVec2& clipMin, const ImVec2& clipMax);
+
+// Encje w stałych paczkach, każda na własnej liście (lists[i] = paczka i). Podział nie zależy
+// od liczby wątków, więc kolejność rysowania po złożeniu list jest zawsze ta sama; paczka
+// mieści się też w 16-bitowych indeksach ImGui.
+constexpr uint32_t kEntityBatch = 2048;
+constexpr uint32_t entityBatchCount(size_t entities) { return static_cast<uint32_t>((entities + kEntityBatch - 1) / kEntityBatch); }
+
+// Listy resetuje i rezerwuje wątek wywołujący, paczki buduje jobs (nullptr: po kolei).
+// Na końcu listy mają otwarty clip rect (clipMin, clipMax) - zamyka go wywołujący.
+void drawEntityBatches(JobSystem* jobs, std::span<ImDrawList* const> lists, const ImVec2& clipMin, const ImVec2& clipMax,
+    std::span<Entity* const> entities, std::span<const SpriteGPU> sprites, const Animator& animator);
+
+// Cząstki jako jednokolorowe kwadraty (biały piksel atlasu czcionek, bez zmiany tekstury),
+// wierzchołki pisane wprost do bufora listy. Rysuje najwyżej maxQuads; zwraca, ile narysował.
+uint32_t drawParticles(ImDrawList* dl, const ParticleSystem& particles, uint32_t maxQuads);
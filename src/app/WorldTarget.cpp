@@ -0,0 +1,240 @@
+#include "VulkanImGuiApp.h"
+#include <imgui.h>
+#include <imgui_impl_vulkan.h>
+#include <vk_utils.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Świat (sprite'y, kafle) rysujemy do obrazu w niskiej rozdzielczości tym samym rendererem ImGui
+// - potok ImGui pasuje do każdego render passa o tym samym formacie i liczbie próbek.
+// Potem obraz trafia na tło ImGui przeskalowany o całkowitą wielokrotność (nearest)
+// albo dopasowany do okna (linear), a UI rysuje się nad nim w natywnej rozdzielczości.
+
+namespace {
+constexpr float kMinRenderScale = 0.5f;
+constexpr float kScaleStep = 0.125f;
+constexpr int kScaleCooldownFrames = 30;
+
+VkSampler createSampler(VkDevice device, VkFilter filter)
+{
+    VkSamplerCreateInfo sci{ VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
+    sci.magFilter = filter;
+    sci.minFilter = filter;
+    sci.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    sci.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sci.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sci.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sci.maxAnisotropy = 1.0f;
+    VkSampler sampler{};
+    vkutils::checkVk(vkCreateSampler(device, &sci, vkutils::allocator(), &sampler), "vkCreateSampler failed");
+    return sampler;
+}
+}
+
+void VulkanImGuiApp::createWorldTarget()
+{
+    WorldTarget& wt = worldTarget_;
+
+    // Graf klatki. Obraz świata jest przejściowy - pamięć i przejścia układów daje graf;
+    // obraz swapchaina przychodzi z acquire i wraca do prezentacji.
+    FrameGraph& graph = frameGraph_.graph();
+    wt.image = graph.createImage("world", { wt.width, wt.height, static_cast<uint32_t>(swapchainImageFormat_) });
+    backbuffer_ = graph.importImage("backbuffer", GpuAccess::Present, GpuAccess::Present);
+    const FrameGraph::PassId worldPass = frameGraph_.addPass("world", [this](VkCommandBuffer cmd) { recordWorldPass(cmd); });
+    graph.write(worldPass, wt.image, GpuAccess::ColorAttachmentWrite);
+    const FrameGraph::PassId uiPass = frameGraph_.addPass("ui", [this](VkCommandBuffer cmd) { recordUiPass(cmd); });
+    graph.read(uiPass, wt.image, GpuAccess::ShaderRead);
+    graph.write(uiPass, backbuffer_, GpuAccess::ColorAttachmentWrite);
+    frameGraph_.compile(device_, caps_.memory);
+    frameGraphDump_ = graph.describe();
+    wt.view = frameGraph_.view(wt.image);
+
+    wt.renderPass = createColorRenderPass(device_, swapchainImageFormat_);
+
+    VkFramebufferCreateInfo fbci{ VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO };
+    fbci.renderPass = wt.renderPass;
+    fbci.attachmentCount = 1;
+    fbci.pAttachments = &wt.view;
+    fbci.width = wt.width;
+    fbci.height = wt.height;
+    fbci.layers = 1;
+    vkutils::checkVk(vkCreateFramebuffer(device_, &fbci, vkutils::allocator(), &wt.framebuffer), "vkCreateFramebuffer (world) failed");
+
+    wt.nearest = createSampler(device_, VK_FILTER_NEAREST);
+    wt.linear = createSampler(device_, VK_FILTER_LINEAR);
+    wt.texNearest = (ImTextureID)(uintptr_t)ImGui_ImplVulkan_AddTexture(wt.nearest, wt.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    wt.texLinear = (ImTextureID)(uintptr_t)ImGui_ImplVulkan_AddTexture(wt.linear, wt.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    if (!wt.drawList) wt.drawList = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+    if (!wt.effectsList) wt.effectsList = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+
+    // Znaczniki czasu GPU dla regulatora skali (jeśli kolejka je wspiera)
+    if (graphicsFamily_ < caps_.families.size() && caps_.families[graphicsFamily_].timestampValidBits > 0) {
+        VkQueryPoolCreateInfo qci{ VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+        qci.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        qci.queryCount = static_cast<uint32_t>(frames_.size()) * 2;
+        vkutils::checkVk(vkCreateQueryPool(device_, &qci, vkutils::allocator(), &wt.timestamps), "vkCreateQueryPool failed");
+        wt.timestampPeriodNs = caps_.properties.limits.timestampPeriod;
+        wt.timestampWritten.assign(frames_.size(), 0);
+    }
+}
+
+void VulkanImGuiApp::destroyWorldTarget()
+{
+    WorldTarget& wt = worldTarget_;
+    if (wt.texNearest) ImGui_ImplVulkan_RemoveTexture((VkDescriptorSet)(uintptr_t)wt.texNearest);
+    if (wt.texLinear) ImGui_ImplVulkan_RemoveTexture((VkDescriptorSet)(uintptr_t)wt.texLinear);
+    if (wt.timestamps) vkDestroyQueryPool(device_, wt.timestamps, vkutils::allocator());
+    if (wt.nearest) vkDestroySampler(device_, wt.nearest, vkutils::allocator());
+    if (wt.linear) vkDestroySampler(device_, wt.linear, vkutils::allocator());
+    if (wt.framebuffer) vkDestroyFramebuffer(device_, wt.framebuffer, vkutils::allocator());
+    if (wt.renderPass) vkDestroyRenderPass(device_, wt.renderPass, vkutils::allocator());
+    frameGraph_.destroy(device_);
+
+    ImDrawList* drawList = wt.drawList;
+    std::vector<ImDrawList*> batchLists = std::move(wt.batchLists);
+    ImDrawList* effectsList = wt.effectsList;
+    const uint32_t width = wt.width, height = wt.height;
+    wt = WorldTarget{};
+    wt.drawList = drawList;   // listy rysowania żyją tyle co kontekst ImGui (zwalnia cleanup)
+    wt.batchLists = std::move(batchLists);
+    wt.effectsList = effectsList;
+    wt.width = width;
+    wt.height = height;
+}
+
+// Lista rysowania świata w jednostkach rozdzielczości wewnętrznej
+ImDrawList* VulkanImGuiApp::beginWorldFrame()
+{
+    WorldTarget& wt = worldTarget_;
+    wt.drawList->_ResetForNewFrame();
+    wt.drawList->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(static_cast<float>(wt.width), static_cast<float>(wt.height)));
+    wt.effectsList->_ResetForNewFrame();
+    wt.effectsList->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(static_cast<float>(wt.width), static_cast<float>(wt.height)));
+    return wt.drawList;
+}
+
+// Zamyka listę świata i kładzie przeskalowany obraz na tło ImGui
+void VulkanImGuiApp::presentWorld()
+{
+    WorldTarget& wt = worldTarget_;
+    wt.drawList->PopClipRect();
+    for (uint32_t b = 0; b < wt.batchCount; ++b) wt.batchLists[b]->PopClipRect();
+    wt.effectsList->PopClipRect();
+
+    // FramebufferScale przeskalowuje wierzchołki i nożyce - świat trafia do lewego górnego
+    // fragmentu obrazu o rozmiarze renderScale_ * rozdzielczość wewnętrzna
+    wt.drawData.Clear();
+    wt.drawData.Valid = true;
+    wt.drawData.DisplayPos = ImVec2(0.0f, 0.0f);
+    wt.drawData.DisplaySize = ImVec2(static_cast<float>(wt.width), static_cast<float>(wt.height));
+    wt.drawData.FramebufferScale = ImVec2(renderScale_, renderScale_);
+    wt.drawData.AddDrawList(wt.drawList);
+    for (uint32_t b = 0; b < wt.batchCount; ++b) wt.drawData.AddDrawList(wt.batchLists[b]);   // kolejność paczek = kolejność encji
+    if (wt.drawnParticles) wt.drawData.AddDrawList(wt.effectsList);
+
+    const ImVec2 display = ImGui::GetIO().DisplaySize;
+    const float srcW = static_cast<float>(wt.width);
+    const float srcH = static_cast<float>(wt.height);
+    float scale = std::min(display.x / srcW, display.y / srcH);
+    if (upscaleMode_ == UpscaleMode::Integer) scale = std::max(1.0f, std::floor(scale));
+    const ImVec2 size(srcW * scale, srcH * scale);
+    const ImVec2 origin(std::floor((display.x - size.x) * 0.5f), std::floor((display.y - size.y) * 0.5f));
+
+    const ImVec2 uvMax(renderScale_, renderScale_);
+    // Przy skali < 1 obraz i tak jest rozciągany o ułamek - wtedy linear wygląda lepiej niż nearest
+    const bool nearest = upscaleMode_ == UpscaleMode::Integer && renderScale_ >= 1.0f;
+    ImGui::GetBackgroundDrawList()->AddImage(nearest ? wt.texNearest : wt.texLinear,
+        origin, ImVec2(origin.x + size.x, origin.y + size.y), ImVec2(0.0f, 0.0f), uvMax, IM_COL32_WHITE);
+}
+
+void VulkanImGuiApp::recordWorldPass(VkCommandBuffer cmd)
+{
+    WorldTarget& wt = worldTarget_;
+    VkClearValue clear{}; clear.color = { { 0.10f, 0.15f, 0.20f, 1.0f } };
+
+    VkRenderPassBeginInfo rpbi{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
+    rpbi.renderPass = wt.renderPass;
+    rpbi.framebuffer = wt.framebuffer;
+    rpbi.renderArea.offset = { 0, 0 };
+    rpbi.renderArea.extent = { wt.width, wt.height };
+    rpbi.clearValueCount = 1;
+    rpbi.pClearValues = &clear;
+
+    vkCmdBeginRenderPass(cmd, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
+    if (wt.drawData.Valid && wt.drawData.TotalVtxCount > 0)
+        ImGui_ImplVulkan_RenderDrawData(&wt.drawData, cmd);
+    vkCmdEndRenderPass(cmd);
+}
+
+// Po czekaniu na fence klatki: wyniki jej znaczników czasu są już dostępne
+void VulkanImGuiApp::readGpuTimings()
+{
+    WorldTarget& wt = worldTarget_;
+    if (!wt.timestamps || !wt.timestampWritten[currentFrame_]) return;
+
+    uint64_t ticks[2]{};
+    const VkResult r = vkGetQueryPoolResults(device_, wt.timestamps, currentFrame_ * 2, 2, sizeof(ticks), ticks,
+        sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if (r != VK_SUCCESS || ticks[1] < ticks[0]) return;
+
+    const float ms = static_cast<float>(static_cast<double>(ticks[1] - ticks[0]) * wt.timestampPeriodNs * 1e-6);
+    gpuMs_ = gpuMs_ > 0.0f ? gpuMs_ * 0.9f + ms * 0.1f : ms;
+}
+
+// Regulator: po przekroczeniu budżetu zmniejsza skalę krokami, po odzyskaniu zapasu zwiększa.
+// Odstęp między zmianami, żeby nie oscylować.
+void VulkanImGuiApp::updateRenderScale()
+{
+    if (!dynamicScale_ || !worldTarget_.timestamps || gpuMs_ <= 0.0f) return;
+    if (scaleCooldown_ > 0) { --scaleCooldown_; return; }
+
+    if (gpuMs_ > gpuBudgetMs_ && renderScale_ > kMinRenderScale) {
+        renderScale_ = std::max(kMinRenderScale, renderScale_ - kScaleStep);
+        scaleCooldown_ = kScaleCooldownFrames;
+    } else if (gpuMs_ < gpuBudgetMs_ * 0.7f && renderScale_ < 1.0f) {
+        renderScale_ = std::min(1.0f, renderScale_ + kScaleStep);
+        scaleCooldown_ = kScaleCooldownFrames;
+    }
+}
+
+void VulkanImGuiApp::drawRenderPanel()
+{
+    ImGui::Begin("Render");
+    ImGui::Text("World: %ux%u, scale %.3f (%ux%u)", worldTarget_.width, worldTarget_.height, renderScale_,
+        static_cast<uint32_t>(worldTarget_.width * renderScale_), static_cast<uint32_t>(worldTarget_.height * renderScale_));
+    ImGui::Text("World lists: %.3f ms, %u batches, %u threads", worldTarget_.buildMs, worldTarget_.batchCount,
+        parallelWorld_ && jobs_ ? jobs_->workerCount() + 1 : 1u);
+    ImGui::Text("Draw sort: %.3f ms, %u visible, %u texture switches", worldTarget_.sortMs, worldTarget_.drawnEntities,
+        worldTarget_.textureSwitches);
+    ImGui::Checkbox("Parallel world build", &parallelWorld_);
+    ImGui::Checkbox("Idle rendering", &idleRendering_);
+    ImGui::SameLine();
+    ImGui::Text("%llu frames, %llu waits", static_cast<unsigned long long>(redraw_.framesRendered()),
+        static_cast<unsigned long long>(redraw_.waits()));
+    ImGui::TextUnformatted("Frame reason:");
+    for (uint32_t bit = 0; bit < RedrawScheduler::ReasonCount; ++bit) {
+        if (!(redraw_.frameReasons() & (1u << bit))) continue;
+        ImGui::SameLine();
+        ImGui::TextUnformatted(RedrawScheduler::reasonName(bit));
+    }
+    if (worldTarget_.timestamps) ImGui::Text("GPU: %.2f ms", gpuMs_);
+    else ImGui::TextUnformatted("GPU: brak znaczników czasu");
+
+    int mode = static_cast<int>(upscaleMode_);
+    ImGui::RadioButton("Integer", &mode, 0); ImGui::SameLine();
+    ImGui::RadioButton("Fit", &mode, 1);
+    upscaleMode_ = static_cast<UpscaleMode>(mode);
+
+    ImGui::Checkbox("Dynamic scale", &dynamicScale_);
+    ImGui::SliderFloat("GPU budget (ms)", &gpuBudgetMs_, 1.0f, 33.0f, "%.1f");
+    if (!dynamicScale_) ImGui::SliderFloat("Scale", &renderScale_, kMinRenderScale, 1.0f, "%.3f");
+
+    if (ImGui::CollapsingHeader("Frame graph")) {
+        ImGui::Text("Transient memory: %.1f KiB (%.1f KiB without aliasing)",
+            frameGraph_.memoryBytes() / 1024.0, frameGraph_.unaliasedBytes() / 1024.0);
+        ImGui::TextUnformatted(frameGraphDump_.c_str());
+    }
+    ImGui::End();
+}
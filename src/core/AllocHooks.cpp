@@ -0,0 +1,51 @@
+// Globalne operator new/delete przez alloctrack. Podmiana działa na cały program, więc ten plik
+// jest tylko w celu RogueLikeGame (benchmarki mierzą bez narzutu liczników).
+#include "AllocTracker.h"
+#include <new>
+
+namespace {
+const bool g_registered = (alloctrack::markHooksInstalled(), true);
+
+void* allocOrThrow(std::size_t size, std::size_t alignment)
+{
+    for (;;) {
+        if (void* p = alloctrack::allocate(size ? size : 1, alignment, alloctrack::currentTag()))
+            return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* allocNoThrow(std::size_t size, std::size_t alignment) noexcept
+{
+    try {
+        return allocOrThrow(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+}
+
+void* operator new(std::size_t size) { return allocOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size) { return allocOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t al) { return allocOrThrow(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return allocOrThrow(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocNoThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocNoThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return allocNoThrow(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return allocNoThrow(size, static_cast<std::size_t>(al)); }
+
+// Nagłówek bloku zna rozmiar i wyrównanie - wszystkie warianty delete są tym samym
+void operator delete(void* p) noexcept { alloctrack::release(p); }
+void operator delete[](void* p) noexcept { alloctrack::release(p); }
+void operator delete(void* p, std::size_t) noexcept { alloctrack::release(p); }
+void operator delete[](void* p, std::size_t) noexcept { alloctrack::release(p); }
+void operator delete(void* p, std::align_val_t) noexcept { alloctrack::release(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alloctrack::release(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alloctrack::release(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alloctrack::release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { alloctrack::release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { alloctrack::release(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { alloctrack::release(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { alloctrack::release(p); }
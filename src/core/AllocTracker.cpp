@@ -0,0 +1,166 @@
+#include "AllocTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+
+namespace {
+
+struct BlockHeader {
+    uint64_t size;
+    uint32_t offset;    // od początku bloku z malloc do danych
+    uint8_t tag;
+    uint8_t overAligned;
+    uint16_t reserved;
+};
+static_assert(sizeof(BlockHeader) == 16, "BlockHeader must keep 16-byte alignment of user data");
+
+// Kubełki w osobnych liniach cache - wątki alokujące w różnych kategoriach się nie przepychają
+struct alignas(64) Bucket {
+    std::atomic<uint64_t> allocs{ 0 };
+    std::atomic<uint64_t> frees{ 0 };
+    std::atomic<uint64_t> bytesAllocated{ 0 };
+    std::atomic<uint64_t> bytesFreed{ 0 };
+};
+
+// Stała inicjalizacja: operator new bywa wołany przed dynamiczną inicjalizacją globali
+Bucket g_buckets[static_cast<size_t>(AllocTag::Count)];
+std::atomic<uint64_t> g_live{ 0 };
+std::atomic<uint64_t> g_peak{ 0 };
+bool g_hooks = false;
+
+thread_local AllocTag t_tag = AllocTag::General;
+thread_local uint64_t t_allocs = 0;
+thread_local uint64_t t_bytes = 0;
+
+BlockHeader* headerOf(const void* ptr)
+{
+    return const_cast<BlockHeader*>(static_cast<const BlockHeader*>(ptr) - 1);
+}
+
+const char* const kTagNames[] = {
+    "General", "Game", "Assets", "Render", "Save", "ImGui",
+    "Vk command", "Vk object", "Vk cache", "Vk device", "Vk instance",
+};
+static_assert(sizeof(kTagNames) / sizeof(kTagNames[0]) == static_cast<size_t>(AllocTag::Count), "kTagNames out of sync with AllocTag");
+
+} // namespace
+
+const char* allocTagName(AllocTag tag)
+{
+    return tag < AllocTag::Count ? kTagNames[static_cast<size_t>(tag)] : "?";
+}
+
+namespace alloctrack {
+
+void* allocate(size_t size, size_t alignment, AllocTag tag)
+{
+    const bool overAligned = alignment > sizeof(BlockHeader);
+    const size_t headerSpace = overAligned ? alignment : sizeof(BlockHeader);
+    if (size > SIZE_MAX - 2 * headerSpace) return nullptr;
+    size_t total = size + headerSpace;
+
+    void* base;
+    if (!overAligned) {
+        base = std::malloc(total);
+    } else {
+#ifdef _WIN32
+        base = _aligned_malloc(total, alignment);
+#else
+        total = (total + alignment - 1) & ~(alignment - 1);   // aligned_alloc: wielokrotność wyrównania
+        base = std::aligned_alloc(alignment, total);
+#endif
+    }
+    if (!base) return nullptr;
+
+    unsigned char* user = static_cast<unsigned char*>(base) + headerSpace;
+    BlockHeader* h = headerOf(user);
+    h->size = size;
+    h->offset = static_cast<uint32_t>(headerSpace);
+    h->tag = static_cast<uint8_t>(tag);
+    h->overAligned = overAligned ? 1 : 0;
+    h->reserved = 0;
+
+    Bucket& b = g_buckets[static_cast<size_t>(tag)];
+    b.allocs.fetch_add(1, std::memory_order_relaxed);
+    b.bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+    const uint64_t live = g_live.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t peak = g_peak.load(std::memory_order_relaxed);
+    while (live > peak && !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    ++t_allocs;
+    t_bytes += size;
+    return user;
+}
+
+void release(void* ptr)
+{
+    if (!ptr) return;
+    const BlockHeader* h = headerOf(ptr);
+    Bucket& b = g_buckets[h->tag];
+    b.frees.fetch_add(1, std::memory_order_relaxed);
+    b.bytesFreed.fetch_add(h->size, std::memory_order_relaxed);
+    g_live.fetch_sub(h->size, std::memory_order_relaxed);
+
+    void* base = static_cast<unsigned char*>(ptr) - h->offset;
+#ifdef _WIN32
+    if (h->overAligned) { _aligned_free(base); return; }
+#endif
+    std::free(base);
+}
+
+void* reallocate(void* ptr, size_t size, size_t alignment, AllocTag tag)
+{
+    if (!ptr) return allocate(size, alignment, tag);
+    if (size == 0) { release(ptr); return nullptr; }
+    void* moved = allocate(size, alignment, tag);
+    if (!moved) return nullptr;   // stary blok zostaje ważny
+    const size_t old = blockSize(ptr);
+    std::memcpy(moved, ptr, old < size ? old : size);
+    release(ptr);
+    return moved;
+}
+
+size_t blockSize(const void* ptr)
+{
+    return ptr ? static_cast<size_t>(headerOf(ptr)->size) : 0;
+}
+
+AllocTag currentTag() { return t_tag; }
+void setCurrentTag(AllocTag tag) { t_tag = tag; }
+
+bool hooksInstalled() { return g_hooks; }
+void markHooksInstalled() { g_hooks = true; }
+
+AllocCounters counters(AllocTag tag)
+{
+    const Bucket& b = g_buckets[static_cast<size_t>(tag)];
+    AllocCounters c;
+    c.allocs = b.allocs.load(std::memory_order_relaxed);
+    c.frees = b.frees.load(std::memory_order_relaxed);
+    c.bytesAllocated = b.bytesAllocated.load(std::memory_order_relaxed);
+    c.bytesFreed = b.bytesFreed.load(std::memory_order_relaxed);
+    return c;
+}
+
+uint64_t liveBytes() { return g_live.load(std::memory_order_relaxed); }
+uint64_t peakBytes() { return g_peak.load(std::memory_order_relaxed); }
+uint64_t threadAllocs() { return t_allocs; }
+uint64_t threadBytes() { return t_bytes; }
+
+void printReport(std::ostream& out)
+{
+    const auto kib = [](uint64_t bytes) { return static_cast<double>(bytes) / 1024.0; };
+    out << "[Memory] live " << std::fixed << std::setprecision(1) << kib(liveBytes()) << " KiB, peak "
+        << kib(peakBytes()) << " KiB" << (hooksInstalled() ? "" : " (heap hooks off)") << "\n";
+    for (size_t i = 0; i < static_cast<size_t>(AllocTag::Count); ++i) {
+        const AllocCounters c = counters(static_cast<AllocTag>(i));
+        if (c.allocs == 0) continue;
+        out << "  " << std::left << std::setw(12) << kTagNames[i] << std::right
+            << std::setw(10) << c.allocs << " allocs " << std::setw(10) << c.frees << " frees "
+            << std::setw(12) << kib(c.bytesAllocated) << " KiB total " << std::setw(10) << kib(c.liveBytes()) << " KiB live\n";
+    }
+    out.flush();
+}
+
+} // namespace alloctrack
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Kategorie pamięci. Sterta: tag bieżącego AllocScope w wątku; ImGui i Vulkan mają własne
+// funkcje alokujące i trafiają do swoich kategorii niezależnie od scope'u.
+enum class AllocTag : uint8_t {
+    General,
+    Game,
+    Assets,
+    Render,
+    Save,
+    ImGui,
+    // Host-side pamięć sterownika Vulkan, po VkSystemAllocationScope
+    VkCommand,
+    VkObject,
+    VkCache,
+    VkDevice,
+    VkInstance,
+    Count
+};
+
+const char* allocTagName(AllocTag tag);
+
+struct AllocCounters {
+    uint64_t allocs = 0;
+    uint64_t frees = 0;
+    uint64_t bytesAllocated = 0;
+    uint64_t bytesFreed = 0;
+    uint64_t liveBytes() const { return bytesAllocated - bytesFreed; }
+};
+
+// Liczniki alokacji. Każdy blok ma 16-bajtowy nagłówek (rozmiar, tag, przesunięcie), więc
+// zwolnienie nie potrzebuje rozmiaru ani tagu z miejsca wywołania. Globalne liczniki są
+// atomowe (relaxed); liczniki wątku są thread_local i służą do budżetu klatki wątku głównego.
+namespace alloctrack {
+
+void* allocate(size_t size, size_t alignment, AllocTag tag);   // nullptr przy braku pamięci
+void* reallocate(void* ptr, size_t size, size_t alignment, AllocTag tag);
+void release(void* ptr);
+size_t blockSize(const void* ptr);
+
+AllocTag currentTag();
+void setCurrentTag(AllocTag tag);
+
+// operator new/delete podmienione (core/AllocHooks.cpp jest w buildzie)
+bool hooksInstalled();
+void markHooksInstalled();
+
+AllocCounters counters(AllocTag tag);
+uint64_t liveBytes();
+uint64_t peakBytes();
+
+// Alokacje wątku wywołującego od jego startu
+uint64_t threadAllocs();
+uint64_t threadBytes();
+
+void printReport(std::ostream& out);
+
+} // namespace alloctrack
+
+// Oznacza alokacje sterty w zakresie (w bieżącym wątku)
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag tag) : prev_(alloctrack::currentTag()) { alloctrack::setCurrentTag(tag); }
+    ~AllocScope() { alloctrack::setCurrentTag(prev_); }
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+private:
+    AllocTag prev_;
+};
@@ -0,0 +1,65 @@
+#include "DirtyRegion.h"
+#include <algorithm>
+
+namespace {
+uint64_t overlap(const DirtyRect& a, const DirtyRect& b)
+{
+    const uint32_t x0 = std::max(a.x, b.x), x1 = std::min(a.x + a.width, b.x + b.width);
+    const uint32_t y0 = std::max(a.y, b.y), y1 = std::min(a.y + a.height, b.y + b.height);
+    return x0 < x1 && y0 < y1 ? uint64_t(x1 - x0) * (y1 - y0) : 0;
+}
+
+// Piksele sumy, których nie pokrywa żaden z dwóch prostokątów
+uint64_t waste(const DirtyRect& a, const DirtyRect& b)
+{
+    return unite(a, b).area() - (a.area() + b.area() - overlap(a, b));
+}
+}
+
+DirtyRect unite(const DirtyRect& a, const DirtyRect& b)
+{
+    const uint32_t x0 = std::min(a.x, b.x), y0 = std::min(a.y, b.y);
+    const uint32_t x1 = std::max(a.x + a.width, b.x + b.width), y1 = std::max(a.y + a.height, b.y + b.height);
+    return { x0, y0, x1 - x0, y1 - y0 };
+}
+
+void DirtyRegion::add(DirtyRect rect)
+{
+    if (rect.empty()) return;
+    // Suma może teraz dotykać kolejnych prostokątów - łączymy aż do skutku
+    for (bool merged = true; merged;) {
+        merged = false;
+        for (uint32_t i = 0; i < count_; ++i) {
+            // Nakładające się zawsze (regiony jednej kopii nie mogą się pokrywać)
+            if (overlap(rects_[i], rect) || waste(rects_[i], rect) * 4 <= rects_[i].area() + rect.area()) {
+                rect = unite(rects_[i], rect);
+                remove(i);
+                merged = true;
+                break;
+            }
+        }
+    }
+    if (count_ == kMaxRects) {
+        uint32_t best = 0;
+        uint64_t bestGrowth = UINT64_MAX;
+        for (uint32_t i = 0; i < count_; ++i) {
+            const uint64_t growth = unite(rects_[i], rect).area() - rects_[i].area();
+            if (growth < bestGrowth) {
+                bestGrowth = growth;
+                best = i;
+            }
+        }
+        rect = unite(rects_[best], rect);
+        remove(best);
+        add(rect);
+        return;
+    }
+    rects_[count_++] = rect;
+}
+
+uint64_t DirtyRegion::area() const
+{
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < count_; ++i) total += rects_[i].area();
+    return total;
+}
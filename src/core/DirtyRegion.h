@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+struct DirtyRect {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    uint64_t area() const { return uint64_t(width) * height; }
+    bool empty() const { return width == 0 || height == 0; }
+};
+
+DirtyRect unite(const DirtyRect& a, const DirtyRect& b);
+
+// Zmienione obszary obrazu do wysłania na GPU, najwyżej kMaxRects prostokątów (tyle regionów
+// ma jedno vkCmdCopyBufferToImage), parami rozłącznych. Nowy prostokąt łączy się z istniejącym,
+// gdy się nakładają albo suma marnuje najwyżej 1/4 ich pola (sąsiednie kafle zlewają się w pasy);
+// przy komplecie scalana jest para, której suma rośnie najmniej. Bez alokacji - tablica w obiekcie.
+class DirtyRegion {
+public:
+    static constexpr uint32_t kMaxRects = 16;
+
+    void add(DirtyRect rect);
+    void clear() { count_ = 0; }
+
+    bool empty() const { return count_ == 0; }
+    std::span<const DirtyRect> rects() const { return { rects_, count_ }; }
+    uint64_t area() const;
+
+private:
+    DirtyRect rects_[kMaxRects];
+    uint32_t count_ = 0;
+
+    void remove(uint32_t i) { rects_[i] = rects_[--count_]; }
+};
@@ -0,0 +1,113 @@
+#include "FrameArena.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+namespace {
+constexpr size_t kBlockAlignment = 64;
+
+uintptr_t alignUp(uintptr_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+}
+
+// --- LinearArena ---
+
+LinearArena::LinearArena(size_t capacity, AllocTag tag) : tag_(tag)
+{
+    if (capacity) {
+        void* p = alloctrack::allocate(capacity, kBlockAlignment, tag_);
+        if (!p) throw std::bad_alloc();
+        blocks_.push_back({ static_cast<unsigned char*>(p), capacity });
+    }
+}
+
+LinearArena::~LinearArena()
+{
+    for (const Block& b : blocks_) alloctrack::release(b.data);
+}
+
+void* LinearArena::fitInBlock(size_t block, size_t from, size_t size, size_t alignment)
+{
+    const Block& b = blocks_[block];
+    const uintptr_t base = reinterpret_cast<uintptr_t>(b.data);
+    const size_t begin = alignUp(base + from, alignment) - base;
+    if (begin > b.size || size > b.size - begin) return nullptr;
+    current_ = block;
+    offset_ = begin + size;
+    return b.data + begin;
+}
+
+void* LinearArena::allocateSlow(size_t size, size_t alignment)
+{
+    // Następny blok z łańcucha (po rewind) albo nowy, co najmniej dwa razy większy od ostatniego
+    for (size_t i = current_ + 1; i < blocks_.size(); ++i)
+        if (void* p = fitInBlock(i, 0, size, alignment)) return p;
+
+    const size_t last = blocks_.empty() ? 0 : blocks_.back().size;
+    const size_t bytes = std::max({ size + alignment, last * 2, size_t(4096) });
+    void* p = alloctrack::allocate(bytes, kBlockAlignment, tag_);
+    if (!p) throw std::bad_alloc();
+    blocks_.push_back({ static_cast<unsigned char*>(p), bytes });
+    return fitInBlock(blocks_.size() - 1, 0, size, alignment);
+}
+
+void LinearArena::reset()
+{
+    highWater_ = std::max(highWater_, used());
+    if (blocks_.size() > 1) {
+        const size_t total = capacity();
+        for (const Block& b : blocks_) alloctrack::release(b.data);
+        blocks_.clear();
+        void* p = alloctrack::allocate(total, kBlockAlignment, tag_);
+        if (!p) throw std::bad_alloc();
+        blocks_.push_back({ static_cast<unsigned char*>(p), total });
+    }
+    current_ = 0;
+    offset_ = 0;
+}
+
+size_t LinearArena::used() const
+{
+    size_t total = offset_;
+    for (size_t i = 0; i < current_ && i < blocks_.size(); ++i) total += blocks_[i].size;
+    return total;
+}
+
+size_t LinearArena::capacity() const
+{
+    size_t total = 0;
+    for (const Block& b : blocks_) total += b.size;
+    return total;
+}
+
+// --- FrameArenas ---
+
+FrameArenas::FrameArenas(uint32_t framesInFlight, size_t frameBytes, size_t threadBytes, AllocTag tag, uint32_t threadSlots)
+    : threadBytes_(threadBytes), tag_(tag)
+{
+    for (uint32_t i = 0; i < framesInFlight; ++i)
+        frames_.push_back(std::make_unique<Frame>(frameBytes, tag, threadSlots));
+}
+
+void FrameArenas::beginFrame(uint32_t frameIndex)
+{
+    current_ = frameIndex;
+    Frame& f = *frames_[frameIndex];
+    f.main.reset();
+    for (auto& t : f.threads)
+        if (t) t->reset();
+}
+
+LinearArena& FrameArenas::local(JobSystem& jobs)
+{
+    auto& threads = frames_[current_]->threads;
+    const uint32_t slot = jobs.threadSlot();
+    if (slot >= threads.size())
+        throw std::runtime_error("FrameArenas: thread slots not sized for this JobSystem");
+    std::unique_ptr<LinearArena>& arena = threads[slot];
+    if (!arena) arena = std::make_unique<LinearArena>(threadBytes_, tag_);
+    return *arena;
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "AllocTracker.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class JobSystem;
+
+// Alokator liniowy: allocate() przesuwa wskaźnik, zwalnia się wszystko naraz (reset/rewind).
+// Gdy blok się skończy, dokładany jest kolejny; reset() skleja je w jeden blok o łącznym
+// rozmiarze, więc po kilku klatkach rozgrzewki arena już nie woła malloc.
+class LinearArena {
+public:
+    struct Marker {
+        size_t block = 0;
+        size_t offset = 0;
+    };
+
+    explicit LinearArena(size_t capacity = 0, AllocTag tag = AllocTag::General);
+    ~LinearArena();
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        if (current_ < blocks_.size()) {
+            const Block& b = blocks_[current_];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(b.data);
+            const size_t begin = static_cast<size_t>(((base + offset_ + alignment - 1) & ~uintptr_t(alignment - 1)) - base);
+            if (begin <= b.size && size <= b.size - begin) {
+                offset_ = begin + size;
+                return b.data + begin;
+            }
+        }
+        return allocateSlow(size, alignment);
+    }
+    template <typename T>
+    T* allocArray(size_t count) { return static_cast<T*>(allocate(count * sizeof(T), alignof(T))); }
+
+    void reset();
+    Marker mark() const { return { current_, offset_ }; }
+    void rewind(Marker m) { current_ = m.block; offset_ = m.offset; }
+
+    size_t used() const;
+    size_t capacity() const;
+    size_t highWater() const { return highWater_; }
+    uint32_t blockCount() const { return static_cast<uint32_t>(blocks_.size()); }
+
+private:
+    struct Block {
+        unsigned char* data;
+        size_t size;
+    };
+    std::vector<Block> blocks_;
+    size_t current_ = 0;
+    size_t offset_ = 0;
+    size_t highWater_ = 0;
+    AllocTag tag_;
+
+    void* fitInBlock(size_t block, size_t from, size_t size, size_t alignment);
+    void* allocateSlow(size_t size, size_t alignment);
+};
+
+// Adapter dla kontenerów STL. deallocate nic nie robi - pamięć wraca przy resecie areny,
+// więc kontener nie może żyć dłużej niż bieżąca klatka (albo znacznik rewind).
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator(LinearArena& arena) noexcept : arena_(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(size_t n) { return arena_->allocArray<T>(n); }
+    void deallocate(T*, size_t) noexcept {}
+
+    LinearArena* arena() const noexcept { return arena_; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena_ == other.arena(); }
+
+private:
+    LinearArena* arena_;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+// Osobna arena na każdą klatkę w locie plus pod-areny wątków JobSystemu, indeksowane jego
+// threadSlot() - threadSlots to jobs.slotCount() (0 = bez local()). beginFrame(i) woła się po
+// fence klatki i - wtedy ani GPU, ani zadania tej klatki nie czytają już jej danych. Zadania
+// używające local() muszą skończyć się w klatce, w której je zlecono.
+class FrameArenas {
+public:
+    FrameArenas(uint32_t framesInFlight, size_t frameBytes, size_t threadBytes, AllocTag tag, uint32_t threadSlots = 0);
+
+    void beginFrame(uint32_t frameIndex);
+    LinearArena& frame() { return frames_[current_]->main; }
+    LinearArena& local(JobSystem& jobs);
+
+    const LinearArena& frame(uint32_t frameIndex) const { return frames_[frameIndex]->main; }
+    uint32_t frameCount() const { return static_cast<uint32_t>(frames_.size()); }
+
+private:
+    struct Frame {
+        LinearArena main;
+        std::vector<std::unique_ptr<LinearArena>> threads;   // rozmiar stały - local() nie realokuje
+        Frame(size_t bytes, AllocTag tag, uint32_t threadSlots) : main(bytes, tag), threads(threadSlots) {}
+    };
+    std::vector<std::unique_ptr<Frame>> frames_;
+    uint32_t current_ = 0;
+    size_t threadBytes_;
+    AllocTag tag_;
+};
@@ -0,0 +1,219 @@
+#include "FrameGraph.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+const char* gpuAccessName(GpuAccess access)
+{
+    switch (access) {
+    case GpuAccess::None: return "none";
+    case GpuAccess::ColorAttachmentWrite: return "color-write";
+    case GpuAccess::ShaderRead: return "shader-read";
+    case GpuAccess::TransferWrite: return "transfer-write";
+    case GpuAccess::TransferRead: return "transfer-read";
+    case GpuAccess::Present: return "present";
+    default: return "?";
+    }
+}
+
+FrameGraph::ResourceId FrameGraph::createImage(const char* name, const ImageDesc& desc)
+{
+    Resource r;
+    r.name = name;
+    r.desc = desc;
+    resources_.push_back(r);
+    return static_cast<ResourceId>(resources_.size() - 1);
+}
+
+FrameGraph::ResourceId FrameGraph::importImage(const char* name, GpuAccess initial, GpuAccess final, bool keepContents)
+{
+    Resource r;
+    r.name = name;
+    r.imported = true;
+    r.keepContents = keepContents;
+    r.initial = initial;
+    r.final = final;
+    resources_.push_back(r);
+    return static_cast<ResourceId>(resources_.size() - 1);
+}
+
+FrameGraph::PassId FrameGraph::addPass(const char* name, bool keep)
+{
+    passes_.push_back({ name, keep, false, {} });
+    return static_cast<PassId>(passes_.size() - 1);
+}
+
+void FrameGraph::read(PassId pass, ResourceId resource, GpuAccess access)
+{
+    if (isWrite(access)) throw std::logic_error("FrameGraph::read with a write access");
+    passes_[pass].uses.push_back({ resource, access });
+}
+
+void FrameGraph::write(PassId pass, ResourceId resource, GpuAccess access)
+{
+    if (!isWrite(access)) throw std::logic_error("FrameGraph::write with a read access");
+    passes_[pass].uses.push_back({ resource, access });
+}
+
+void FrameGraph::clear()
+{
+    *this = {};
+}
+
+// Od końca: pass żyje, gdy ma efekt uboczny, pisze do obrazu importowanego albo jego wynik
+// czyta żywy pass. Zapis zaspokaja wcześniejszą potrzebę, odczyt tworzy nową.
+void FrameGraph::cull()
+{
+    std::vector<uint8_t> needed(resources_.size(), 0);
+    for (size_t i = passes_.size(); i-- > 0;) {
+        Pass& p = passes_[i];
+        bool alive = p.keep;
+        for (const Use& u : p.uses)
+            if (isWrite(u.access) && (needed[u.resource] || resources_[u.resource].imported)) alive = true;
+        p.culled = !alive;
+        if (!alive) continue;
+        for (const Use& u : p.uses)
+            if (isWrite(u.access)) needed[u.resource] = 0;
+        for (const Use& u : p.uses)
+            if (!isWrite(u.access)) needed[u.resource] = 1;
+    }
+}
+
+// Przedziały życia obrazów przejściowych pakowane zachłannie: obraz trafia do pierwszego slotu,
+// którego poprzedni lokator skończył się przed jego pierwszym passem. entry[r] dostaje dostęp,
+// na który musi poczekać pierwszy użytkownik r - ostatni dostęp poprzedniego lokatora slotu
+// (cyklicznie, więc pierwszy lokator czeka na ostatniego z poprzedniej klatki).
+void FrameGraph::assignSlots(std::vector<GpuAccess>& entry)
+{
+    std::vector<GpuAccess> last(resources_.size(), GpuAccess::None);
+    for (const Step& s : steps_)
+        for (const Use& u : passes_[s.pass].uses) last[u.resource] = u.access;
+
+    std::vector<ResourceId> order;
+    for (ResourceId r = 0; r < resources_.size(); ++r)
+        if (!resources_[r].imported && resources_[r].firstStep != UINT32_MAX) order.push_back(r);
+    std::sort(order.begin(), order.end(), [&](ResourceId a, ResourceId b) { return resources_[a].firstStep < resources_[b].firstStep; });
+
+    std::vector<std::vector<ResourceId>> slots;
+    for (ResourceId r : order) {
+        Resource& res = resources_[r];
+        uint32_t slot = 0;
+        while (slot < slots.size() && resources_[slots[slot].back()].lastStep >= res.firstStep) ++slot;
+        if (slot == slots.size()) slots.emplace_back();
+        slots[slot].push_back(r);
+        res.slot = slot;
+    }
+    slotCount_ = static_cast<uint32_t>(slots.size());
+
+    for (const auto& occupants : slots)
+        for (size_t i = 0; i < occupants.size(); ++i)
+            entry[occupants[i]] = last[occupants[(i + occupants.size() - 1) % occupants.size()]];
+}
+
+void FrameGraph::compile()
+{
+    steps_.clear();
+    barriers_.clear();
+    finalBarriers_.clear();
+    for (Resource& r : resources_) {
+        r.accessMask = 0;
+        r.slot = kNoSlot;
+        r.firstStep = UINT32_MAX;
+        r.lastStep = 0;
+    }
+
+    cull();
+    for (PassId p = 0; p < passes_.size(); ++p) {
+        if (passes_[p].culled) continue;
+        const uint32_t step = static_cast<uint32_t>(steps_.size());
+        steps_.push_back({ p, 0, 0 });
+        for (const Use& u : passes_[p].uses) {
+            Resource& r = resources_[u.resource];
+            r.accessMask |= 1u << static_cast<uint32_t>(u.access);
+            r.firstStep = std::min(r.firstStep, step);
+            r.lastStep = std::max(r.lastStep, step);
+        }
+    }
+
+    std::vector<GpuAccess> entry(resources_.size(), GpuAccess::None);
+    assignSlots(entry);
+
+    // Stan bieżący; pierwsze użycie obrazu przejściowego zawsze odrzuca zawartość
+    std::vector<GpuAccess> state(resources_.size(), GpuAccess::None);
+    std::vector<uint8_t> touched(resources_.size(), 0);
+    for (ResourceId r = 0; r < resources_.size(); ++r)
+        state[r] = resources_[r].imported ? resources_[r].initial : entry[r];
+
+    for (Step& s : steps_) {
+        s.firstBarrier = static_cast<uint32_t>(barriers_.size());
+        for (const Use& u : passes_[s.pass].uses) {
+            const Resource& r = resources_[u.resource];
+            const bool first = !touched[u.resource];
+            const bool discard = first && !r.keepContents;
+            const GpuAccess before = state[u.resource];
+            touched[u.resource] = 1;
+            state[u.resource] = u.access;
+            // Odczyt po odczycie w tym samym układzie nie potrzebuje bariery
+            if (!discard && before == u.access && !isWrite(u.access)) continue;
+            barriers_.push_back({ u.resource, before, u.access, discard });
+        }
+        s.barrierCount = static_cast<uint32_t>(barriers_.size()) - s.firstBarrier;
+    }
+
+    for (ResourceId r = 0; r < resources_.size(); ++r) {
+        const Resource& res = resources_[r];
+        if (res.imported && res.final != GpuAccess::None && state[r] != res.final)
+            finalBarriers_.push_back({ r, state[r], res.final, !touched[r] && !res.keepContents });
+    }
+}
+
+std::string FrameGraph::describe() const
+{
+    std::string out;
+    auto barrierLine = [&](const Barrier& b) {
+        out += "    ";
+        out += resources_[b.resource].name;
+        out += ": ";
+        out += gpuAccessName(b.before);
+        out += b.discard ? " (discard) -> " : " -> ";
+        out += gpuAccessName(b.after);
+        out += '\n';
+    };
+    for (const Step& s : steps_) {
+        out += "pass ";
+        out += passes_[s.pass].name;
+        out += '\n';
+        for (const Barrier& b : barriers(s)) barrierLine(b);
+    }
+    if (!finalBarriers_.empty()) {
+        out += "end of frame\n";
+        for (const Barrier& b : finalBarriers_) barrierLine(b);
+    }
+    for (const Pass& p : passes_) {
+        if (!p.culled) continue;
+        out += "culled ";
+        out += p.name;
+        out += '\n';
+    }
+    for (const Resource& r : resources_) {
+        if (r.imported) continue;
+        out += "transient ";
+        out += r.name;
+        if (r.slot == kNoSlot) {
+            out += " unused\n";
+            continue;
+        }
+        out += ' ';
+        out += std::to_string(r.desc.width);
+        out += 'x';
+        out += std::to_string(r.desc.height);
+        out += " slot ";
+        out += std::to_string(r.slot);
+        out += " steps ";
+        out += std::to_string(r.firstStep);
+        out += "..";
+        out += std::to_string(r.lastStep);
+        out += '\n';
+    }
+    return out;
+}
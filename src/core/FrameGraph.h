@@ -0,0 +1,115 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// Sposób użycia obrazu przez pass. Z tego (a nie z ręcznie wpisanych masek) wynikają etapy,
+// maski dostępu i układy w barierach - tłumaczy je FrameGraphVulkan.
+enum class GpuAccess : uint8_t {
+    None,                   // brak poprzedniego użycia
+    ColorAttachmentWrite,
+    ShaderRead,             // próbkowanie we fragment shaderze
+    TransferWrite,
+    TransferRead,
+    Present,
+    Count
+};
+const char* gpuAccessName(GpuAccess access);
+constexpr bool isWrite(GpuAccess a) { return a == GpuAccess::ColorAttachmentWrite || a == GpuAccess::TransferWrite; }
+
+// Graf klatki: passy deklarują, co czytają i piszą; compile() wycina passy, których wyniku nikt
+// nie używa, wylicza minimalne bariery przed każdym passem i przydziela obrazom przejściowym
+// sloty pamięci - obrazy o rozłącznych czasach życia dzielą slot (aliasing).
+// Bez Vulkana: tę część da się sprawdzić i zmierzyć poza grą.
+class FrameGraph {
+public:
+    using ResourceId = uint32_t;
+    using PassId = uint32_t;
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    struct ImageDesc {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t format = 0;   // VkFormat
+    };
+
+    struct Barrier {
+        ResourceId resource;
+        GpuAccess before;      // na co czekać (przy discard: ostatni użytkownik slotu)
+        GpuAccess after;
+        bool discard;          // poprzednia zawartość niepotrzebna (układ UNDEFINED)
+    };
+
+    struct Step {
+        PassId pass;
+        uint32_t firstBarrier;
+        uint32_t barrierCount;
+    };
+
+    // Obraz przejściowy: żyje tylko w obrębie klatki, pamięć przydziela graf
+    ResourceId createImage(const char* name, const ImageDesc& desc);
+    // Obraz z zewnątrz (np. swapchain): dostęp, na który czeka pierwszy pass, i wymagany stan
+    // po ostatnim. Bez keepContents pierwsze użycie odrzuca zawartość.
+    ResourceId importImage(const char* name, GpuAccess initial, GpuAccess final, bool keepContents = false);
+    // keep: pass z efektem ubocznym, nigdy nie jest wycinany
+    PassId addPass(const char* name, bool keep = false);
+    void read(PassId pass, ResourceId resource, GpuAccess access);
+    void write(PassId pass, ResourceId resource, GpuAccess access);
+
+    void compile();
+    void clear();
+
+    std::span<const Step> steps() const { return steps_; }
+    std::span<const Barrier> barriers(const Step& step) const { return { barriers_.data() + step.firstBarrier, step.barrierCount }; }
+    std::span<const Barrier> finalBarriers() const { return finalBarriers_; }
+
+    uint32_t resourceCount() const { return static_cast<uint32_t>(resources_.size()); }
+    const char* resourceName(ResourceId r) const { return resources_[r].name; }
+    bool imported(ResourceId r) const { return resources_[r].imported; }
+    const ImageDesc& desc(ResourceId r) const { return resources_[r].desc; }
+    uint32_t accessMask(ResourceId r) const { return resources_[r].accessMask; }   // bity 1 << GpuAccess
+    uint32_t aliasSlot(ResourceId r) const { return resources_[r].slot; }          // kNoSlot: nieużywany/importowany
+    uint32_t aliasSlotCount() const { return slotCount_; }
+
+    uint32_t passCount() const { return static_cast<uint32_t>(passes_.size()); }
+    const char* passName(PassId p) const { return passes_[p].name; }
+    bool culled(PassId p) const { return passes_[p].culled; }
+
+    // Tekstowy opis skompilowanego grafu (panel Render, --dump)
+    std::string describe() const;
+
+private:
+    struct Use {
+        ResourceId resource;
+        GpuAccess access;
+    };
+    struct Pass {
+        const char* name;
+        bool keep;
+        bool culled = false;
+        std::vector<Use> uses;
+    };
+    struct Resource {
+        const char* name;
+        ImageDesc desc;
+        bool imported = false;
+        bool keepContents = false;
+        GpuAccess initial = GpuAccess::None;
+        GpuAccess final = GpuAccess::None;
+        uint32_t accessMask = 0;
+        uint32_t slot = kNoSlot;
+        uint32_t firstStep = UINT32_MAX;
+        uint32_t lastStep = 0;
+    };
+
+    std::vector<Pass> passes_;
+    std::vector<Resource> resources_;
+    std::vector<Step> steps_;
+    std::vector<Barrier> barriers_;
+    std::vector<Barrier> finalBarriers_;
+    uint32_t slotCount_ = 0;
+
+    void cull();
+    void assignSlots(std::vector<GpuAccess>& entry);
+};
@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+// FNV-1a 64 - stabilny między uruchomieniami i platformami (trafia do plików zapisu)
+constexpr uint64_t hashString(std::string_view s) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (char c : s) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
@@ -0,0 +1,71 @@
+#include "InputRecording.h"
+#include <stdexcept>
+
+using namespace inputfmt;
+
+static_assert(sizeof(InputEvent) == 20, "InputEvent is part of the recording format");
+
+// --- InputRecorder ---
+
+bool InputRecorder::open(const std::string& path, uint64_t seed)
+{
+    close();
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_) return false;
+    const Header h{ kMagic, kVersion, seed };
+    out_.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    pending_.clear();
+    frames_ = 0;
+    return static_cast<bool>(out_);
+}
+
+void InputRecorder::close()
+{
+    if (!out_.is_open()) return;
+    out_.flush();
+    out_.close();
+}
+
+void InputRecorder::endFrame(float dt)
+{
+    if (!out_.is_open()) { pending_.clear(); return; }
+    const FrameHeader fh{ static_cast<uint32_t>(pending_.size()), dt };
+    out_.write(reinterpret_cast<const char*>(&fh), sizeof(fh));
+    if (!pending_.empty())
+        out_.write(reinterpret_cast<const char*>(pending_.data()),
+            static_cast<std::streamsize>(pending_.size() * sizeof(InputEvent)));
+    pending_.clear();
+    ++frames_;
+}
+
+// --- InputReplay ---
+
+bool InputReplay::open(const std::string& path)
+{
+    if (!file_.open(path)) return false;
+    if (file_.size() < sizeof(Header))
+        throw std::runtime_error("Input recording too short: " + path);
+    const auto* h = reinterpret_cast<const Header*>(file_.data());
+    if (h->magic != kMagic)
+        throw std::runtime_error("Not an input recording: " + path);
+    if (h->version != kVersion)
+        throw std::runtime_error("Unsupported input recording version " + std::to_string(h->version));
+    seed_ = h->seed;
+    offset_ = sizeof(Header);
+    frame_ = 0;
+    return true;
+}
+
+bool InputReplay::nextFrame(Frame& out)
+{
+    if (file_.size() - offset_ < sizeof(FrameHeader)) { offset_ = file_.size(); return false; }
+    const auto* fh = reinterpret_cast<const FrameHeader*>(file_.data() + offset_);
+    const size_t bytes = static_cast<size_t>(fh->eventCount) * sizeof(InputEvent);
+    if (file_.size() - offset_ - sizeof(FrameHeader) < bytes) { offset_ = file_.size(); return false; }
+
+    out.dt = fh->dt;
+    out.events = { reinterpret_cast<const InputEvent*>(file_.data() + offset_ + sizeof(FrameHeader)), fh->eventCount };
+    offset_ += sizeof(FrameHeader) + bytes;
+    ++frame_;
+    return true;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+// Zdarzenie wejścia w postaci niezależnej od okna - pola to surowe argumenty callbacków GLFW
+enum class InputEventType : uint8_t {
+    Key,            // code = key, scancode, action, mods
+    Char,           // code = codepoint
+    MouseButton,    // code = button, action, mods
+    CursorPos,      // x, y
+    Scroll,         // x, y
+    Focus,          // action = focused
+    CursorEnter,    // action = entered
+};
+
+struct InputEvent {
+    InputEventType type = InputEventType::Key;
+    uint8_t action = 0;
+    uint16_t mods = 0;
+    int32_t code = 0;
+    int32_t scancode = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+// Nagranie: nagłówek (magic, wersja, ziarno RNG), potem na każdą klatkę
+// { uint32 liczba zdarzeń, float dt } i zdarzenia w kolejności nadejścia.
+// Czas gry w powtórce pochodzi z zapisanych dt, więc przy tym samym ziarnie przebieg jest identyczny.
+namespace inputfmt {
+constexpr uint32_t kMagic = 0x52494C52;   // "RLIR"
+constexpr uint32_t kVersion = 1;
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t seed;
+};
+
+struct FrameHeader {
+    uint32_t eventCount;
+    float dt;
+};
+} // namespace inputfmt
+
+class InputRecorder {
+public:
+    ~InputRecorder() { close(); }
+
+    bool open(const std::string& path, uint64_t seed);
+    void close();
+    bool isOpen() const { return out_.is_open(); }
+
+    void record(const InputEvent& e) { pending_.push_back(e); }
+    // Zamyka klatkę: zdarzenia zebrane od poprzedniego wywołania + czas klatki
+    void endFrame(float dt);
+
+    uint32_t frames() const { return frames_; }
+
+private:
+    std::ofstream out_;
+    std::vector<InputEvent> pending_;
+    uint32_t frames_ = 0;
+};
+
+class InputReplay {
+public:
+    struct Frame {
+        float dt = 0.0f;
+        std::span<const InputEvent> events;
+    };
+
+    // Wyjątek, gdy plik nie jest nagraniem albo ma inną wersję
+    bool open(const std::string& path);
+    uint64_t seed() const { return seed_; }
+
+    // false na końcu nagrania (ucięta ostatnia klatka też kończy powtórkę)
+    bool nextFrame(Frame& out);
+    bool finished() const { return offset_ >= file_.size(); }
+    uint32_t frame() const { return frame_; }
+
+private:
+    MappedFile file_;
+    size_t offset_ = 0;
+    uint64_t seed_ = 0;
+    uint32_t frame_ = 0;
+};
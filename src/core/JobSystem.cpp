@@ -0,0 +1,344 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+std::atomic<uint64_t> g_nextSystemId{ 1 };
+
+// Wątek pamięta, w którym JobSystemie i pod jakim numerem był zarejestrowany ostatnio;
+// pełna lista rejestracji jest w JobSystem::externalIds_
+struct ThreadSlot {
+    uint64_t owner = 0;
+    uint32_t slot = 0;
+};
+thread_local ThreadSlot t_slot;
+
+uint32_t xorshift(uint32_t& s) {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+}
+
+// --- WorkDeque ---
+
+JobSystem::WorkDeque::WorkDeque(size_t capacity)
+    : buffer_(new std::atomic<Job*>[capacity]), mask_(static_cast<int64_t>(capacity) - 1) {}
+
+bool JobSystem::WorkDeque::push(Job* job)
+{
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    if (b - t > mask_) return false;
+    buffer_[b & mask_].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+Job* JobSystem::WorkDeque::pop()
+{
+    const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Job* job = buffer_[b & mask_].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Ostatni element - ścigamy się ze złodziejami
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            job = nullptr;
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* JobSystem::WorkDeque::steal()
+{
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) return nullptr;
+    Job* job = buffer_[t & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+    return job;
+}
+
+bool JobSystem::WorkDeque::empty() const
+{
+    return bottom_.load(std::memory_order_acquire) <= top_.load(std::memory_order_acquire);
+}
+
+// --- InjectQueue ---
+
+JobSystem::InjectQueue::InjectQueue(size_t capacity) : cells_(new Cell[capacity]), mask_(capacity - 1)
+{
+    for (size_t i = 0; i < capacity; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+}
+
+bool JobSystem::InjectQueue::push(Job* job)
+{
+    size_t pos = enqueue_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells_[pos & mask_];
+        const size_t seq = cell.seq.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueue_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.job = job;
+                cell.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueue_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+Job* JobSystem::InjectQueue::pop()
+{
+    size_t pos = dequeue_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells_[pos & mask_];
+        const size_t seq = cell.seq.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeue_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                Job* job = cell.job;
+                cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+                return job;
+            }
+        } else if (diff < 0) {
+            return nullptr;
+        } else {
+            pos = dequeue_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool JobSystem::InjectQueue::empty() const
+{
+    return enqueue_.load(std::memory_order_acquire) == dequeue_.load(std::memory_order_acquire);
+}
+
+// --- JobSystem ---
+
+JobSystem::JobSystem(uint32_t workerCount) : inject_(kJobsPerThread)
+{
+    if (workerCount == 0) {
+        const uint32_t hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 1;
+    }
+    id_ = g_nextSystemId.fetch_add(1);
+    workerCount_ = workerCount;
+
+    deques_.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i)
+        deques_.push_back(std::make_unique<WorkDeque>(kJobsPerThread));
+
+    pools_.resize(workerCount + kMaxExternalThreads);
+    for (size_t p = 0; p < pools_.size(); ++p) {
+        pools_[p].jobs.reset(new Job[kJobsPerThread]);
+        for (uint32_t i = 0; i < kJobsPerThread; ++i)
+            pools_[p].jobs[i].index = static_cast<uint32_t>(p) * kJobsPerThread + i;
+    }
+
+    workers_.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i)
+        workers_.emplace_back([this, i] { workerMain(i); });
+}
+
+JobSystem::~JobSystem()
+{
+    stop_.store(true);
+    wakeEpoch_.fetch_add(1);
+    wakeEpoch_.notify_all();
+    for (auto& t : workers_) t.join();
+}
+
+uint32_t JobSystem::threadSlot()
+{
+    if (t_slot.owner == id_) return t_slot.slot;
+    // Wątek przełączający się między kilkoma JobSystemami wraca do swojego slotu zamiast brać nowy
+    const std::thread::id self = std::this_thread::get_id();
+    const uint32_t registered = std::min(externalThreads_.load(std::memory_order_acquire), kMaxExternalThreads);
+    uint32_t ext = 0;
+    while (ext < registered && externalIds_[ext].load(std::memory_order_relaxed) != self) ++ext;
+    if (ext == registered) {
+        ext = externalThreads_.fetch_add(1);
+        if (ext >= kMaxExternalThreads)
+            throw std::runtime_error("JobSystem: too many external threads");
+        externalIds_[ext].store(self, std::memory_order_relaxed);
+    }
+    t_slot.owner = id_;
+    t_slot.slot = workerCount() + ext;
+    return t_slot.slot;
+}
+
+Job* JobSystem::allocateJob()
+{
+    JobPool& pool = pools_[threadSlot()];
+    Job* job = &pool.jobs[pool.next++ & (kJobsPerThread - 1)];
+    // Pierścień zawinął się na zadanie, które jeszcze czeka - pomagamy, aż się zwolni
+    while (job->busy.load(std::memory_order_acquire)) {
+        if (!runOne()) std::this_thread::yield();
+    }
+    job->busy.store(true, std::memory_order_relaxed);
+    job->nextWaiter = 0;
+    return job;
+}
+
+void JobSystem::submit(Job* job, JobCounter& counter, JobCounter* dependsOn)
+{
+    job->counter = &counter;
+    counter.state_.fetch_add(1, std::memory_order_acq_rel);
+
+    if (!dependsOn) {
+        push(job);
+        return;
+    }
+
+    // Dopisz na głowę listy oczekujących; licznik równy zero = zależność już spełniona
+    uint64_t state = dependsOn->state_.load(std::memory_order_acquire);
+    for (;;) {
+        if (static_cast<uint32_t>(state) == 0) {
+            push(job);
+            return;
+        }
+        job->nextWaiter = static_cast<uint32_t>(state >> 32);
+        const uint64_t next = (static_cast<uint64_t>(job->index + 1) << 32) | static_cast<uint32_t>(state);
+        if (dependsOn->state_.compare_exchange_weak(state, next, std::memory_order_acq_rel))
+            return;
+    }
+}
+
+void JobSystem::push(Job* job)
+{
+    const uint32_t slot = threadSlot();
+    bool queued = slot < workerCount() ? deques_[slot]->push(job) : inject_.push(job);
+    if (!queued) {
+        execute(job);
+        return;
+    }
+    wakeEpoch_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) > 0)
+        wakeEpoch_.notify_one();
+}
+
+void JobSystem::execute(Job* job)
+{
+    job->fn(job->data);
+    JobCounter* counter = job->counter;
+    job->busy.store(false, std::memory_order_release);
+    finish(counter);
+}
+
+void JobSystem::finish(JobCounter* counter)
+{
+    uint64_t state = counter->state_.load(std::memory_order_acquire);
+    for (;;) {
+        const bool last = static_cast<uint32_t>(state) == 1;
+        // Ostatnie zadanie zeruje licznik i zabiera listę oczekujących w jednym kroku
+        const uint64_t next = last ? 0 : state - 1;
+        if (counter->state_.compare_exchange_weak(state, next, std::memory_order_acq_rel)) {
+            if (last) releaseWaiters(static_cast<uint32_t>(state >> 32));
+            return;
+        }
+    }
+}
+
+void JobSystem::releaseWaiters(uint32_t head)
+{
+    while (head) {
+        Job* w = jobAt(head - 1);
+        head = w->nextWaiter;
+        push(w);
+    }
+}
+
+Job* JobSystem::findJob(uint32_t slot)
+{
+    const uint32_t n = workerCount();
+    if (slot < n)
+        if (Job* j = deques_[slot]->pop()) return j;
+    if (Job* j = inject_.pop()) return j;
+    if (n == 0) return nullptr;
+
+    thread_local uint32_t rng = 0x9E3779B9u ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&rng));
+    const uint32_t start = xorshift(rng) % n;
+    for (uint32_t k = 0; k < n; ++k) {
+        const uint32_t victim = (start + k) % n;
+        if (victim == slot) continue;
+        if (Job* j = deques_[victim]->steal()) return j;
+    }
+    return nullptr;
+}
+
+bool JobSystem::hasWork() const
+{
+    if (!inject_.empty()) return true;
+    for (const auto& d : deques_)
+        if (!d->empty()) return true;
+    return false;
+}
+
+bool JobSystem::runOne()
+{
+    Job* job = findJob(threadSlot());
+    if (!job) return false;
+    execute(job);
+    return true;
+}
+
+void JobSystem::wait(const JobCounter& counter)
+{
+    while (!counter.done()) {
+        if (!runOne()) std::this_thread::yield();
+    }
+}
+
+void JobSystem::workerMain(uint32_t slot)
+{
+    t_slot.owner = id_;
+    t_slot.slot = slot;
+
+    while (!stop_.load(std::memory_order_relaxed)) {
+        if (Job* job = findJob(slot)) {
+            execute(job);
+            continue;
+        }
+        // Krótkie kręcenie, potem sen na epoce budzenia (bez zgubionych pobudek:
+        // epokę czytamy przed ponownym sprawdzeniem kolejek)
+        bool found = false;
+        for (int spin = 0; spin < 64 && !found; ++spin) {
+            std::this_thread::yield();
+            found = hasWork();
+        }
+        if (found) continue;
+
+        const uint32_t epoch = wakeEpoch_.load(std::memory_order_seq_cst);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        if (!hasWork() && !stop_.load())
+            wakeEpoch_.wait(epoch, std::memory_order_seq_cst);
+        sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+void JobSystem::runRange(RangeTask task)
+{
+    // Połowę zakresu oddajemy do kradzieży, resztę dzielimy dalej sami
+    while (task.end - task.begin > task.grain) {
+        RangeTask half = task;
+        half.begin = task.begin + (task.end - task.begin) / 2;
+        task.end = half.begin;
+        schedule(*task.counter, [half] { half.system->runRange(half); });
+    }
+    task.invoke(task.body, task.begin, task.end);
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class JobSystem;
+struct Job;
+
+// Licznik grupy zadań: schedule() zwiększa, zakończenie zadania zmniejsza.
+// Zadania czekające na licznik (schedule(..., &dependsOn)) trzymamy na liście intruzywnej.
+// Licznik i głowa tej listy (indeks zadania w puli) siedzą w jednym słowie 64-bit, więc spadek
+// do zera i zabranie listy to jeden CAS - potem kończący wątek już licznika nie dotyka
+// i po done() można go zniszczyć albo użyć ponownie.
+class JobCounter {
+public:
+    bool done() const { return pending() == 0; }
+    uint32_t pending() const { return static_cast<uint32_t>(state_.load(std::memory_order_acquire)); }
+
+private:
+    friend class JobSystem;
+    // [63..32] indeks pierwszego czekającego zadania + 1 (0 = brak), [31..0] liczba zadań
+    std::atomic<uint64_t> state_{ 0 };
+};
+
+struct Job {
+    static constexpr size_t kDataSize = 64;
+
+    void (*fn)(void* data) = nullptr;
+    JobCounter* counter = nullptr;
+    uint32_t index = 0;       // pozycja w pulach JobSystemu
+    uint32_t nextWaiter = 0;  // indeks + 1 następnego czekającego
+
+    std::atomic<bool> busy{ false };
+    alignas(16) unsigned char data[kDataSize];
+};
+
+// Planista z kradzieżą zadań: jeden wątek roboczy na rdzeń (wątek wywołujący wait() też pomaga),
+// deque Chase-Lev na wątek roboczy i ograniczona kolejka MPMC dla wątków spoza puli (render/main).
+// Zadania pochodzą z pierścieniowych pul per wątek i trzymają lambdę w miejscu - po starcie
+// nic nie alokuje. Wątek renderujący może zlecać prace i sprawdzać JobCounter::done() bez blokowania.
+class JobSystem {
+public:
+    // workerCount == 0 -> hardware_concurrency() - 1 (wątek główny jest dodatkowym pomocnikiem)
+    explicit JobSystem(uint32_t workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    uint32_t workerCount() const { return workerCount_; }
+    // Slot wywołującego wątku: wątki robocze 0..workerCount()-1, potem zewnętrzne. Zawsze
+    // < slotCount(), więc nadaje się na indeks tablic per wątek (np. FrameArenas::local).
+    uint32_t threadSlot();
+    uint32_t slotCount() const { return workerCount_ + kMaxExternalThreads; }
+
+    // Lambda musi się zmieścić w Job::kDataSize (przechwytuj wskaźniki, nie kontenery).
+    template <typename F>
+    void schedule(JobCounter& counter, F&& f, JobCounter* dependsOn = nullptr) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= Job::kDataSize, "Job lambda capture too large");
+        static_assert(alignof(Fn) <= 16, "Job lambda over-aligned");
+        Job* job = allocateJob();
+        ::new (static_cast<void*>(job->data)) Fn(std::forward<F>(f));
+        job->fn = [](void* p) {
+            Fn& fn = *std::launder(reinterpret_cast<Fn*>(p));
+            fn();
+            fn.~Fn();
+        };
+        submit(job, counter, dependsOn);
+    }
+
+    // body(begin, end) wywoływane na podzakresach nie większych niż grain. Blokuje do końca,
+    // ale wątek wywołujący w tym czasie wykonuje zadania.
+    template <typename F>
+    void parallelFor(uint32_t begin, uint32_t end, uint32_t grain, const F& body) {
+        if (begin >= end) return;
+        JobCounter counter;
+        RangeTask task{ this, &body, &RangeTask::template call<F>, begin, end, grain ? grain : 1, &counter };
+        // Guard: licznik nie może spaść do zera, dopóki wątek wywołujący jeszcze dzieli zakres
+        counter.state_.fetch_add(1, std::memory_order_acq_rel);
+        runRange(task);
+        finish(&counter);
+        wait(counter);
+    }
+
+    // Czeka na licznik, wykonując w międzyczasie zadania z kolejek.
+    void wait(const JobCounter& counter);
+    // Wykonuje co najwyżej jedno oczekujące zadanie; false gdy nic nie było.
+    bool runOne();
+
+private:
+    struct RangeTask {
+        JobSystem* system;
+        const void* body;
+        void (*invoke)(const void* body, uint32_t begin, uint32_t end);
+        uint32_t begin;
+        uint32_t end;
+        uint32_t grain;
+        JobCounter* counter;
+
+        template <typename F>
+        static void call(const void* body, uint32_t b, uint32_t e) { (*static_cast<const F*>(body))(b, e); }
+    };
+
+    // Deque Chase-Lev o stałej pojemności: właściciel push/pop od dołu, złodzieje steal od góry.
+    class WorkDeque {
+    public:
+        explicit WorkDeque(size_t capacity);
+        bool push(Job* job);
+        Job* pop();
+        Job* steal();
+        bool empty() const;
+    private:
+        std::unique_ptr<std::atomic<Job*>[]> buffer_;
+        int64_t mask_;
+        alignas(64) std::atomic<int64_t> top_{ 0 };
+        alignas(64) std::atomic<int64_t> bottom_{ 0 };
+    };
+
+    // Ograniczona kolejka MPMC (Vyukov) - zlecenia z wątków spoza puli.
+    class InjectQueue {
+    public:
+        explicit InjectQueue(size_t capacity);
+        bool push(Job* job);
+        Job* pop();
+        bool empty() const;
+    private:
+        struct Cell {
+            std::atomic<size_t> seq;
+            Job* job;
+        };
+        std::unique_ptr<Cell[]> cells_;
+        size_t mask_;
+        alignas(64) std::atomic<size_t> enqueue_{ 0 };
+        alignas(64) std::atomic<size_t> dequeue_{ 0 };
+    };
+
+    struct JobPool {
+        std::unique_ptr<Job[]> jobs;
+        uint32_t next = 0;
+    };
+
+    static constexpr uint32_t kJobsPerThread = 4096;
+    static constexpr uint32_t kMaxExternalThreads = 8;
+
+    uint64_t id_ = 0;
+    uint32_t workerCount_ = 0;       // ustawiane przed startem wątków - workers_ rośnie w trakcie
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<WorkDeque>> deques_;
+    std::vector<JobPool> pools_;             // workers_, potem wątki zewnętrzne
+    InjectQueue inject_;
+    std::atomic<uint32_t> externalThreads_{ 0 };
+    std::array<std::atomic<std::thread::id>, kMaxExternalThreads> externalIds_{};   // właściciel slotu workerCount_ + i
+    std::atomic<bool> stop_{ false };
+    std::atomic<uint32_t> wakeEpoch_{ 0 };
+    std::atomic<uint32_t> sleepers_{ 0 };
+
+    Job* allocateJob();
+    void submit(Job* job, JobCounter& counter, JobCounter* dependsOn);
+    void push(Job* job);
+    void execute(Job* job);
+    void finish(JobCounter* counter);
+    void releaseWaiters(uint32_t head);
+    Job* jobAt(uint32_t index) { return &pools_[index / kJobsPerThread].jobs[index % kJobsPerThread]; }
+    Job* findJob(uint32_t slot);
+    bool hasWork() const;
+    void workerMain(uint32_t slot);
+    void runRange(RangeTask task);
+};
@@ -0,0 +1,466 @@
+#include "Log.h"
+#include "Hash.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+using logger::detail::Record;
+
+namespace {
+constexpr size_t kCapacity = 1024;   // rekordów w pierścieniu (1 MB)
+constexpr double kRepeatWindow = 1.0;
+constexpr auto kRepeatPoll = std::chrono::milliseconds(100);
+constexpr auto kIdlePoll = std::chrono::seconds(1);
+
+struct Cell {
+    Record record;   // pierwsze pole - publish() dostaje wskaźnik na rekord
+    std::atomic<size_t> seq;
+};
+
+struct State {
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> enqueue{ 0 };
+    alignas(64) std::atomic<size_t> dequeue{ 0 };     // tylko wątek zapisu
+    std::atomic<size_t> processed{ 0 };               // zapisane i wypłukane (flush)
+
+    std::atomic<bool> running{ false };
+    std::atomic<bool> stop{ false };
+    std::atomic<bool> sleeping{ false };
+    std::mutex sleep;         // tylko do uśpienia wątku zapisu (producent bierze go, gdy ten śpi)
+    std::condition_variable wake;
+
+    std::atomic<uint8_t> minLevel{ static_cast<uint8_t>(LogLevel::Info) };
+    std::atomic<uint32_t> categoryMask{ ~0u };
+    std::atomic<bool> blockWhenFull{ false };
+    uint32_t repeatLimit = 5;
+
+    std::atomic<uint64_t> written{ 0 };
+    std::atomic<uint64_t> dropped{ 0 };
+    std::atomic<uint64_t> suppressed{ 0 };
+
+    FILE* out = stderr;
+    std::mutex lifecycle;     // start/stop
+    std::mutex direct;        // writeNow bez wątku zapisu
+    std::thread writer;
+    const uint64_t epoch = logger::detail::now();
+};
+
+State& state()
+{
+    static State s;
+    return s;
+}
+
+double seconds(uint64_t ticks)
+{
+    using Ticks = std::chrono::steady_clock::duration;
+    const uint64_t since = ticks > state().epoch ? ticks - state().epoch : 0;
+    return std::chrono::duration<double>(Ticks(static_cast<Ticks::rep>(since))).count();
+}
+
+template <typename T>
+void appendf(std::string& out, const char* spec, T value)
+{
+    char buf[128];
+    const int length = std::snprintf(buf, sizeof(buf), spec, value);
+    if (length < 0) return;
+    if (static_cast<size_t>(length) < sizeof(buf)) {
+        out.append(buf, length);
+        return;
+    }
+    const size_t at = out.size();
+    out.resize(at + length + 1);
+    std::snprintf(out.data() + at, length + 1, spec, value);
+    out.resize(at + length);
+}
+
+struct Arg {
+    logger::detail::ArgType type;
+    uint64_t bits;
+    std::string_view text;
+
+    int64_t asInt() const {
+        if (type == logger::detail::Double) { double d; std::memcpy(&d, &bits, sizeof(d)); return static_cast<int64_t>(d); }
+        return static_cast<int64_t>(bits);
+    }
+    double asDouble() const {
+        if (type == logger::detail::Int) return static_cast<double>(static_cast<int64_t>(bits));
+        if (type != logger::detail::Double) return static_cast<double>(bits);
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
+};
+
+class ArgReader {
+public:
+    explicit ArgReader(const Record& r) : r_(r) {}
+    bool next(Arg& a) {
+        if (index_ == r_.argCount) return false;
+        ++index_;
+        a.type = static_cast<logger::detail::ArgType>(r_.args[at_++]);
+        if (a.type == logger::detail::String) {
+            uint16_t length;
+            std::memcpy(&length, r_.args + at_, sizeof(length));
+            a.text = std::string_view(reinterpret_cast<const char*>(r_.args + at_ + sizeof(length)), length);
+            at_ += sizeof(length) + length;
+        } else {
+            std::memcpy(&a.bits, r_.args + at_, sizeof(a.bits));
+            at_ += sizeof(a.bits);
+        }
+        return true;
+    }
+private:
+    const Record& r_;
+    uint32_t index_ = 0;
+    size_t at_ = 0;
+};
+
+// Argument niepasujący do konwersji (liczba pod %s itp.) - wypisany według własnego typu
+void appendNatural(std::string& out, const Arg& a)
+{
+    switch (a.type) {
+    case logger::detail::Int: appendf(out, "%lld", static_cast<long long>(a.asInt())); break;
+    case logger::detail::Uint: appendf(out, "%llu", static_cast<unsigned long long>(a.bits)); break;
+    case logger::detail::Double: appendf(out, "%g", a.asDouble()); break;
+    case logger::detail::Pointer: appendf(out, "%p", reinterpret_cast<void*>(static_cast<uintptr_t>(a.bits))); break;
+    case logger::detail::String: out.append(a.text); break;
+    }
+}
+
+bool queueEmpty(const State& s)
+{
+    const size_t pos = s.dequeue.load(std::memory_order_relaxed);
+    return s.cells[pos & (kCapacity - 1)].seq.load(std::memory_order_acquire) != pos + 1;
+}
+
+void writeLine(State& s, const Record& r, const std::string& message)
+{
+    std::fprintf(s.out, "[%9.3f] [%s] %s%s%s\n", seconds(r.ticks), logCategoryName(r.category),
+        r.level == LogLevel::Error ? "error: " : r.level == LogLevel::Warning ? "warning: " : "",
+        message.c_str(), r.truncated ? " [...]" : "");
+}
+
+// Wątek zapisu. Powtórzenia liczone po treści: w oknie kRepeatWindow pierwsze repeatLimit
+// idą do pliku, resztę tylko liczymy i po końcu okna wypisujemy podsumowanie.
+void writerMain()
+{
+    State& s = state();
+    struct Repeat {
+        uint64_t windowStart;
+        uint32_t count;
+        uint32_t suppressed;
+        std::string message;
+    };
+    std::unordered_map<uint64_t, Repeat> repeats;
+    std::string message;
+    uint64_t reportedDrops = 0;
+
+    auto sweep = [&](bool all) {
+        const uint64_t now = logger::detail::now();
+        for (auto it = repeats.begin(); it != repeats.end();) {
+            Repeat& rep = it->second;
+            if (!all && seconds(now) - seconds(rep.windowStart) < kRepeatWindow) { ++it; continue; }
+            if (rep.suppressed)
+                std::fprintf(s.out, "[%9.3f] [Log] repeated %u more times: %s\n", seconds(now), rep.suppressed, rep.message.c_str());
+            it = repeats.erase(it);
+        }
+    };
+
+    for (;;) {
+        bool any = false;
+        while (!queueEmpty(s)) {
+            const size_t pos = s.dequeue.load(std::memory_order_relaxed);
+            Cell& cell = s.cells[pos & (kCapacity - 1)];
+            const Record& r = cell.record;
+            message.clear();
+            logger::detail::format(r, message);
+
+            bool write = true;
+            if (s.repeatLimit) {
+                const uint64_t key = hashString(message) ^ (uint64_t(r.category) << 56) ^ (uint64_t(r.level) << 48);
+                auto [it, inserted] = repeats.try_emplace(key, Repeat{ r.ticks, 0, 0, {} });
+                Repeat& rep = it->second;
+                if (++rep.count > s.repeatLimit) {
+                    write = false;
+                    if (rep.suppressed++ == 0) rep.message = message;
+                    s.suppressed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            if (write) {
+                writeLine(s, r, message);
+                s.written.fetch_add(1, std::memory_order_relaxed);
+            }
+            cell.seq.store(pos + kCapacity, std::memory_order_release);
+            s.dequeue.store(pos + 1, std::memory_order_relaxed);
+            any = true;
+        }
+        const uint64_t drops = s.dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            std::fprintf(s.out, "[%9.3f] [Log] %llu messages dropped (buffer full)\n", seconds(logger::detail::now()),
+                static_cast<unsigned long long>(drops - reportedDrops));
+            reportedDrops = drops;
+            any = true;
+        }
+        sweep(false);
+        if (any) std::fflush(s.out);
+        s.processed.store(s.dequeue.load(std::memory_order_relaxed), std::memory_order_release);
+
+        if (s.stop.load(std::memory_order_acquire) && queueEmpty(s)) break;
+        if (any) continue;
+
+        // Podsumowania powtórzeń czekają na koniec okna, więc wtedy budzimy się częściej
+        std::unique_lock<std::mutex> lock(s.sleep);
+        s.sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (queueEmpty(s) && !s.stop.load(std::memory_order_relaxed))
+            s.wake.wait_for(lock, repeats.empty() ? std::chrono::milliseconds(kIdlePoll) : kRepeatPoll);
+        s.sleeping.store(false, std::memory_order_relaxed);
+    }
+    sweep(true);
+    std::fflush(s.out);
+}
+
+void wakeWriter(State& s)
+{
+    { std::lock_guard<std::mutex> lock(s.sleep); }
+    s.wake.notify_one();
+}
+}
+
+const char* logLevelName(LogLevel level)
+{
+    switch (level) {
+    case LogLevel::Verbose: return "verbose";
+    case LogLevel::Info: return "info";
+    case LogLevel::Warning: return "warning";
+    case LogLevel::Error: return "error";
+    default: return "?";
+    }
+}
+
+const char* logCategoryName(LogCategory category)
+{
+    switch (category) {
+    case LogCategory::General: return "General";
+    case LogCategory::Vulkan: return "Vulkan";
+    case LogCategory::Window: return "GLFW";
+    case LogCategory::Render: return "Render";
+    case LogCategory::Assets: return "Assets";
+    case LogCategory::Save: return "Save";
+    case LogCategory::Alloc: return "Alloc";
+    default: return "?";
+    }
+}
+
+namespace logger {
+
+void start(const Config& config)
+{
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.lifecycle);
+    if (s.running.load()) return;
+
+    s.cells.reset(new Cell[kCapacity]);
+    for (size_t i = 0; i < kCapacity; ++i) s.cells[i].seq.store(i, std::memory_order_relaxed);
+    s.enqueue.store(0);
+    s.dequeue.store(0);
+    s.processed.store(0);
+    s.stop.store(false);
+    s.minLevel.store(static_cast<uint8_t>(config.minLevel));
+    s.blockWhenFull.store(config.blockWhenFull);
+    s.repeatLimit = config.repeatLimit;
+
+    s.out = stderr;
+    if (config.path) {
+        if (FILE* f = std::fopen(config.path, "w")) s.out = f;
+        else std::fprintf(stderr, "[Log] Failed to open %s - logging to stderr\n", config.path);
+    }
+    s.writer = std::thread(writerMain);
+    s.running.store(true, std::memory_order_release);
+}
+
+void stop()
+{
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.lifecycle);
+    if (!s.running.load()) return;
+    s.running.store(false, std::memory_order_release);
+    s.stop.store(true, std::memory_order_release);
+    wakeWriter(s);
+    s.writer.join();
+    if (s.out != stderr) std::fclose(s.out);
+    s.out = stderr;
+}
+
+void flush()
+{
+    State& s = state();
+    if (!s.running.load(std::memory_order_acquire)) {
+        std::fflush(stderr);
+        return;
+    }
+    const size_t target = s.enqueue.load(std::memory_order_acquire);
+    wakeWriter(s);
+    while (s.processed.load(std::memory_order_acquire) < target && s.running.load(std::memory_order_acquire))
+        std::this_thread::yield();
+}
+
+void setMinLevel(LogLevel level)
+{
+    state().minLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+void setCategoryEnabled(LogCategory category, bool enabled)
+{
+    const uint32_t bit = 1u << static_cast<uint32_t>(category);
+    if (enabled) state().categoryMask.fetch_or(bit, std::memory_order_relaxed);
+    else state().categoryMask.fetch_and(~bit, std::memory_order_relaxed);
+}
+
+bool enabled(LogLevel level, LogCategory category)
+{
+    const State& s = state();
+    return static_cast<uint8_t>(level) >= s.minLevel.load(std::memory_order_relaxed)
+        && (s.categoryMask.load(std::memory_order_relaxed) & (1u << static_cast<uint32_t>(category)));
+}
+
+Stats stats()
+{
+    const State& s = state();
+    return { s.written.load(std::memory_order_relaxed), s.dropped.load(std::memory_order_relaxed),
+        s.suppressed.load(std::memory_order_relaxed) };
+}
+
+namespace detail {
+
+bool running()
+{
+    return state().running.load(std::memory_order_acquire);
+}
+
+uint64_t now()
+{
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+Record* claim()
+{
+    State& s = state();
+    size_t pos = s.enqueue.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = s.cells[pos & (kCapacity - 1)];
+        const size_t seq = cell.seq.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (s.enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return &cell.record;
+        } else if (diff < 0) {
+            if (!s.blockWhenFull.load(std::memory_order_relaxed) || !s.running.load(std::memory_order_acquire)) {
+                s.dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            std::this_thread::yield();
+            pos = s.enqueue.load(std::memory_order_relaxed);
+        } else {
+            pos = s.enqueue.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void publish(Record* record)
+{
+    State& s = state();
+    Cell* cell = reinterpret_cast<Cell*>(record);
+    const size_t pos = cell->seq.load(std::memory_order_relaxed);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    // Pętla Dekkera z writerMain: albo wątek zapisu zobaczy rekord, albo my zobaczymy, że śpi
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (s.sleeping.load(std::memory_order_relaxed)) wakeWriter(s);
+}
+
+void writeNow(const Record& record)
+{
+    State& s = state();
+    std::string message;
+    format(record, message);
+    std::lock_guard<std::mutex> lock(s.direct);
+    writeLine(s, record, message);
+    s.written.fetch_add(1, std::memory_order_relaxed);
+}
+
+// printf po jednej konwersji: flagi, szerokość i precyzja z formatu, modyfikator długości
+// z typu zapisanego argumentu (%d dla int64, %u dla size_t itd. działają tak samo).
+void format(const Record& record, std::string& out)
+{
+    ArgReader args(record);
+    char spec[32];
+    for (const char* p = record.format; *p; ++p) {
+        if (*p != '%') {
+            out += *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            out += '%';
+            ++p;
+            continue;
+        }
+        const char* start = p++;
+        size_t n = 0;
+        spec[n++] = '%';
+        while (*p && std::strchr("-+ #0123456789.", *p) && n < sizeof(spec) - 4) spec[n++] = *p++;
+        while (*p && std::strchr("hlLqjzt", *p)) ++p;
+        const char conv = *p;
+        if (!conv) {
+            out.append(start);
+            break;
+        }
+        Arg a{};
+        if (!args.next(a)) {
+            out.append(start, p + 1);
+            continue;
+        }
+        const bool text = a.type == String;
+        switch (conv) {
+        case 'd': case 'i':
+            if (text) { out.append(a.text); break; }
+            std::memcpy(spec + n, "lld", 4);
+            appendf(out, spec, static_cast<long long>(a.asInt()));
+            break;
+        case 'u': case 'x': case 'X': case 'o':
+            if (text) { out.append(a.text); break; }
+            spec[n] = 'l'; spec[n + 1] = 'l'; spec[n + 2] = conv; spec[n + 3] = 0;
+            appendf(out, spec, static_cast<unsigned long long>(a.asInt()));
+            break;
+        case 'c':
+            if (text) { out.append(a.text); break; }
+            spec[n] = 'c'; spec[n + 1] = 0;
+            appendf(out, spec, static_cast<int>(a.asInt()));
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            if (text) { out.append(a.text); break; }
+            spec[n] = conv; spec[n + 1] = 0;
+            appendf(out, spec, a.asDouble());
+            break;
+        case 's':
+            if (!text) appendNatural(out, a);
+            else if (n == 1) out.append(a.text);
+            else {
+                spec[n] = 's'; spec[n + 1] = 0;
+                appendf(out, spec, std::string(a.text).c_str());
+            }
+            break;
+        default:
+            // %p i nieznane konwersje
+            appendNatural(out, a);
+            break;
+        }
+    }
+}
+
+} // namespace detail
+} // namespace logger
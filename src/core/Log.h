@@ -0,0 +1,156 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+enum class LogLevel : uint8_t { Verbose, Info, Warning, Error, Count };
+enum class LogCategory : uint8_t { General, Vulkan, Window, Render, Assets, Save, Alloc, Count };
+
+const char* logLevelName(LogLevel level);
+const char* logCategoryName(LogCategory category);
+
+// Logger asynchroniczny: wywołujący tylko rezerwuje slot w pierścieniu MPMC (jak InjectQueue
+// w JobSystem), kopiuje do niego format i argumenty binarnie i wraca - bez formatowania,
+// blokady i flushu. Wątek zapisu formatuje (printf) i pisze do stderr albo pliku.
+// Format musi żyć do końca programu (literał); napisy z argumentów są kopiowane.
+// Przed start() (i w narzędziach, które go nie wołają) wiadomości idą od razu na stderr.
+namespace logger {
+
+struct Config {
+    const char* path = nullptr;           // nullptr -> stderr
+    LogLevel minLevel = LogLevel::Info;
+    bool blockWhenFull = false;           // false: przy pełnym buforze wiadomość przepada (liczona)
+    uint32_t repeatLimit = 5;             // tyle identycznych wiadomości na sekundę, reszta zliczona; 0 = bez limitu
+};
+
+struct Stats {
+    uint64_t written = 0;
+    uint64_t dropped = 0;       // pełny bufor
+    uint64_t suppressed = 0;    // powtórzenia ponad repeatLimit
+};
+
+void start(const Config& config);
+void stop();     // zapisuje resztę i kończy wątek
+void flush();    // czeka, aż wszystko, co już zalogowano, trafi do pliku
+
+void setMinLevel(LogLevel level);
+void setCategoryEnabled(LogCategory category, bool enabled);
+bool enabled(LogLevel level, LogCategory category);
+Stats stats();
+
+namespace detail {
+
+enum ArgType : uint8_t { Int, Uint, Double, String, Pointer };
+
+constexpr size_t kRecordBytes = 1024;   // rekord z nagłówkiem; dłuższe napisy są obcinane
+
+struct Record {
+    uint64_t ticks;           // steady_clock
+    const char* format;
+    LogLevel level;
+    LogCategory category;
+    uint8_t argCount;
+    uint8_t truncated;
+    uint16_t size;            // zajęte bajty args
+    unsigned char args[kRecordBytes - 24];
+};
+static_assert(sizeof(Record) == kRecordBytes);
+
+bool running();               // wątek zapisu działa
+Record* claim();              // nullptr: bufor pełny i blockWhenFull == false (liczone jako dropped)
+void publish(Record* record);
+void writeNow(const Record& record);   // bez wątku zapisu: formatuje i pisze od razu
+uint64_t now();
+
+inline void put(Record& r, ArgType type, const void* data, size_t bytes)
+{
+    if (r.size + 1 + bytes > sizeof(r.args)) {
+        r.truncated = 1;
+        return;
+    }
+    r.args[r.size++] = type;
+    std::memcpy(r.args + r.size, data, bytes);
+    r.size = static_cast<uint16_t>(r.size + bytes);
+    ++r.argCount;
+}
+
+inline void encode(Record& r, std::string_view s)
+{
+    const size_t room = sizeof(r.args) - r.size;
+    if (room < 3) {
+        r.truncated = 1;
+        return;
+    }
+    uint16_t length = static_cast<uint16_t>(std::min(s.size(), room - 3));
+    if (length < s.size()) r.truncated = 1;
+    r.args[r.size++] = String;
+    std::memcpy(r.args + r.size, &length, sizeof(length));
+    std::memcpy(r.args + r.size + sizeof(length), s.data(), length);
+    r.size = static_cast<uint16_t>(r.size + sizeof(length) + length);
+    ++r.argCount;
+}
+
+template <typename T>
+void encode(Record& r, const T& value)
+{
+    if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        if constexpr (std::is_pointer_v<T>) {
+            if (!value) return encode(r, std::string_view("(null)"));
+        }
+        encode(r, std::string_view(value));
+    } else if constexpr (std::is_enum_v<T>) {
+        encode(r, static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        const double v = value;
+        put(r, Double, &v, sizeof(v));
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        const int64_t v = value;
+        put(r, Int, &v, sizeof(v));
+    } else if constexpr (std::is_integral_v<T>) {
+        const uint64_t v = value;
+        put(r, Uint, &v, sizeof(v));
+    } else {
+        static_assert(std::is_pointer_v<T>, "logger: unsupported argument type");
+        const uint64_t v = reinterpret_cast<uintptr_t>(value);
+        put(r, Pointer, &v, sizeof(v));
+    }
+}
+
+// Formatowanie rekordu (wątek zapisu, writeNow, testy)
+void format(const Record& record, std::string& out);
+
+} // namespace detail
+
+template <typename... Args>
+void write(LogLevel level, LogCategory category, const char* format, const Args&... args)
+{
+    if (!enabled(level, category)) return;
+    detail::Record local;
+    const bool queued = detail::running();
+    detail::Record* r = queued ? detail::claim() : &local;
+    if (!r) return;
+    r->ticks = detail::now();
+    r->format = format;
+    r->level = level;
+    r->category = category;
+    r->argCount = 0;
+    r->truncated = 0;
+    r->size = 0;
+    (detail::encode(*r, args), ...);
+    if (queued) detail::publish(r);
+    else detail::writeNow(*r);
+}
+
+template <typename... Args>
+void verbose(LogCategory category, const char* format, const Args&... args) { write(LogLevel::Verbose, category, format, args...); }
+template <typename... Args>
+void info(LogCategory category, const char* format, const Args&... args) { write(LogLevel::Info, category, format, args...); }
+template <typename... Args>
+void warning(LogCategory category, const char* format, const Args&... args) { write(LogLevel::Warning, category, format, args...); }
+template <typename... Args>
+void error(LogCategory category, const char* format, const Args&... args) { write(LogLevel::Error, category, format, args...); }
+
+} // namespace logger
@@ -0,0 +1,82 @@
+#include "RadixSort.h"
+#include "FrameArena.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace {
+constexpr uint32_t kRadix = 256;
+constexpr uint32_t kPasses = 8;
+constexpr size_t kSmallSort = 2048;    // poniżej tego std::sort jest szybszy (roguelike_bench drawsort)
+constexpr size_t kMinChunk = 8192;     // mniejsze fragmenty nie odrabiają kosztu zlecenia
+constexpr uint32_t kMaxChunks = 64;
+}
+
+void radixSort(std::span<uint64_t> keys, LinearArena& arena, JobSystem* jobs)
+{
+    const size_t n = keys.size();
+    if (n < 2) return;
+    if (n < kSmallSort) {
+        // Równe klucze są nieodróżnialne, więc brak stabilności std::sort nie ma znaczenia
+        std::sort(keys.begin(), keys.end());
+        return;
+    }
+
+    // Bity, które się różnią między kluczami - tylko ich cyfry wymagają przebiegu
+    uint64_t anyBits = 0, allBits = ~uint64_t(0);
+    for (uint64_t k : keys) {
+        anyBits |= k;
+        allBits &= k;
+    }
+    const uint64_t varying = anyBits ^ allBits;
+    if (!varying) return;
+
+    uint32_t chunks = 1;
+    if (jobs) chunks = static_cast<uint32_t>(std::clamp<size_t>(n / kMinChunk, 1, std::min(jobs->workerCount() + 1, kMaxChunks)));
+    const size_t chunkSize = (n + chunks - 1) / chunks;
+
+    const LinearArena::Marker marker = arena.mark();
+    uint64_t* scratch = arena.allocArray<uint64_t>(n);
+    uint32_t* counts = arena.allocArray<uint32_t>(size_t(chunks) * kRadix);
+
+    auto forChunks = [&](const auto& body) {
+        auto range = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t c = begin; c < end; ++c)
+                body(counts + size_t(c) * kRadix, size_t(c) * chunkSize, std::min(n, size_t(c + 1) * chunkSize));
+        };
+        if (chunks == 1) range(0, 1);
+        else jobs->parallelFor(0, chunks, 1, range);
+    };
+
+    uint64_t* src = keys.data();
+    uint64_t* dst = scratch;
+    for (uint32_t pass = 0; pass < kPasses; ++pass) {
+        const uint32_t shift = pass * 8;
+        if (((varying >> shift) & 0xFF) == 0) continue;
+
+        forChunks([&](uint32_t* hist, size_t begin, size_t end) {
+            std::fill(hist, hist + kRadix, 0u);
+            for (size_t i = begin; i < end; ++i) ++hist[(src[i] >> shift) & 0xFF];
+        });
+        // Offsety: kubełek po kubełku, w kubełku fragmenty w kolejności - stąd stabilność
+        uint32_t sum = 0;
+        for (uint32_t b = 0; b < kRadix; ++b) {
+            for (uint32_t c = 0; c < chunks; ++c) {
+                uint32_t& slot = counts[size_t(c) * kRadix + b];
+                const uint32_t count = slot;
+                slot = sum;
+                sum += count;
+            }
+        }
+        forChunks([&](uint32_t* offsets, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const uint64_t k = src[i];
+                dst[offsets[(k >> shift) & 0xFF]++] = k;
+            }
+        });
+        std::swap(src, dst);
+    }
+    if (src != keys.data()) std::memcpy(keys.data(), src, n * sizeof(uint64_t));
+    arena.rewind(marker);
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+class JobSystem;
+class LinearArena;
+
+// Sortowanie pozycyjne (LSD) kluczy 64-bit, 8 bitów na przebieg; małe tablice przez std::sort.
+// Przebiegi po cyfrach, które są takie same we wszystkich kluczach (np. nieużywane warstwy), są pomijane.
+// Bufor pomocniczy i histogramy bierze z areny (po powrocie jest cofnięta do stanu sprzed).
+// Z jobs: histogram i rozrzut każdego przebiegu dzielone na fragmenty między wątki - wynik
+// taki sam jak sekwencyjnie.
+void radixSort(std::span<uint64_t> keys, LinearArena& arena, JobSystem* jobs = nullptr);
@@ -0,0 +1,51 @@
+#include "RedrawScheduler.h"
+#include <algorithm>
+
+const char* RedrawScheduler::reasonName(uint32_t bit)
+{
+    switch (1u << bit) {
+    case Input: return "input";
+    case Animation: return "animation";
+    case Simulation: return "simulation";
+    case Interaction: return "interaction";
+    case Loading: return "loading";
+    default: return "?";
+    }
+}
+
+void RedrawScheduler::requestFrames(Reason why, uint32_t frames)
+{
+    frames_ = std::max(frames_, frames);
+    pending_ |= why;
+}
+
+void RedrawScheduler::wakeAt(double time, Reason why)
+{
+    if (time < wake_) {
+        wake_ = time;
+        wakeReasons_ = why;
+    } else if (time == wake_) {
+        wakeReasons_ |= why;
+    }
+}
+
+double RedrawScheduler::timeout(double now) const
+{
+    if (frameDue(now)) return 0.0;
+    return wake_ >= kNever ? kNever : wake_ - now;
+}
+
+void RedrawScheduler::beginFrame(double now)
+{
+    frameReasons_ = 0;
+    if (frames_ > 0) {
+        frameReasons_ |= pending_;
+        if (--frames_ == 0) pending_ = 0;
+    }
+    if (now >= wake_ - kWakeSlack) {
+        frameReasons_ |= wakeReasons_;
+        wake_ = kNever;
+        wakeReasons_ = 0;
+    }
+    ++rendered_;
+}
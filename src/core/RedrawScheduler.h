@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+
+// Tryb bezczynności: klatka powstaje tylko, gdy ktoś jej potrzebuje. Powody zamawiają klatki
+// (requestFrames - np. kilka po zdarzeniu, żeby ImGui zdążył odświeżyć hover i układ) albo
+// budzik na konkretną chwilę (wakeAt - następna klatka animacji). Poza tym pętla śpi
+// w glfwWaitEventsTimeout(timeout()). Czas w sekundach z jednego zegara (glfwGetTime).
+class RedrawScheduler {
+public:
+    enum Reason : uint32_t {
+        Input = 1u << 0,        // zdarzenie okna albo wejścia
+        Animation = 1u << 1,    // zmiana klatki sprite'a
+        Simulation = 1u << 2,   // zmiana stanu gry (ruch, wczytanie zapisu)
+        Interaction = 1u << 3,  // aktywny element UI (przeciąganie, pole tekstowe)
+        Loading = 1u << 4,      // tekstury w drodze na GPU
+        ReasonCount = 5,
+    };
+    static const char* reasonName(uint32_t bit);
+    static constexpr double kNever = 1e30;
+    // glfwWaitEventsTimeout potrafi wrócić odrobinę przed czasem - to nadal budzik, nie zdarzenie
+    static constexpr double kWakeSlack = 0.002;
+
+    void requestFrames(Reason why, uint32_t frames = 1);
+    void wakeAt(double time, Reason why);
+
+    bool frameDue(double now) const { return frames_ > 0 || now >= wake_ - kWakeSlack; }
+    // Ile spać (0 gdy klatka należy się już teraz, kNever gdy nic nie jest zaplanowane)
+    double timeout(double now) const;
+
+    // Na początku rysowanej klatki: zużywa zamówienie i budzik, zapamiętuje powody
+    void beginFrame(double now);
+
+    uint32_t frameReasons() const { return frameReasons_; }   // powody bieżącej klatki
+    uint64_t framesRendered() const { return rendered_; }
+    uint64_t waits() const { return waits_; }
+    void countWait() { ++waits_; }
+
+private:
+    uint32_t frames_ = 0;
+    uint32_t pending_ = 0;        // powody zamówionych klatek
+    double wake_ = kNever;
+    uint32_t wakeReasons_ = 0;
+    uint32_t frameReasons_ = 0;
+    uint64_t rendered_ = 0;
+    uint64_t waits_ = 0;
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+
+// Minimalna przenośna nakładka SIMD, 4 pasy: SSE2 (każdy x64), NEON (arm64, Apple Silicon),
+// inaczej zwykłe tablice - kompilator i tak je zwektoryzuje. Tylko operacje, których używają
+// pętle cząstek i mieszania światła; load/store bez wymagań wyrównania.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ROGUELIKE_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define ROGUELIKE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace simd {
+
+#if defined(ROGUELIKE_SIMD_SSE2)
+constexpr const char* kName = "SSE2";
+
+struct f32x4 { __m128 v; };
+struct u32x4 { __m128i v; };
+
+inline f32x4 load(const float* p) { return { _mm_loadu_ps(p) }; }
+inline void store(float* p, f32x4 a) { _mm_storeu_ps(p, a.v); }
+inline f32x4 splat(float s) { return { _mm_set1_ps(s) }; }
+inline f32x4 operator+(f32x4 a, f32x4 b) { return { _mm_add_ps(a.v, b.v) }; }
+inline f32x4 operator-(f32x4 a, f32x4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline f32x4 operator*(f32x4 a, f32x4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline f32x4 min(f32x4 a, f32x4 b) { return { _mm_min_ps(a.v, b.v) }; }
+inline f32x4 max(f32x4 a, f32x4 b) { return { _mm_max_ps(a.v, b.v) }; }
+// Bit i = pas i spełnia a > b
+inline uint32_t greaterMask(f32x4 a, f32x4 b) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpgt_ps(a.v, b.v))); }
+
+inline u32x4 load(const uint32_t* p) { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)) }; }
+inline void store(uint32_t* p, u32x4 a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a.v); }
+inline u32x4 splat(uint32_t s) { return { _mm_set1_epi32(static_cast<int>(s)) }; }
+inline u32x4 operator+(u32x4 a, u32x4 b) { return { _mm_add_epi32(a.v, b.v) }; }   // modulo 2^32
+inline u32x4 operator-(u32x4 a, u32x4 b) { return { _mm_sub_epi32(a.v, b.v) }; }
+inline u32x4 operator&(u32x4 a, u32x4 b) { return { _mm_and_si128(a.v, b.v) }; }
+inline u32x4 operator|(u32x4 a, u32x4 b) { return { _mm_or_si128(a.v, b.v) }; }
+template <int N> inline u32x4 shiftLeft(u32x4 a) { return { _mm_slli_epi32(a.v, N) }; }
+// Obcięcie do liczby całkowitej (wartości nieujemne)
+inline u32x4 toU32(f32x4 a) { return { _mm_cvttps_epi32(a.v) }; }
+
+#elif defined(ROGUELIKE_SIMD_NEON)
+constexpr const char* kName = "NEON";
+
+struct f32x4 { float32x4_t v; };
+struct u32x4 { uint32x4_t v; };
+
+inline f32x4 load(const float* p) { return { vld1q_f32(p) }; }
+inline void store(float* p, f32x4 a) { vst1q_f32(p, a.v); }
+inline f32x4 splat(float s) { return { vdupq_n_f32(s) }; }
+inline f32x4 operator+(f32x4 a, f32x4 b) { return { vaddq_f32(a.v, b.v) }; }
+inline f32x4 operator-(f32x4 a, f32x4 b) { return { vsubq_f32(a.v, b.v) }; }
+inline f32x4 operator*(f32x4 a, f32x4 b) { return { vmulq_f32(a.v, b.v) }; }
+inline f32x4 min(f32x4 a, f32x4 b) { return { vminq_f32(a.v, b.v) }; }
+inline f32x4 max(f32x4 a, f32x4 b) { return { vmaxq_f32(a.v, b.v) }; }
+inline uint32_t greaterMask(f32x4 a, f32x4 b)
+{
+    static const uint32_t kBits[4] = { 1, 2, 4, 8 };
+    return vaddvq_u32(vandq_u32(vcgtq_f32(a.v, b.v), vld1q_u32(kBits)));
+}
+
+inline u32x4 load(const uint32_t* p) { return { vld1q_u32(p) }; }
+inline void store(uint32_t* p, u32x4 a) { vst1q_u32(p, a.v); }
+inline u32x4 splat(uint32_t s) { return { vdupq_n_u32(s) }; }
+inline u32x4 operator+(u32x4 a, u32x4 b) { return { vaddq_u32(a.v, b.v) }; }
+inline u32x4 operator-(u32x4 a, u32x4 b) { return { vsubq_u32(a.v, b.v) }; }
+inline u32x4 operator&(u32x4 a, u32x4 b) { return { vandq_u32(a.v, b.v) }; }
+inline u32x4 operator|(u32x4 a, u32x4 b) { return { vorrq_u32(a.v, b.v) }; }
+template <int N> inline u32x4 shiftLeft(u32x4 a) { return { vshlq_n_u32(a.v, N) }; }
+inline u32x4 toU32(f32x4 a) { return { vcvtq_u32_f32(a.v) }; }
+
+#else
+constexpr const char* kName = "scalar";
+
+struct f32x4 { float v[4]; };
+struct u32x4 { uint32_t v[4]; };
+
+inline f32x4 load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void store(float* p, f32x4 a) { for (int i = 0; i < 4; ++i) p[i] = a.v[i]; }
+inline f32x4 splat(float s) { return { { s, s, s, s } }; }
+inline f32x4 operator+(f32x4 a, f32x4 b) { for (int i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+inline f32x4 operator-(f32x4 a, f32x4 b) { for (int i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+inline f32x4 operator*(f32x4 a, f32x4 b) { for (int i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+inline f32x4 min(f32x4 a, f32x4 b) { for (int i = 0; i < 4; ++i) a.v[i] = b.v[i] < a.v[i] ? b.v[i] : a.v[i]; return a; }
+inline f32x4 max(f32x4 a, f32x4 b) { for (int i = 0; i < 4; ++i) a.v[i] = b.v[i] > a.v[i] ? b.v[i] : a.v[i]; return a; }
+inline uint32_t greaterMask(f32x4 a, f32x4 b)
+{
+    uint32_t m = 0;
+    for (int i = 0; i < 4; ++i) m |= static_cast<uint32_t>(a.v[i] > b.v[i]) << i;
+    return m;
+}
+
+inline u32x4 load(const uint32_t* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void store(uint32_t* p, u32x4 a) { for (int i = 0; i < 4; ++i) p[i] = a.v[i]; }
+inline u32x4 splat(uint32_t s) { return { { s, s, s, s } }; }
+inline u32x4 operator+(u32x4 a, u32x4 b) { for (int i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+inline u32x4 operator-(u32x4 a, u32x4 b) { for (int i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+inline u32x4 operator&(u32x4 a, u32x4 b) { for (int i = 0; i < 4; ++i) a.v[i] &= b.v[i]; return a; }
+inline u32x4 operator|(u32x4 a, u32x4 b) { for (int i = 0; i < 4; ++i) a.v[i] |= b.v[i]; return a; }
+template <int N> inline u32x4 shiftLeft(u32x4 a) { for (int i = 0; i < 4; ++i) a.v[i] <<= N; return a; }
+inline u32x4 toU32(f32x4 a) { u32x4 r; for (int i = 0; i < 4; ++i) r.v[i] = static_cast<uint32_t>(a.v[i]); return r; }
+#endif
+
+} // namespace simd
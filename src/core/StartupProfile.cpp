@@ -0,0 +1,43 @@
+#include "StartupProfile.h"
+#include <algorithm>
+#include <cstdio>
+#include <ostream>
+
+void StartupProfile::start()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    t0_ = Clock::now();
+    mainThread_ = std::this_thread::get_id();
+}
+
+void StartupProfile::record(const char* name, Clock::time_point begin, Clock::time_point end)
+{
+    using Ms = std::chrono::duration<double, std::milli>;
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.push_back({ name, Ms(begin - t0_).count(), Ms(end - t0_).count(), std::this_thread::get_id() == mainThread_ });
+}
+
+double StartupProfile::elapsedMs() const
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0_).count();
+}
+
+void StartupProfile::print(std::ostream& out) const
+{
+    std::vector<Entry> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sorted = entries_;
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) { return a.beginMs < b.beginMs; });
+
+    out << "[Startup]     begin       end  duration  thread  phase\n";
+    char line[160];
+    for (const Entry& e : sorted) {
+        std::snprintf(line, sizeof(line), "[Startup] %9.1f %9.1f %9.1f  %-6s  %s\n",
+            e.beginMs, e.endMs, e.endMs - e.beginMs, e.mainThread ? "main" : "worker", e.name);
+        out << line;
+    }
+    out.flush();
+}
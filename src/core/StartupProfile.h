@@ -0,0 +1,43 @@
+#pragma once
+#include <chrono>
+#include <iosfwd>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Czasy faz startu (--startup-report). Fazy mogą się nakładać i biec na wątkach roboczych,
+// dlatego raport pokazuje początek i koniec każdej względem start(), a nie tylko długość.
+class StartupProfile {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void start();
+    void record(const char* name, Clock::time_point begin, Clock::time_point end);
+    void mark(const char* name) { const auto now = Clock::now(); record(name, now, now); }
+    double elapsedMs() const;
+    void print(std::ostream& out) const;
+
+    class Scope {
+    public:
+        Scope(StartupProfile& profile, const char* name) : profile_(profile), name_(name), begin_(Clock::now()) {}
+        ~Scope() { profile_.record(name_, begin_, Clock::now()); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        StartupProfile& profile_;
+        const char* name_;
+        Clock::time_point begin_;
+    };
+
+private:
+    struct Entry {
+        const char* name;
+        double beginMs;
+        double endMs;
+        bool mainThread;
+    };
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_;
+    Clock::time_point t0_ = Clock::now();
+    std::thread::id mainThread_ = std::this_thread::get_id();
+};
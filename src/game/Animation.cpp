@@ -0,0 +1,196 @@
+#include "Animation.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+// --- AnimationLibrary ---
+
+void AnimationLibrary::loadFromText(std::string_view text)
+{
+    std::istringstream in{ std::string(text) };
+    std::string line;
+    int lineNo = 0;
+    auto fail = [&](const std::string& what) {
+        throw std::runtime_error("animations:" + std::to_string(lineNo) + ": " + what);
+    };
+
+    while (std::getline(in, line)) {
+        ++lineNo;
+        std::istringstream ls(line);
+        std::string kind;
+        if (!(ls >> kind) || kind[0] == '#') continue;
+
+        if (kind == "sheet") {
+            SpriteSheet s;
+            if (!(ls >> s.name >> s.path >> s.frameWidth >> s.frameHeight) || !s.frameWidth || !s.frameHeight)
+                fail("expected: sheet <name> <path> <frameWidth> <frameHeight>");
+            if (findSheet(s.name) >= 0) fail("duplicate sheet " + s.name);
+            sheets_.push_back(std::move(s));
+        } else if (kind == "clip") {
+            AnimationClip c;
+            std::string sheet, mode;
+            float fps = 0.0f;
+            if (!(ls >> c.name >> sheet >> c.firstFrame >> c.frameCount >> fps >> mode) || !c.frameCount || fps <= 0.0f)
+                fail("expected: clip <name> <sheet> <first> <count> <fps> <loop|once>");
+            const int sheetId = findSheet(sheet);
+            if (sheetId < 0) fail("unknown sheet " + sheet);
+            if (mode != "loop" && mode != "once") fail("clip mode must be loop or once");
+            if (findClip(c.name) >= 0) fail("duplicate clip " + c.name);
+            c.sheet = static_cast<uint16_t>(sheetId);
+            c.frameDuration = 1.0f / fps;
+            c.loop = mode == "loop";
+            clips_.push_back(std::move(c));
+        } else {
+            fail("unknown entry " + kind);
+        }
+    }
+}
+
+void AnimationLibrary::loadFile(const std::string& path)
+{
+    std::ifstream f(path, std::ios::binary);
+    if (!f) throw std::runtime_error("Failed to open " + path);
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    loadFromText(ss.str());
+}
+
+int AnimationLibrary::findClip(std::string_view name) const
+{
+    for (size_t i = 0; i < clips_.size(); ++i)
+        if (clips_[i].name == name) return static_cast<int>(i);
+    return -1;
+}
+
+int AnimationLibrary::findSheet(std::string_view name) const
+{
+    for (size_t i = 0; i < sheets_.size(); ++i)
+        if (sheets_[i].name == name) return static_cast<int>(i);
+    return -1;
+}
+
+FrameRect frameRect(const SpriteSheet& sheet, uint32_t frame, uint32_t textureWidth, uint32_t textureHeight)
+{
+    const uint32_t columns = std::max(1u, textureWidth / sheet.frameWidth);
+    const float du = 1.0f / static_cast<float>(textureWidth);
+    const float dv = 1.0f / static_cast<float>(textureHeight);
+    const float x = static_cast<float>((frame % columns) * sheet.frameWidth);
+    const float y = static_cast<float>((frame / columns) * sheet.frameHeight);
+    return { (x + 0.5f) * du, (y + 0.5f) * dv,
+             (x + sheet.frameWidth - 0.5f) * du, (y + sheet.frameHeight - 0.5f) * dv };
+}
+
+// --- Animator ---
+
+Animator::Id Animator::add(uint16_t clip, float startTime)
+{
+    Id id;
+    if (!freeIds_.empty()) { id = freeIds_.back(); freeIds_.pop_back(); }
+    else { id = static_cast<Id>(dense_.size()); dense_.push_back(kInvalid); }
+
+    const uint32_t index = static_cast<uint32_t>(clip_.size());
+    dense_[id] = index;
+    owner_.push_back(id);
+    timer_.push_back(0.0f);
+    duration_.push_back(0.0f);
+    invDuration_.push_back(0.0f);
+    frame_.push_back(0);
+    count_.push_back(0);
+    first_.push_back(0);
+    loop_.push_back(0);
+    clip_.push_back(0);
+    assignClip(index, clip);
+
+    // Przesunięcie fazy, żeby stado potworów nie machało skrzydłami równo
+    const float d = duration_[index];
+    const float steps = std::floor(startTime / d);
+    timer_[index] = startTime - steps * d;
+    frame_[index] = loop_[index] ? static_cast<int32_t>(static_cast<int64_t>(steps) % count_[index])
+                                 : std::min(static_cast<int32_t>(steps), count_[index] - 1);
+    return id;
+}
+
+void Animator::remove(Id id)
+{
+    if (!alive(id)) return;
+    const uint32_t index = dense_[id];
+    const uint32_t last = static_cast<uint32_t>(clip_.size() - 1);
+    if (index != last) {
+        timer_[index] = timer_[last];
+        duration_[index] = duration_[last];
+        invDuration_[index] = invDuration_[last];
+        frame_[index] = frame_[last];
+        count_[index] = count_[last];
+        first_[index] = first_[last];
+        loop_[index] = loop_[last];
+        clip_[index] = clip_[last];
+        owner_[index] = owner_[last];
+        dense_[owner_[index]] = index;
+    }
+    timer_.pop_back();
+    duration_.pop_back();
+    invDuration_.pop_back();
+    frame_.pop_back();
+    count_.pop_back();
+    first_.pop_back();
+    loop_.pop_back();
+    clip_.pop_back();
+    owner_.pop_back();
+    dense_[id] = kInvalid;
+    freeIds_.push_back(id);
+}
+
+void Animator::play(Id id, uint16_t clip, bool restart)
+{
+    const uint32_t index = dense_[id];
+    if (!restart && clip_[index] == clip) return;
+    assignClip(index, clip);
+    timer_[index] = 0.0f;
+    frame_[index] = 0;
+}
+
+void Animator::assignClip(uint32_t index, uint16_t clip)
+{
+    const AnimationClip& c = library_.clip(clip);
+    clip_[index] = clip;
+    duration_[index] = c.frameDuration;
+    invDuration_[index] = 1.0f / c.frameDuration;
+    count_[index] = c.frameCount;
+    first_[index] = c.firstFrame;
+    loop_[index] = c.loop ? 1 : 0;
+}
+
+void Animator::update(float dt)
+{
+    // Osobne wektory nigdy się nie nakładają - __restrict oszczędza kompilatorowi
+    // sprawdzania aliasów przed wersją wektorową
+    const size_t n = clip_.size();
+    float* __restrict timer = timer_.data();
+    const float* __restrict duration = duration_.data();
+    const float* __restrict invDuration = invDuration_.data();
+    int32_t* __restrict frame = frame_.data();
+    const int32_t* __restrict count = count_.data();
+    const int32_t* __restrict loop = loop_.data();
+
+    // Bez skoków i dzielenia całkowitego: o ile klatek przesunąć (najwyżej count, czyli pełny
+    // obieg), potem jedno zawinięcie albo zatrzymanie na ostatniej klatce - same selekcje.
+    for (size_t i = 0; i < n; ++i) {
+        const float t = timer[i] + dt;
+        const int32_t adv = std::min(static_cast<int32_t>(t * invDuration[i]), count[i]);
+        timer[i] = t - static_cast<float>(adv) * duration[i];
+        const int32_t f = frame[i] + adv;
+        const int32_t wrapped = loop[i] ? f - count[i] : count[i] - 1;
+        frame[i] = f < count[i] ? f : wrapped;
+    }
+}
+
+float Animator::timeToNextFrame() const
+{
+    float next = std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < clip_.size(); ++i)
+        if (loop_[i] || frame_[i] < count_[i] - 1) next = std::min(next, duration_[i] - timer_[i]);
+    return std::max(next, 0.0f);
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Arkusz sprite'ów: jedna tekstura, klatki w siatce frameWidth x frameHeight (wierszami od lewej)
+struct SpriteSheet {
+    std::string name;
+    std::string path;
+    uint32_t frameWidth = 0;
+    uint32_t frameHeight = 0;
+};
+
+struct AnimationClip {
+    std::string name;
+    uint16_t sheet = 0;
+    uint16_t firstFrame = 0;
+    uint16_t frameCount = 1;
+    float frameDuration = 0.1f;   // sekundy
+    bool loop = true;
+};
+
+// Prostokąt UV klatki w teksturze arkusza, zwężony o pół teksela - filtr liniowy nie
+// podciąga pikseli sąsiedniej klatki
+struct FrameRect { float u0, v0, u1, v1; };
+FrameRect frameRect(const SpriteSheet& sheet, uint32_t frame, uint32_t textureWidth, uint32_t textureHeight);
+
+// Arkusze i klipy wczytane z pliku tekstowego (assets/animations.txt):
+//   sheet <nazwa> <plik png> <szer. klatki> <wys. klatki>
+//   clip <nazwa> <arkusz> <pierwsza klatka> <liczba klatek> <fps> <loop|once>
+class AnimationLibrary {
+public:
+    void loadFromText(std::string_view text);   // wyjątek z numerem linii przy błędzie
+    void loadFile(const std::string& path);
+
+    const std::vector<SpriteSheet>& sheets() const { return sheets_; }
+    const std::vector<AnimationClip>& clips() const { return clips_; }
+    const AnimationClip& clip(uint16_t id) const { return clips_[id]; }
+    int findClip(std::string_view name) const;   // -1 gdy brak
+    int findSheet(std::string_view name) const;
+
+private:
+    std::vector<SpriteSheet> sheets_;
+    std::vector<AnimationClip> clips_;
+};
+
+// Stan animacji wszystkich instancji w ciasnych tablicach (SoA, bez dziur - usuwanie przez zamianę
+// z ostatnim). Parametry klipu są skopiowane do instancji, więc update() to jedna pętla po
+// tablicach bez odwołań do biblioteki, którą kompilator wektoryzuje.
+class Animator {
+public:
+    using Id = uint32_t;
+    static constexpr Id kInvalid = UINT32_MAX;
+
+    explicit Animator(const AnimationLibrary& library) : library_(library) {}
+    const AnimationLibrary& library() const { return library_; }
+
+    Id add(uint16_t clip, float startTime = 0.0f);
+    void remove(Id id);
+    bool alive(Id id) const { return id < dense_.size() && dense_[id] != kInvalid; }
+
+    // restart == false: ten sam klip gra dalej bez przeskoku
+    void play(Id id, uint16_t clip, bool restart = false);
+    void update(float dt);
+    // Czas do najbliższej zmiany klatki którejkolwiek animacji (nieskończoność, gdy wszystkie
+    // stoją na ostatniej klatce) - tryb bezczynności budzi się dopiero wtedy
+    float timeToNextFrame() const;
+
+    uint16_t clip(Id id) const { return clip_[dense_[id]]; }
+    // Klatka w arkuszu (firstFrame + bieżąca)
+    uint32_t frame(Id id) const { const uint32_t i = dense_[id]; return static_cast<uint32_t>(first_[i] + frame_[i]); }
+    size_t size() const { return clip_.size(); }
+
+private:
+    const AnimationLibrary& library_;
+
+    // Indeksowane pozycją w tablicy gęstej
+    std::vector<float> timer_;
+    std::vector<float> duration_;
+    std::vector<float> invDuration_;
+    std::vector<int32_t> frame_;
+    std::vector<int32_t> count_;
+    std::vector<int32_t> first_;
+    std::vector<int32_t> loop_;
+    std::vector<uint16_t> clip_;
+    std::vector<Id> owner_;        // pozycja -> Id
+
+    std::vector<uint32_t> dense_;  // Id -> pozycja (kInvalid = wolne)
+    std::vector<Id> freeIds_;
+
+    void assignClip(uint32_t index, uint16_t clip);
+};
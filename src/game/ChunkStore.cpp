@@ -0,0 +1,450 @@
+#include "ChunkStore.h"
+#include "core/Log.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace {
+
+// Pula zwolnionych buforów surowych - tyle mniej więcej ma obszar skupienia
+constexpr size_t kMaxFreeRaw = 16;
+
+bool uniform(const uint8_t* data)
+{
+    return std::all_of(data, data + ChunkStore::kChunkBytes, [&](uint8_t b) { return b == data[0]; });
+}
+
+// Dane chunku: kChunkBytes bajtów to kopia bez kompresji (RLE wyszłoby większe), mniej - RLE
+void decode(std::span<const uint8_t> data, uint8_t* out)
+{
+    if (data.size() == ChunkStore::kChunkBytes) {
+        std::memcpy(out, data.data(), ChunkStore::kChunkBytes);
+        return;
+    }
+    if (!rleDecompress(data, { out, ChunkStore::kChunkBytes }))
+        throw std::runtime_error("Corrupted chunk data");
+}
+
+}
+
+void rleCompress(std::span<const uint8_t> in, std::vector<uint8_t>& out)
+{
+    out.clear();
+    for (size_t i = 0; i < in.size();) {
+        const uint8_t value = in[i];
+        size_t run = 1;
+        while (run < 256 && i + run < in.size() && in[i + run] == value) ++run;
+        out.push_back(static_cast<uint8_t>(run - 1));
+        out.push_back(value);
+        i += run;
+    }
+}
+
+bool rleDecompress(std::span<const uint8_t> in, std::span<uint8_t> out)
+{
+    if (in.size() % 2) return false;
+    size_t pos = 0;
+    for (size_t i = 0; i < in.size(); i += 2) {
+        const size_t run = size_t(in[i]) + 1;
+        if (pos + run > out.size()) return false;
+        std::memset(out.data() + pos, in[i + 1], run);
+        pos += run;
+    }
+    return pos == out.size();
+}
+
+ChunkStore::ChunkStore(Config config)
+    : config_(std::move(config))
+{
+    swap_.open(config_.swapPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!swap_) throw std::runtime_error("Failed to open swap file " + config_.swapPath);
+    io_ = std::thread([this] { ioMain(); });
+}
+
+ChunkStore::~ChunkStore()
+{
+    {
+        std::lock_guard lock(queueMutex_);
+        stop_ = true;
+    }
+    queueCv_.notify_all();
+    io_.join();
+    swap_.close();
+    std::error_code ec;
+    std::filesystem::remove(config_.swapPath, ec);
+}
+
+ChunkStore::Stats ChunkStore::stats() const
+{
+    Stats s = stats_;
+    s.residentBytes = uint64_t(s.rawChunks) * kChunkBytes + compressedBytes_;
+    s.swapBytes = uint64_t(slotCount_ - freeSlots_.size()) * kChunkBytes;
+    return s;
+}
+
+void ChunkStore::count(const Chunk& c, int delta)
+{
+    switch (c.state) {
+    case State::Raw: stats_.rawChunks += delta; break;
+    case State::Compressed: (c.uniform ? stats_.uniformChunks : stats_.compressedChunks) += delta; break;
+    case State::Paged:
+    case State::Loading: stats_.pagedChunks += delta; break;
+    }
+}
+
+bool ChunkStore::inFocus(uint64_t k) const
+{
+    const int cx = int(k & 0xffff), cy = int((k >> 16) & 0xffff);
+    return uint32_t(k >> 32) == focusLevel_ && cx >= focusX0_ && cx <= focusX1_ && cy >= focusY0_ && cy <= focusY1_;
+}
+
+ChunkStore::Chunk* ChunkStore::find(uint32_t level, int x, int y)
+{
+    auto it = chunks_.find(key(level, x / kChunkSize, y / kChunkSize));
+    return it == chunks_.end() ? nullptr : &it->second;
+}
+
+ChunkStore::Chunk& ChunkStore::create(uint64_t k)
+{
+    Chunk& c = chunks_[k];
+    c.state = State::Compressed;
+    c.uniform = true;
+    c.value = config_.fill;
+    count(c, +1);
+    return c;
+}
+
+uint8_t ChunkStore::get(uint32_t level, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= kChunkSize * 0x10000 || y >= kChunkSize * 0x10000) return config_.fill;
+    Chunk* c = find(level, x, y);
+    if (!c) return config_.fill;
+    c->lastUse = ++clock_;
+    const size_t local = size_t(y % kChunkSize) * kChunkSize + x % kChunkSize;
+    if (c->state == State::Raw) return c->raw[local];
+    if (c->state == State::Compressed && c->uniform) return c->value;
+    return makeRaw(key(level, x / kChunkSize, y / kChunkSize), *c)[local];
+}
+
+void ChunkStore::set(uint32_t level, int x, int y, uint8_t value)
+{
+    if (x < 0 || y < 0 || x >= kChunkSize * 0x10000 || y >= kChunkSize * 0x10000)
+        throw std::runtime_error("Chunk store coordinates out of range");
+    const uint64_t k = key(level, x / kChunkSize, y / kChunkSize);
+    auto it = chunks_.find(k);
+    if (it == chunks_.end() && value == config_.fill) return;   // i tak czyta się jako fill
+    Chunk& c = it == chunks_.end() ? create(k) : it->second;
+    c.lastUse = ++clock_;
+    makeRaw(k, c)[size_t(y % kChunkSize) * kChunkSize + x % kChunkSize] = value;
+
+    LevelInfo& info = levels_[level];
+    info.width = std::max(info.width, x + 1);
+    info.height = std::max(info.height, y + 1);
+}
+
+void ChunkStore::pageIn(Chunk& c)
+{
+    count(c, -1);
+    readSlot(c.slot, c.packedSize, c.packed);
+    releaseSlot(c);
+    ++c.generation;   // wczytanie w tle, jeśli jeszcze trwa, zostanie odrzucone
+    c.state = State::Compressed;
+    compressedBytes_ += c.packed.size();
+    count(c, +1);
+    ++stats_.blockingLoads;
+}
+
+uint8_t* ChunkStore::makeRaw(uint64_t k, Chunk& c)
+{
+    if (c.state == State::Raw) return c.raw.get();
+    if (c.state == State::Paged || c.state == State::Loading) pageIn(c);
+
+    std::unique_ptr<uint8_t[]> raw;
+    if (!freeRaw_.empty()) {
+        raw = std::move(freeRaw_.back());
+        freeRaw_.pop_back();
+    } else {
+        raw = std::make_unique<uint8_t[]>(kChunkBytes);
+    }
+    if (c.uniform) std::memset(raw.get(), c.value, kChunkBytes);
+    else decode(c.packed, raw.get());
+
+    count(c, -1);
+    compressedBytes_ -= c.packed.size();
+    std::vector<uint8_t>().swap(c.packed);
+    c.uniform = false;
+    c.raw = std::move(raw);
+    c.state = State::Raw;
+    count(c, +1);
+    rawKeys_.push_back(k);
+    return c.raw.get();
+}
+
+const uint8_t* ChunkStore::view(Chunk& c, uint8_t* tmp)
+{
+    if (c.state == State::Raw) return c.raw.get();
+    if (c.state == State::Paged || c.state == State::Loading) pageIn(c);
+    if (c.uniform) std::memset(tmp, c.value, kChunkBytes);
+    else decode(c.packed, tmp);
+    return tmp;
+}
+
+void ChunkStore::pack(Chunk& c, const uint8_t* data)
+{
+    if (uniform(data)) {
+        c.uniform = true;
+        c.value = data[0];
+    } else {
+        rleCompress({ data, kChunkBytes }, scratch_);
+        if (scratch_.size() < kChunkBytes) c.packed.assign(scratch_.begin(), scratch_.end());
+        else c.packed.assign(data, data + kChunkBytes);
+        compressedBytes_ += c.packed.size();
+    }
+    c.state = State::Compressed;
+}
+
+void ChunkStore::compress(Chunk& c)
+{
+    count(c, -1);
+    pack(c, c.raw.get());
+    if (freeRaw_.size() < kMaxFreeRaw) freeRaw_.push_back(std::move(c.raw));
+    c.raw.reset();
+    count(c, +1);
+}
+
+// Zostawia pusty chunk (Compressed, bez danych) - wywołujący od razu go wypełnia
+void ChunkStore::drop(Chunk& c)
+{
+    count(c, -1);
+    if (c.state == State::Paged || c.state == State::Loading) {
+        releaseSlot(c);
+        ++c.generation;
+    }
+    if (c.raw && freeRaw_.size() < kMaxFreeRaw) freeRaw_.push_back(std::move(c.raw));
+    c.raw.reset();
+    compressedBytes_ -= c.packed.size();
+    std::vector<uint8_t>().swap(c.packed);
+    c.uniform = false;
+    c.state = State::Compressed;
+}
+
+void ChunkStore::pageOut(Chunk& c)
+{
+    uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = slotCount_++;
+    }
+    {
+        std::lock_guard lock(fileMutex_);
+        swap_.seekp(std::streamoff(slot) * std::streamoff(kChunkBytes));
+        swap_.write(reinterpret_cast<const char*>(c.packed.data()), std::streamsize(c.packed.size()));
+        if (!swap_) throw std::runtime_error("Failed to write swap file " + config_.swapPath);
+    }
+    count(c, -1);
+    c.slot = slot;
+    c.packedSize = static_cast<uint16_t>(c.packed.size());
+    ++c.generation;
+    compressedBytes_ -= c.packed.size();
+    std::vector<uint8_t>().swap(c.packed);
+    c.state = State::Paged;
+    count(c, +1);
+    ++stats_.pageOuts;
+}
+
+void ChunkStore::readSlot(uint32_t slot, uint16_t size, std::vector<uint8_t>& out)
+{
+    out.resize(size);
+    std::lock_guard lock(fileMutex_);
+    swap_.seekg(std::streamoff(slot) * std::streamoff(kChunkBytes));
+    swap_.read(reinterpret_cast<char*>(out.data()), size);
+    if (!swap_) {
+        swap_.clear();
+        throw std::runtime_error("Failed to read swap file " + config_.swapPath);
+    }
+}
+
+void ChunkStore::releaseSlot(Chunk& c)
+{
+    freeSlots_.push_back(c.slot);
+}
+
+void ChunkStore::storeLevel(uint32_t level, const TileMap& tiles)
+{
+    levels_[level] = { tiles.width(), tiles.height() };
+    uint8_t buf[kChunkBytes];
+    for (int cy = 0; cy * kChunkSize < tiles.height(); ++cy) {
+        for (int cx = 0; cx * kChunkSize < tiles.width(); ++cx) {
+            const int x0 = cx * kChunkSize, y0 = cy * kChunkSize;
+            const int w = std::min(kChunkSize, tiles.width() - x0);
+            std::memset(buf, config_.fill, sizeof(buf));
+            for (int r = 0; r < kChunkSize && y0 + r < tiles.height(); ++r)
+                std::memcpy(buf + r * kChunkSize, tiles.data() + size_t(y0 + r) * tiles.width() + x0, w);
+
+            const uint64_t k = key(level, cx, cy);
+            auto it = chunks_.find(k);
+            if (it == chunks_.end()) {
+                if (uniform(buf) && buf[0] == config_.fill) continue;
+                it = chunks_.try_emplace(k).first;
+            } else {
+                drop(it->second);
+            }
+            Chunk& c = it->second;
+            c.lastUse = ++clock_;
+            pack(c, buf);
+            count(c, +1);
+        }
+    }
+}
+
+bool ChunkStore::loadLevel(uint32_t level, TileMap& out)
+{
+    auto info = levels_.find(level);
+    if (info == levels_.end()) return false;
+    const int width = info->second.width, height = info->second.height;
+    std::vector<uint8_t> tiles(size_t(width) * height, config_.fill);
+    uint8_t buf[kChunkBytes];
+    for (int cy = 0; cy * kChunkSize < height; ++cy) {
+        for (int cx = 0; cx * kChunkSize < width; ++cx) {
+            auto it = chunks_.find(key(level, cx, cy));
+            if (it == chunks_.end()) continue;
+            it->second.lastUse = ++clock_;
+            const uint8_t* data = view(it->second, buf);
+            const int x0 = cx * kChunkSize, y0 = cy * kChunkSize;
+            const int w = std::min(kChunkSize, width - x0);
+            for (int r = 0; r < kChunkSize && y0 + r < height; ++r)
+                std::memcpy(tiles.data() + size_t(y0 + r) * width + x0, data + r * kChunkSize, w);
+        }
+    }
+    out.assign(width, height, tiles.data());
+    return true;
+}
+
+void ChunkStore::setFocus(uint32_t level, int x, int y, int radius)
+{
+    focusLevel_ = level;
+    focusX0_ = std::max(0, x) / kChunkSize - radius;
+    focusY0_ = std::max(0, y) / kChunkSize - radius;
+    focusX1_ = std::max(0, x) / kChunkSize + radius;
+    focusY1_ = std::max(0, y) / kChunkSize + radius;
+}
+
+void ChunkStore::prefetchLevel(uint32_t level)
+{
+    auto info = levels_.find(level);
+    if (info == levels_.end()) return;
+    std::vector<LoadRequest> batch;
+    for (int cy = 0; cy * kChunkSize < info->second.height; ++cy) {
+        for (int cx = 0; cx * kChunkSize < info->second.width; ++cx) {
+            const uint64_t k = key(level, cx, cy);
+            auto it = chunks_.find(k);
+            if (it == chunks_.end() || it->second.state != State::Paged) continue;
+            Chunk& c = it->second;
+            c.state = State::Loading;   // licznik pagedChunks obejmuje oba stany
+            c.lastUse = ++clock_;
+            batch.push_back({ k, c.slot, c.generation, c.packedSize });
+        }
+    }
+    if (batch.empty()) return;
+    {
+        std::lock_guard lock(queueMutex_);
+        requests_.insert(requests_.end(), batch.begin(), batch.end());
+        inFlight_ += static_cast<uint32_t>(batch.size());
+    }
+    queueCv_.notify_one();
+}
+
+void ChunkStore::collectLoaded()
+{
+    std::vector<Loaded> done;
+    {
+        std::lock_guard lock(queueMutex_);
+        done.swap(loaded_);
+    }
+    for (Loaded& l : done) {
+        auto it = chunks_.find(l.key);
+        if (it == chunks_.end()) continue;
+        Chunk& c = it->second;
+        // Inna generacja: chunk w międzyczasie wczytany synchronicznie, nadpisany albo zrzucony ponownie
+        if (c.state != State::Loading || c.generation != l.generation) continue;
+        if (l.data.size() != c.packedSize) {
+            c.state = State::Paged;   // błąd odczytu - przy potrzebie wczytanie synchroniczne rzuci wyjątek
+            continue;
+        }
+        count(c, -1);
+        c.packed = std::move(l.data);
+        releaseSlot(c);
+        c.state = State::Compressed;
+        compressedBytes_ += c.packed.size();
+        count(c, +1);
+        ++stats_.backgroundLoads;
+    }
+}
+
+void ChunkStore::waitLoads()
+{
+    {
+        std::unique_lock lock(queueMutex_);
+        doneCv_.wait(lock, [this] { return inFlight_ == 0; });
+    }
+    collectLoaded();
+}
+
+void ChunkStore::maintain()
+{
+    collectLoaded();
+
+    // Surowe spoza skupienia do RLE; na liście mogą być duplikaty i chunki już nie surowe
+    std::sort(rawKeys_.begin(), rawKeys_.end());
+    rawKeys_.erase(std::unique(rawKeys_.begin(), rawKeys_.end()), rawKeys_.end());
+    std::erase_if(rawKeys_, [this](uint64_t k) {
+        auto it = chunks_.find(k);
+        if (it == chunks_.end() || it->second.state != State::Raw) return true;
+        if (inFocus(k)) return false;
+        compress(it->second);
+        return true;
+    });
+
+    if (compressedBytes_ <= config_.compressedBudget) return;
+    std::vector<std::pair<uint64_t, Chunk*>> candidates;
+    for (auto& [k, c] : chunks_) {
+        if (c.state == State::Compressed && !c.uniform && !inFocus(k)) candidates.emplace_back(c.lastUse, &c);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (auto& [lastUse, c] : candidates) {
+        if (compressedBytes_ <= config_.compressedBudget) break;
+        pageOut(*c);
+    }
+}
+
+void ChunkStore::ioMain()
+{
+    std::vector<LoadRequest> batch;
+    for (;;) {
+        {
+            std::unique_lock lock(queueMutex_);
+            queueCv_.wait(lock, [this] { return stop_ || !requests_.empty(); });
+            if (stop_) return;
+            batch.swap(requests_);
+        }
+        for (const LoadRequest& r : batch) {
+            Loaded l{ r.key, r.generation, {} };
+            try {
+                readSlot(r.slot, r.size, l.data);
+            } catch (const std::exception& e) {
+                logger::error(LogCategory::General, "Chunk load failed: %s", e.what());
+                l.data.clear();
+            }
+            {
+                std::lock_guard lock(queueMutex_);
+                loaded_.push_back(std::move(l));
+                --inFlight_;
+            }
+            doneCv_.notify_all();
+        }
+        batch.clear();
+    }
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include "TileMap.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// RLE bajtów kafli: pary (długość - 1, wartość), seria do 256. Kafle to kilka wartości w długich
+// ciągach, więc chunk pusty albo z kilkoma ścianami zajmuje kilkadziesiąt bajtów.
+void rleCompress(std::span<const uint8_t> in, std::vector<uint8_t>& out);
+bool rleDecompress(std::span<const uint8_t> in, std::span<uint8_t> out);   // false: dane nie pasują do rozmiaru
+
+// Rzadki magazyn kafli wielu poziomów w chunkach 32x32 (jak w zapisie gry). Chunk powstaje dopiero
+// przy zapisie; brakujący czyta się jako fill. Stany chunku:
+//  - surowy: 1 KB, tylko w obszarze skupienia (setFocus) - reszta jest kompresowana w maintain(),
+//  - skompresowany (RLE) w pamięci; jednolity chunk to sam bajt wartości, bez danych,
+//  - na dysku: gdy skompresowane przekroczą budżet, najdawniej używane idą do pliku wymiany
+//    (sloty po 1 KB, zwalniane przy wczytaniu), a prefetch wczytuje je z powrotem w wątku I/O.
+// Pamięć = obszar skupienia + budżet + kilkadziesiąt bajtów metadanych na chunk, niezależnie
+// od liczby poziomów. Dostęp tylko z jednego wątku (gry); wątek I/O ma własne kolejki.
+class ChunkStore {
+public:
+    static constexpr int kChunkSize = 32;
+    static constexpr size_t kChunkBytes = static_cast<size_t>(kChunkSize) * kChunkSize;
+
+    struct Config {
+        std::string swapPath;                   // plik wymiany, usuwany w destruktorze
+        size_t compressedBudget = 4u << 20;     // bajty skompresowanych chunków w pamięci
+        uint8_t fill = TileWall;
+    };
+
+    struct Stats {
+        uint32_t rawChunks = 0;
+        uint32_t compressedChunks = 0;   // z danymi RLE
+        uint32_t uniformChunks = 0;
+        uint32_t pagedChunks = 0;        // na dysku (także w trakcie wczytywania)
+        uint64_t residentBytes = 0;      // surowe + skompresowane
+        uint64_t swapBytes = 0;          // zajęte sloty pliku wymiany
+        uint64_t pageOuts = 0;
+        uint64_t backgroundLoads = 0;
+        uint64_t blockingLoads = 0;      // chunk potrzebny, zanim prefetch zdążył
+    };
+
+    explicit ChunkStore(Config config);
+    ~ChunkStore();
+
+    ChunkStore(const ChunkStore&) = delete;
+    ChunkStore& operator=(const ChunkStore&) = delete;
+
+    uint8_t get(uint32_t level, int x, int y);
+    void set(uint32_t level, int x, int y, uint8_t value);
+
+    // Cały poziom z/do płaskiej mapy (zmiana poziomu). Chunki jednolite wartości fill nie są tworzone.
+    void storeLevel(uint32_t level, const TileMap& tiles);
+    bool loadLevel(uint32_t level, TileMap& out);
+    bool hasLevel(uint32_t level) const { return levels_.count(level) != 0; }
+
+    // Surowe zostają tylko chunki poziomu level w promieniu radius chunków od kafla (x, y)
+    void setFocus(uint32_t level, int x, int y, int radius);
+    // Wczytanie w tle chunków poziomu zapisanych na dysku (np. sąsiednich pięter)
+    void prefetchLevel(uint32_t level);
+    // Raz na turę/zmianę poziomu: odbiera wczytane w tle, kompresuje chunki spoza skupienia,
+    // zrzuca na dysk najdawniej używane ponad budżet
+    void maintain();
+    // Czeka na wszystkie wczytania w tle (testy, benchmarki, zamknięcie)
+    void waitLoads();
+
+    Stats stats() const;
+
+private:
+    enum class State : uint8_t { Raw, Compressed, Paged, Loading };
+
+    struct Chunk {
+        State state = State::Raw;
+        bool uniform = false;     // Compressed bez danych: cały chunk = value
+        uint8_t value = 0;
+        uint16_t packedSize = 0;  // Paged/Loading: bajty w slocie (kChunkBytes = bez kompresji)
+        uint32_t slot = 0;
+        uint32_t generation = 0;  // rośnie przy każdym zrzucie - stare wczytania są odrzucane
+        uint64_t lastUse = 0;
+        std::unique_ptr<uint8_t[]> raw;
+        std::vector<uint8_t> packed;
+    };
+
+    struct LevelInfo {
+        int width = 0;
+        int height = 0;
+    };
+
+    struct LoadRequest {
+        uint64_t key;
+        uint32_t slot;
+        uint32_t generation;
+        uint16_t size;
+    };
+    struct Loaded {
+        uint64_t key;
+        uint32_t generation;
+        std::vector<uint8_t> data;
+    };
+
+    Config config_;
+    std::unordered_map<uint64_t, Chunk> chunks_;
+    std::unordered_map<uint32_t, LevelInfo> levels_;
+    std::vector<uint64_t> rawKeys_;                    // chunki w stanie Raw (kandydaci do kompresji)
+    std::vector<std::unique_ptr<uint8_t[]>> freeRaw_;
+    std::vector<uint8_t> scratch_;
+    uint64_t clock_ = 0;
+    uint64_t compressedBytes_ = 0;
+    Stats stats_;   // liczniki stanów aktualizowane przy przejściach (count)
+
+    uint32_t focusLevel_ = UINT32_MAX;
+    int focusX0_ = 0, focusY0_ = 0, focusX1_ = -1, focusY1_ = -1;   // w chunkach, włącznie
+
+    // Plik wymiany: zapis na wątku gry, odczyt na wątku I/O - oba pod fileMutex_
+    std::fstream swap_;
+    std::mutex fileMutex_;
+    std::vector<uint32_t> freeSlots_;
+    uint32_t slotCount_ = 0;
+
+    std::thread io_;
+    std::mutex queueMutex_;
+    std::condition_variable queueCv_;
+    std::condition_variable doneCv_;
+    std::vector<LoadRequest> requests_;
+    std::vector<Loaded> loaded_;
+    uint32_t inFlight_ = 0;
+    bool stop_ = false;
+
+    static uint64_t key(uint32_t level, int cx, int cy) {
+        return (uint64_t(level) << 32) | (uint64_t(uint16_t(cy)) << 16) | uint16_t(cx);
+    }
+    bool inFocus(uint64_t k) const;
+    void count(const Chunk& c, int delta);
+
+    Chunk* find(uint32_t level, int x, int y);
+    Chunk& create(uint64_t k);
+    uint8_t* makeRaw(uint64_t k, Chunk& c);   // rozpakowuje (wczytuje z dysku, jeśli trzeba)
+    const uint8_t* view(Chunk& c, uint8_t* tmp);   // bajty chunku bez zmiany na surowy
+    void pack(Chunk& c, const uint8_t* data);
+    void compress(Chunk& c);
+    void drop(Chunk& c);
+    void pageIn(Chunk& c);
+    void pageOut(Chunk& c);
+    void readSlot(uint32_t slot, uint16_t size, std::vector<uint8_t>& out);
+    void releaseSlot(Chunk& c);
+    void collectLoaded();
+    void ioMain();
+};
@@ -0,0 +1,276 @@
+#include "DijkstraMap.h"
+#include "Pathfinding.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int kDirs[8][2] = {
+    { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+    { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 },
+};
+}
+
+DijkstraMap::DijkstraMap(const TileMap& map) : map_(map) {}
+
+void DijkstraMap::syncPassable()
+{
+    if (width_ != map_.width() || height_ != map_.height() || passable_.empty()) {
+        width_ = map_.width();
+        height_ = map_.height();
+        stride_ = width_ + 2;
+        const size_t n = static_cast<size_t>(stride_) * (height_ + 2);
+        passable_.assign(n, 0);
+        dist_.assign(n, kUnreachable);
+        source_.assign(n, -1);
+        for (int d = 0; d < 8; ++d) {
+            offsets_[d] = kDirs[d][1] * stride_ + kDirs[d][0];
+            sideA_[d] = kDirs[d][0];
+            sideB_[d] = kDirs[d][1] * stride_;
+            const bool diagonal = kDirs[d][0] != 0 && kDirs[d][1] != 0;
+            costs_[d] = static_cast<int32_t>(diagonal ? Pathfinder::kDiagonalCost : Pathfinder::kStraightCost);
+        }
+    }
+    const uint8_t* tiles = map_.data();
+    for (int y = 0; y < height_; ++y) {
+        uint8_t* row = &passable_[padded(0, y)];
+        const uint8_t* src = tiles + static_cast<size_t>(y) * width_;
+        for (int x = 0; x < width_; ++x)
+            row[x] = src[x] & TileWalkable;
+    }
+    mapRevision_ = map_.revision();
+}
+
+bool DijkstraMap::canStep(uint32_t p, int dir) const
+{
+    if (!passable_[p + offsets_[dir]]) return false;
+    if (dir < 4) return true;
+    return passable_[p + sideA_[dir]] && passable_[p + sideB_[dir]];
+}
+
+// --- Cele ---
+
+void DijkstraMap::markDirty(Goal& g)
+{
+    if (g.dirty) return;
+    g.dirty = true;
+    ++dirtyGoals_;
+}
+
+DijkstraMap::GoalId DijkstraMap::addGoal(TilePos pos, int32_t value)
+{
+    fleeSource_ = nullptr;
+    GoalId id;
+    if (!freeGoals_.empty()) { id = freeGoals_.back(); freeGoals_.pop_back(); }
+    else { id = static_cast<GoalId>(goals_.size()); goals_.emplace_back(); }
+    Goal& g = goals_[id];
+    g = Goal{};
+    g.pos = pos;
+    g.value = value;
+    g.alive = true;
+    markDirty(g);
+    return id;
+}
+
+void DijkstraMap::moveGoal(GoalId id, TilePos pos)
+{
+    Goal& g = goals_[id];
+    if (g.pos == pos) return;
+    g.pos = pos;
+    markDirty(g);
+}
+
+void DijkstraMap::removeGoal(GoalId id)
+{
+    Goal& g = goals_[id];
+    if (!g.alive) return;
+    g.alive = false;
+    markDirty(g);
+}
+
+void DijkstraMap::clearGoals()
+{
+    goals_.clear();
+    freeGoals_.clear();
+    dirtyGoals_ = 0;
+    built_ = false;
+    fleeSource_ = nullptr;
+}
+
+// --- Liczenie ---
+
+// Fala po kubełkach odległości. Wartości w kolejce mieszczą się w [cur, cur + 14],
+// więc wystarcza pierścień 16 kubełków; posortowane ziarna dołączają, gdy fala dojdzie do ich wartości.
+void DijkstraMap::propagate()
+{
+    std::sort(seeds_.begin(), seeds_.end(), [](const Seed& a, const Seed& b) { return a.value < b.value; });
+
+    size_t si = 0;
+    size_t pending = 0;
+    int32_t cur = 0;
+    size_t relaxed = 0;
+
+    while (si < seeds_.size() || pending) {
+        if (!pending) cur = seeds_[si].value;
+
+        for (; si < seeds_.size() && seeds_[si].value == cur; ++si) {
+            const Seed& s = seeds_[si];
+            if (s.value > dist_[s.node]) continue;
+            dist_[s.node] = s.value;
+            if (s.source >= 0) source_[s.node] = s.source;
+            ring_[cur & (kRing - 1)].push_back(s.node);
+            ++pending;
+        }
+
+        auto& bucket = ring_[cur & (kRing - 1)];
+        for (size_t k = 0; k < bucket.size(); ++k) {
+            const uint32_t p = bucket[k];
+            --pending;
+            if (dist_[p] != cur) continue;
+            ++relaxed;
+            const GoalId src = source_[p];
+            for (int d = 0; d < 8; ++d) {
+                if (!canStep(p, d)) continue;
+                const uint32_t n = p + offsets_[d];
+                const int32_t nd = cur + costs_[d];
+                if (nd >= dist_[n]) continue;
+                dist_[n] = nd;
+                source_[n] = src;
+                ring_[nd & (kRing - 1)].push_back(n);
+                ++pending;
+            }
+        }
+        bucket.clear();
+        ++cur;
+    }
+    seeds_.clear();
+    lastRelaxed_ = relaxed;
+}
+
+void DijkstraMap::rebuild()
+{
+    if (fleeSource_) {
+        buildFleeFrom(*fleeSource_, fleeFactor_);
+        return;
+    }
+    syncPassable();
+    std::fill(dist_.begin(), dist_.end(), kUnreachable);
+    std::fill(source_.begin(), source_.end(), -1);
+    seeds_.clear();
+
+    for (GoalId id = 0; id < static_cast<GoalId>(goals_.size()); ++id) {
+        Goal& g = goals_[id];
+        if (g.dirty && !g.alive) freeGoals_.push_back(id);
+        g.dirty = false;
+        g.placed = g.alive && map_.walkable(g.pos.x, g.pos.y);
+        if (!g.placed) continue;
+        g.placedAt = g.pos;
+        seeds_.push_back({ g.value, padded(g.pos.x, g.pos.y), id });
+    }
+    dirtyGoals_ = 0;
+    propagate();
+    built_ = true;
+    lastIncremental_ = false;
+}
+
+// Zeruje dorzecze celu (kafle, których wartość od niego pochodzi). Dorzecze jest spójne,
+// bo rodzic każdego kafla w drzewie najkrótszych ścieżek ma to samo źródło.
+void DijkstraMap::clearBasin(GoalId id)
+{
+    const Goal& g = goals_[id];
+    const uint32_t start = padded(g.placedAt.x, g.placedAt.y);
+    if (source_[start] != id) return;
+
+    const size_t first = scratch_.size();
+    source_[start] = -1;
+    dist_[start] = kUnreachable;
+    scratch_.push_back(start);
+    for (size_t k = first; k < scratch_.size(); ++k) {
+        const uint32_t p = scratch_[k];
+        for (int d = 0; d < 8; ++d) {
+            const uint32_t n = p + offsets_[d];
+            if (source_[n] != id) continue;
+            source_[n] = -1;
+            dist_[n] = kUnreachable;
+            scratch_.push_back(n);
+        }
+    }
+}
+
+void DijkstraMap::update()
+{
+    // Mapa ucieczki nie ma własnych celów - pusty zbiór celów wyczyściłby ją całą
+    if (fleeSource_) {
+        if (mapRevision_ != map_.revision()) rebuild();
+        return;
+    }
+    size_t alive = 0;
+    for (const auto& g : goals_) alive += g.alive;
+
+    if (!built_ || mapRevision_ != map_.revision() || dirtyGoals_ * 2 > alive) {
+        rebuild();
+        return;
+    }
+    if (!dirtyGoals_) return;
+
+    // 1) Wyczyść dorzecza wszystkich zmienionych celów, zanim zbierzemy brzeg -
+    //    inaczej ziarno z brzegu mogłoby należeć do dorzecza celu czyszczonego później.
+    scratch_.clear();
+    for (GoalId id = 0; id < static_cast<GoalId>(goals_.size()); ++id)
+        if (goals_[id].dirty && goals_[id].placed) clearBasin(id);
+
+    // 2) Brzeg: sąsiedzi wyczyszczonych kafli, którzy zachowali wartość, startują falę ponownie
+    for (const uint32_t p : scratch_) {
+        for (int d = 0; d < 8; ++d) {
+            const uint32_t n = p + offsets_[d];
+            if (dist_[n] != kUnreachable)
+                seeds_.push_back({ dist_[n], n, -1 });
+        }
+    }
+
+    // 3) Nowe pozycje celów
+    for (GoalId id = 0; id < static_cast<GoalId>(goals_.size()); ++id) {
+        Goal& g = goals_[id];
+        if (!g.dirty) continue;
+        g.dirty = false;
+        g.placed = g.alive && map_.walkable(g.pos.x, g.pos.y);
+        if (!g.alive) freeGoals_.push_back(id);
+        if (!g.placed) continue;
+        g.placedAt = g.pos;
+        seeds_.push_back({ g.value, padded(g.pos.x, g.pos.y), id });
+    }
+    dirtyGoals_ = 0;
+    propagate();
+    lastIncremental_ = true;
+}
+
+void DijkstraMap::buildFleeFrom(const DijkstraMap& chase, float factor)
+{
+    clearGoals();
+    syncPassable();
+    std::fill(dist_.begin(), dist_.end(), kUnreachable);
+    std::fill(source_.begin(), source_.end(), -1);
+    seeds_.clear();
+    for (uint32_t p = 0; p < chase.dist_.size() && p < dist_.size(); ++p) {
+        if (chase.dist_[p] == kUnreachable) continue;
+        seeds_.push_back({ static_cast<int32_t>(std::lround(chase.dist_[p] * factor)), p, -1 });
+    }
+    propagate();
+    built_ = true;
+    lastIncremental_ = false;
+    fleeSource_ = &chase;
+    fleeFactor_ = factor;
+}
+
+TilePos DijkstraMap::nextStep(TilePos from) const
+{
+    if (!map_.inBounds(from.x, from.y) || dist_.empty()) return from;
+    const uint32_t p = padded(from.x, from.y);
+    int32_t best = dist_[p];
+    int bestDir = -1;
+    for (int d = 0; d < 8; ++d) {
+        const int32_t v = dist_[p + offsets_[d]];
+        if (v < best && canStep(p, d)) { best = v; bestDir = d; }
+    }
+    if (bestDir < 0) return from;
+    return { from.x + kDirs[bestDir][0], from.y + kDirs[bestDir][1] };
+}
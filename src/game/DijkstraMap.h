@@ -0,0 +1,94 @@
+#pragma once
+#include "TileMap.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Mapa odległości od zbioru celów (gracz, przedmioty, punkty ucieczki), liczona raz na turę
+// i współdzielona przez wszystkie potwory - każdy wybiera krok lokalnym spadkiem gradientu.
+//
+// Liczymy falą (algorytm Diala: kubełki po odległości) na siatce z ramką ścian, więc pętla
+// relaksacji nie sprawdza granic. Każdy kafel pamięta cel, od którego pochodzi jego wartość;
+// przesunięcie kilku celów naprawia tylko ich dorzecza zamiast liczyć całą mapę od nowa.
+class DijkstraMap {
+public:
+    static constexpr int32_t kUnreachable = INT32_MAX;
+    using GoalId = int32_t;
+
+    explicit DijkstraMap(const TileMap& map);
+
+    GoalId addGoal(TilePos pos, int32_t value = 0);
+    void moveGoal(GoalId id, TilePos pos);
+    void removeGoal(GoalId id);
+    void clearGoals();
+
+    // Przelicza mapę po zmianach celów. Pełne przeliczenie gdy zmieniła się mapa kafli
+    // albo zmian jest tyle, że naprawa nie ma sensu.
+    void update();
+    void rebuild();
+
+    // Mapa ucieczki: wartości mapy pościgu przemnożone przez ujemny współczynnik i ponownie
+    // zrelaksowane - potwory uciekają w stronę wyjść zamiast w najbliższy róg. Mapa pamięta
+    // źródło: update()/rebuild() po zmianie kafli liczą ją znów z chase (ta musi być już aktualna),
+    // a addGoal/clearGoals wracają do zwykłych celów.
+    void buildFleeFrom(const DijkstraMap& chase, float factor = -1.2f);
+
+    int32_t at(int x, int y) const { return map_.inBounds(x, y) ? dist_[padded(x, y)] : kUnreachable; }
+    // Kafel sąsiedni o najniższej wartości (bez ścinania rogów); from, jeśli nie ma lepszego.
+    TilePos nextStep(TilePos from) const;
+
+    size_t lastRelaxed() const { return lastRelaxed_; }
+    bool lastWasIncremental() const { return lastIncremental_; }
+
+private:
+    struct Goal {
+        TilePos pos{};
+        TilePos placedAt{};   // pozycja, z której policzono obecne wartości
+        int32_t value = 0;
+        bool alive = false;
+        bool placed = false;  // czy goal jest już w dist_
+        bool dirty = false;
+    };
+
+    static constexpr int kRing = 16; // > największy koszt kroku
+
+    const TileMap& map_;
+    int width_ = 0;
+    int height_ = 0;
+    int stride_ = 0;
+    uint32_t mapRevision_ = 0;
+    bool built_ = false;
+
+    std::vector<uint8_t> passable_;  // z ramką szerokości 1
+    std::vector<int32_t> dist_;
+    std::vector<GoalId> source_;     // -1 = brak (ściana, nieosiągalne, mapa ucieczki)
+    int offsets_[8]{};
+    int sideA_[8]{};                 // dla przekątnych: sąsiedzi ortogonalni, którzy muszą być wolni
+    int sideB_[8]{};
+    int32_t costs_[8]{};
+
+    std::vector<Goal> goals_;
+    std::vector<GoalId> freeGoals_;
+    size_t dirtyGoals_ = 0;
+    const DijkstraMap* fleeSource_ = nullptr;   // ustawione przez buildFleeFrom
+    float fleeFactor_ = 0.0f;
+
+    struct Seed {
+        int32_t value;
+        uint32_t node;
+        GoalId source;               // -1 = zachowaj source_ kafla (brzeg naprawianego obszaru)
+    };
+    std::vector<Seed> seeds_;
+    std::array<std::vector<uint32_t>, kRing> ring_;
+    std::vector<uint32_t> scratch_;
+    size_t lastRelaxed_ = 0;
+    bool lastIncremental_ = false;
+
+    uint32_t padded(int x, int y) const { return static_cast<uint32_t>((y + 1) * stride_ + (x + 1)); }
+    void syncPassable();
+    void markDirty(Goal& g);
+    void propagate();
+    void clearBasin(GoalId id);
+    bool canStep(uint32_t p, int dir) const;
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include "TileMap.h"
+
+// Pole widzenia: rekurencyjne shadowcasting w 8 oktantach, zasłaniają kafle bez TileTransparent.
+// visit(x, y, dx, dy) dostaje każdy widoczny kafel w promieniu (dx, dy względem origin), także
+// ściany na krawędzi widoku - to one są oświetloną powierzchnią. Kafle na osiach i przekątnych
+// mogą przyjść dwa razy (z sąsiednich oktantów), więc visit powinien nadpisywać, nie dodawać.
+namespace fov {
+
+namespace detail {
+
+template <typename Visit>
+void castOctant(const TileMap& tiles, TilePos origin, int radius, int row, float start, float end,
+    int xx, int xy, int yx, int yy, Visit& visit)
+{
+    if (start < end) return;
+    const int radius2 = radius * radius + radius;   // + radius: okrąg bez pojedynczych wypustek na osiach
+    float newStart = 0.0f;
+    for (int j = row; j <= radius; ++j) {
+        const int dy = -j;
+        bool blocked = false;
+        for (int dx = -j; dx <= 0; ++dx) {
+            const float leftSlope = (dx - 0.5f) / (dy + 0.5f);
+            const float rightSlope = (dx + 0.5f) / (dy - 0.5f);
+            if (start < rightSlope) continue;
+            if (end > leftSlope) break;
+
+            const int ox = dx * xx + dy * xy, oy = dx * yx + dy * yy;
+            const int x = origin.x + ox, y = origin.y + oy;
+            if (dx * dx + dy * dy <= radius2 && tiles.inBounds(x, y)) visit(x, y, ox, oy);
+
+            const bool opaque = !tiles.transparent(x, y);
+            if (blocked) {
+                if (opaque) {
+                    newStart = rightSlope;
+                } else {
+                    blocked = false;
+                    start = newStart;
+                }
+            } else if (opaque && j < radius) {
+                blocked = true;
+                castOctant(tiles, origin, radius, j + 1, start, leftSlope, xx, xy, yx, yy, visit);
+                newStart = rightSlope;
+            }
+        }
+        if (blocked) return;
+    }
+}
+
+} // namespace detail
+
+template <typename Visit>
+void shadowcast(const TileMap& tiles, TilePos origin, int radius, Visit&& visit)
+{
+    if (!tiles.inBounds(origin.x, origin.y)) return;
+    visit(origin.x, origin.y, 0, 0);
+    static constexpr int kOctants[8][4] = {
+        { 1, 0, 0, 1 }, { 0, 1, 1, 0 }, { 0, -1, 1, 0 }, { -1, 0, 0, 1 },
+        { -1, 0, 0, -1 }, { 0, -1, -1, 0 }, { 0, 1, -1, 0 }, { 1, 0, 0, -1 },
+    };
+    for (const auto& m : kOctants) detail::castOctant(tiles, origin, radius, 1, 1.0f, 0.0f, m[0], m[1], m[2], m[3], visit);
+}
+
+} // namespace fov
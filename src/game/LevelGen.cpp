@@ -0,0 +1,36 @@
+#include "LevelGen.h"
+#include "Rng.h"
+
+namespace {
+TileMap emptyRoom()
+{
+    TileMap room(kLevelSize, kLevelSize);
+    for (int i = 0; i < kLevelSize; ++i) {
+        room.set(i, 0, TileWall);
+        room.set(i, kLevelSize - 1, TileWall);
+        room.set(0, i, TileWall);
+        room.set(kLevelSize - 1, i, TileWall);
+    }
+    return room;
+}
+}
+
+void setupWorld(World& world)
+{
+    const TileMap room = emptyRoom();
+    world.tiles.assign(room.width(), room.height(), room.data());
+    world.turn = 0;
+}
+
+void generateLevel(TileMap& tiles, uint32_t depth)
+{
+    TileMap level = emptyRoom();
+    Rng rng(0x5EED0000ull + depth);
+    const int pillars = 8 + static_cast<int>(depth % 16) * 2;
+    for (int i = 0; i < pillars; ++i) {
+        const int x = rng.range(2, kLevelSize - 4), y = rng.range(2, kLevelSize - 4);
+        for (int dy = 0; dy < 2; ++dy)
+            for (int dx = 0; dx < 2; ++dx) level.set(x + dx, y + dy, TileWall);
+    }
+    tiles.assign(level.width(), level.height(), level.data());
+}
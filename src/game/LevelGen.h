@@ -0,0 +1,13 @@
+#pragma once
+#include "TileMap.h"
+#include "World.h"
+#include <cstdint>
+
+inline constexpr int kLevelSize = 64;
+
+// Start gry: pusta sala kLevelSize x kLevelSize otoczona ścianą, tura 0
+void setupWorld(World& world);
+
+// Piętro depth: sala z filarami zależnymi tylko od głębokości (bez world.rng - powtórki).
+// Siatka jest podmieniana przez assign, więc revision() rośnie dalej i cache (ścieżki, minimapa) widzą zmianę.
+void generateLevel(TileMap& tiles, uint32_t depth);
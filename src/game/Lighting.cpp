@@ -0,0 +1,245 @@
+#include "Lighting.h"
+#include "Fov.h"
+#include "core/JobSystem.h"
+#include "core/Simd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+constexpr size_t kMaxTrackedChanges = 256;   // więcej zmienionych kafli: przelicz wszystkie światła
+
+// Jasność * 256 w odległości (dx, dy): kwadratowy spadek do zera tuż za promieniem
+uint32_t falloff(int dx, int dy, int radius)
+{
+    const float t = 1.0f - std::sqrt(static_cast<float>(dx * dx + dy * dy)) / static_cast<float>(radius + 1);
+    return t > 0.0f ? static_cast<uint32_t>(t * t * 256.0f + 0.5f) : 0u;
+}
+
+// acc[i] += src[i] (albo -=) po 4 naraz; arytmetyka modulo 2^32, więc odjęcie dokładnie cofa dodanie
+void blendRow(uint32_t* acc, const uint32_t* src, int n, bool add)
+{
+    int i = 0;
+    if (add) {
+        for (; i + 4 <= n; i += 4) simd::store(acc + i, simd::load(acc + i) + simd::load(src + i));
+        for (; i < n; ++i) acc[i] += src[i];
+    } else {
+        for (; i + 4 <= n; i += 4) simd::store(acc + i, simd::load(acc + i) - simd::load(src + i));
+        for (; i < n; ++i) acc[i] -= src[i];
+    }
+}
+}
+
+LightMap::LightId LightMap::add(const Light& light)
+{
+    LightId id;
+    if (!freeSlots_.empty()) {
+        id = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        id = static_cast<LightId>(slots_.size());
+        slots_.emplace_back();
+    }
+    Slot& slot = slots_[id];
+    slot.light = light;
+    slot.light.radius = std::clamp(light.radius, 0, kMaxRadius);
+    slot.alive = true;
+    slot.dirty = true;
+    ++lightCount_;
+    return id;
+}
+
+void LightMap::move(LightId id, TilePos pos)
+{
+    Slot& slot = slots_[id];
+    if (slot.light.pos == pos) return;
+    slot.light.pos = pos;
+    slot.dirty = true;
+}
+
+// Wkład zostaje w akumulatorach do najbliższego update(), slot wraca do puli dopiero tam
+void LightMap::remove(LightId id)
+{
+    Slot& slot = slots_[id];
+    if (!slot.alive) return;
+    slot.alive = false;
+    slot.dirty = true;
+    --lightCount_;
+}
+
+void LightMap::clear()
+{
+    slots_.clear();
+    freeSlots_.clear();
+    lightCount_ = 0;
+    std::fill(accR_.begin(), accR_.end(), 0u);
+    std::fill(accG_.begin(), accG_.end(), 0u);
+    std::fill(accB_.begin(), accB_.end(), 0u);
+    fullResolve_ = true;
+}
+
+void LightMap::setAmbient(uint8_t level)
+{
+    if (ambient_ == level) return;
+    ambient_ = level;
+    fullResolve_ = true;
+}
+
+void LightMap::resize(int width, int height)
+{
+    width_ = width;
+    height_ = height;
+    const size_t n = static_cast<size_t>(width) * height;
+    accR_.assign(n, 0u);
+    accG_.assign(n, 0u);
+    accB_.assign(n, 0u);
+    pixels_.assign(n, 0u);
+    for (Slot& slot : slots_) {
+        slot.applied = false;
+        slot.dirty = true;
+    }
+    fullResolve_ = true;
+}
+
+// Zmiany kafli porównaniem z kopią - TileMap zna tylko numer rewizji. Całe wiersze memcmp,
+// po bajtach tylko te, które się różnią.
+void LightMap::detectChanges(const TileMap& tiles)
+{
+    if (tiles.revision() == tilesRevision_ && tiles_.size() == tiles.size()) return;
+    tilesRevision_ = tiles.revision();
+    changed_.clear();
+    bool overflow = tiles_.size() != tiles.size();
+    for (int y = 0; y < height_ && !overflow; ++y) {
+        const size_t row = static_cast<size_t>(y) * width_;
+        if (std::memcmp(tiles_.data() + row, tiles.data() + row, static_cast<size_t>(width_)) == 0) continue;
+        for (int x = 0; x < width_; ++x) {
+            if (!((tiles_[row + x] ^ tiles.data()[row + x]) & TileTransparent)) continue;
+            if (changed_.size() == kMaxTrackedChanges) { overflow = true; break; }
+            changed_.push_back({ x, y });
+        }
+        std::memcpy(tiles_.data() + row, tiles.data() + row, static_cast<size_t>(width_));
+    }
+    if (overflow) tiles_.assign(tiles.data(), tiles.data() + tiles.size());
+    stats_.changedTiles = overflow ? static_cast<uint32_t>(tiles.size()) : static_cast<uint32_t>(changed_.size());
+
+    for (Slot& slot : slots_) {
+        if (!slot.alive || slot.dirty) continue;
+        if (overflow) { slot.dirty = true; continue; }
+        // Pole widzenia zależy tylko od kafli w kwadracie światła
+        const Light& l = slot.light;
+        for (const TilePos& p : changed_) {
+            if (std::abs(p.x - l.pos.x) <= l.radius && std::abs(p.y - l.pos.y) <= l.radius) {
+                slot.dirty = true;
+                break;
+            }
+        }
+    }
+}
+
+void LightMap::compute(Slot& slot, const TileMap& tiles) const
+{
+    const Light& l = slot.light;
+    slot.x0 = std::max(0, l.pos.x - l.radius);
+    slot.y0 = std::max(0, l.pos.y - l.radius);
+    slot.w = std::max(0, std::min(width_, l.pos.x + l.radius + 1) - slot.x0);
+    slot.h = std::max(0, std::min(height_, l.pos.y + l.radius + 1) - slot.y0);
+    const size_t plane = static_cast<size_t>(slot.w) * slot.h;
+    slot.contrib.assign(plane * 3, 0u);   // pojemność zostaje między przeliczeniami
+
+    const uint32_t r = l.color & 0xFF, g = (l.color >> 8) & 0xFF, b = (l.color >> 16) & 0xFF;
+    uint32_t* out = slot.contrib.data();
+    fov::shadowcast(tiles, l.pos, l.radius, [&](int x, int y, int dx, int dy) {
+        const size_t i = static_cast<size_t>(y - slot.y0) * slot.w + (x - slot.x0);
+        const uint32_t f = falloff(dx, dy, l.radius);
+        out[i] = f * r;
+        out[plane + i] = f * g;
+        out[2 * plane + i] = f * b;
+    });
+}
+
+void LightMap::blend(const Slot& slot, bool add)
+{
+    const size_t plane = static_cast<size_t>(slot.w) * slot.h;
+    uint32_t* acc[3] = { accR_.data(), accG_.data(), accB_.data() };
+    for (int c = 0; c < 3; ++c) {
+        const uint32_t* src = slot.contrib.data() + c * plane;
+        for (int y = 0; y < slot.h; ++y)
+            blendRow(acc[c] + static_cast<size_t>(slot.y0 + y) * width_ + slot.x0, src + static_cast<size_t>(y) * slot.w, slot.w, add);
+    }
+    stats_.blendedTiles += plane;
+}
+
+void LightMap::markDirty(const Slot& slot)
+{
+    if (slot.w > 0 && slot.h > 0)
+        dirty_.add({ static_cast<uint32_t>(slot.x0), static_cast<uint32_t>(slot.y0), static_cast<uint32_t>(slot.w), static_cast<uint32_t>(slot.h) });
+}
+
+void LightMap::resolve(const DirtyRect& rect)
+{
+    const uint32_t ambient = ambient_;
+    for (uint32_t y = rect.y; y < rect.y + rect.height; ++y) {
+        const size_t row = static_cast<size_t>(y) * width_;
+        for (uint32_t x = rect.x; x < rect.x + rect.width; ++x) {
+            const size_t i = row + x;
+            const uint32_t r = std::min(255u, ambient + (accR_[i] >> 8));
+            const uint32_t g = std::min(255u, ambient + (accG_[i] >> 8));
+            const uint32_t b = std::min(255u, ambient + (accB_[i] >> 8));
+            pixels_[i] = 0xFF000000u | b << 16 | g << 8 | r;
+        }
+    }
+}
+
+void LightMap::update(const TileMap& tiles, JobSystem* jobs)
+{
+    dirty_.clear();
+    stats_ = {};
+    if (tiles.width() != width_ || tiles.height() != height_) {
+        resize(tiles.width(), tiles.height());
+        tiles_.assign(tiles.data(), tiles.data() + tiles.size());
+        tilesRevision_ = tiles.revision();
+    } else {
+        detectChanges(tiles);
+    }
+
+    work_.clear();
+    for (LightId id = 0; id < slots_.size(); ++id)
+        if (slots_[id].dirty) work_.push_back(id);
+
+    // Najpierw wszystkie stare wkłady precz, potem nowe pola widzenia (niezależne - równolegle), potem dodanie
+    for (LightId id : work_) {
+        Slot& slot = slots_[id];
+        if (!slot.applied) continue;
+        blend(slot, false);
+        markDirty(slot);
+        slot.applied = false;
+    }
+    auto computeRange = [this, &tiles](uint32_t begin, uint32_t end) {
+        for (uint32_t k = begin; k < end; ++k)
+            if (slots_[work_[k]].alive) compute(slots_[work_[k]], tiles);
+    };
+    if (jobs) jobs->parallelFor(0, static_cast<uint32_t>(work_.size()), 4, computeRange);
+    else computeRange(0, static_cast<uint32_t>(work_.size()));
+
+    for (LightId id : work_) {
+        Slot& slot = slots_[id];
+        slot.dirty = false;
+        if (!slot.alive) {
+            slot.contrib = {};
+            freeSlots_.push_back(id);
+            continue;
+        }
+        blend(slot, true);
+        markDirty(slot);
+        slot.applied = true;
+        ++stats_.recomputed;
+    }
+    stats_.lights = lightCount_;
+
+    if (fullResolve_ && width_ > 0 && height_ > 0) {
+        dirty_.clear();
+        dirty_.add({ 0, 0, static_cast<uint32_t>(width_), static_cast<uint32_t>(height_) });
+    }
+    fullResolve_ = false;
+    for (const DirtyRect& rect : dirty_.rects()) resolve(rect);
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "TileMap.h"
+#include "core/DirtyRegion.h"
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+// Źródło światła na kaflu (pochodnia, czar, świecący potwór)
+struct Light {
+    TilePos pos;
+    int radius = 6;                 // w kaflach, najwyżej LightMap::kMaxRadius
+    uint32_t color = 0x00FFFFFFu;   // RGB (R w najniższym bajcie), pełna jasność przy źródle
+};
+
+// Mapa światła kafli. Każde światło trzyma swój wkład (kwadrat 2r+1 wokół źródła, wycięty pole
+// widzenia z fov::shadowcast) i jest przeliczane tylko, gdy się ruszy albo w tym kwadracie zmieni
+// się przezroczystość kafla. Suma wkładów leży w całkowitych akumulatorach RGB - zmiana światła
+// to odjęcie starego i dodanie nowego wkładu (po 4 kafle naraz, core/Simd.h), bez dryfu.
+// Wynik: RGBA8 na kafel (pixels()) i obszary zmienione przez ostatni update() (dirty()),
+// gotowe do wysłania jako mała tekstura dynamiczna.
+class LightMap {
+public:
+    using LightId = uint32_t;
+    static constexpr int kMaxRadius = 32;
+
+    struct Stats {
+        uint32_t lights = 0;
+        uint32_t recomputed = 0;       // światła przeliczone w ostatnim update()
+        uint32_t changedTiles = 0;     // kafle ze zmienioną przezroczystością
+        uint64_t blendedTiles = 0;     // kafle dodane/odjęte z akumulatorów
+    };
+
+    LightId add(const Light& light);
+    void move(LightId id, TilePos pos);
+    void remove(LightId id);
+    void clear();
+    const Light& light(LightId id) const { return slots_[id].light; }
+    uint32_t lightCount() const { return lightCount_; }
+
+    void setAmbient(uint8_t level);   // dolna granica jasności kafla (0 = ciemność)
+
+    // Dopasowuje się do mapy (rozmiar, zmienione kafle) i przelicza brudne światła;
+    // jobs != nullptr: pola widzenia świateł liczone równolegle
+    void update(const TileMap& tiles, JobSystem* jobs = nullptr);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    const uint32_t* pixels() const { return pixels_.data(); }
+    uint32_t at(int x, int y) const { return pixels_[static_cast<size_t>(y) * width_ + x]; }
+    const DirtyRegion& dirty() const { return dirty_; }
+    Stats lastUpdate() const { return stats_; }
+
+private:
+    struct Slot {
+        Light light;
+        bool alive = false;
+        bool dirty = false;
+        bool applied = false;          // contrib jest w akumulatorach
+        int x0 = 0, y0 = 0, w = 0, h = 0;   // obszar contrib na mapie (przycięty)
+        std::vector<uint32_t> contrib; // 3 płaszczyzny w * h: R, G, B (jasność * 256)
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<LightId> freeSlots_;
+    uint32_t lightCount_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    uint32_t tilesRevision_ = 0;
+    std::vector<uint8_t> tiles_;       // kopia kafli z ostatniego update (wykrywanie zmian)
+    std::vector<uint32_t> accR_, accG_, accB_;
+    std::vector<uint32_t> pixels_;
+    uint8_t ambient_ = 0;
+    bool fullResolve_ = false;         // cała mapa do przeliczenia na RGBA (rozmiar, tło, clear)
+    DirtyRegion dirty_;
+    Stats stats_;
+    std::vector<LightId> work_;
+    std::vector<TilePos> changed_;
+
+    void resize(int width, int height);
+    void detectChanges(const TileMap& tiles);
+    void compute(Slot& slot, const TileMap& tiles) const;
+    void blend(const Slot& slot, bool add);
+    void markDirty(const Slot& slot);
+    void resolve(const DirtyRect& rect);
+};
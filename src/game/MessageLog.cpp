@@ -0,0 +1,97 @@
+#include "MessageLog.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+
+MessageLog::MessageLog(uint32_t capacity)
+    : ring_(capacity)
+{
+    if (capacity == 0) throw std::runtime_error("Message log capacity must be positive");
+}
+
+uint32_t MessageLog::intern(std::string_view text)
+{
+    const uint64_t hash = std::hash<std::string_view>{}(text);   // tylko w pamięci - nie musi być stabilny
+    auto it = byHash_.find(hash);
+    if (it != byHash_.end() && strings_[it->second].text == text) {
+        ++strings_[it->second].refs;
+        return it->second;
+    }
+    uint32_t id;
+    if (!freeStrings_.empty()) {
+        id = freeStrings_.back();
+        freeStrings_.pop_back();
+    } else {
+        id = static_cast<uint32_t>(strings_.size());
+        strings_.emplace_back();
+    }
+    Interned& s = strings_[id];
+    s.text.assign(text);
+    s.hash = hash;
+    s.refs = 1;
+    internedBytes_ += text.size();
+    if (it == byHash_.end()) byHash_.emplace(hash, id);
+    return id;
+}
+
+void MessageLog::release(uint32_t id)
+{
+    Interned& s = strings_[id];
+    if (--s.refs > 0) return;
+    auto it = byHash_.find(s.hash);
+    if (it != byHash_.end() && it->second == id) byHash_.erase(it);
+    internedBytes_ -= s.text.size();
+    s.text.clear();
+    freeStrings_.push_back(id);
+}
+
+void MessageLog::add(MessageKind kind, uint64_t turn, std::string_view text)
+{
+    ++total_;
+    if (count_ > 0) {
+        Record& last = ring_[(head_ + count_ - 1) % ring_.size()];
+        if (last.kind == kind && strings_[last.text].text == text) {
+            ++last.repeat;
+            last.turn = turn;
+            return;
+        }
+    }
+    const uint32_t id = intern(text);
+    if (count_ == ring_.size()) {
+        release(ring_[head_].text);
+        ring_[head_] = { turn, id, 1, kind };
+        head_ = (head_ + 1) % static_cast<uint32_t>(ring_.size());
+        return;
+    }
+    ring_[(head_ + count_) % ring_.size()] = { turn, id, 1, kind };
+    ++count_;
+}
+
+void MessageLog::addf(MessageKind kind, uint64_t turn, const char* fmt, ...)
+{
+    char buffer[256];
+    va_list args;
+    va_start(args, fmt);
+    const int n = std::vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    add(kind, turn, std::string_view(buffer, std::min<size_t>(static_cast<size_t>(n), sizeof(buffer) - 1)));
+}
+
+void MessageLog::clear()
+{
+    head_ = 0;
+    count_ = 0;
+    strings_.clear();
+    freeStrings_.clear();
+    byHash_.clear();
+    internedBytes_ = 0;
+}
+
+MessageLog::Line MessageLog::line(uint32_t i) const
+{
+    const Record& r = ring_[(head_ + i) % ring_.size()];
+    return { strings_[r.text].text, r.turn, r.repeat, r.kind };
+}
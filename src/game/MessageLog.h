@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+enum class MessageKind : uint8_t { Info, Combat, Hurt, Death, Count };
+
+// Dziennik wiadomości dla gracza (walka, zdarzenia). Pierścień o stałej pojemności - najstarsze
+// wypadają. Tekst formatowany raz przy dodaniu i internowany: powtarzające się wiadomości
+// („Szczur gryzie cię za 2.”) dzielą jeden napis z licznikiem odwołań, a wpis w pierścieniu to
+// tylko id + tura. Kolejne identyczne wiadomości zwijają się w jedną z licznikiem powtórzeń.
+// Odczyt line(i) jest O(1), więc panel z ImGuiListClipper buduje tylko widoczne wiersze.
+class MessageLog {
+public:
+    struct Line {
+        std::string_view text;
+        uint64_t turn = 0;
+        uint32_t repeat = 1;
+        MessageKind kind = MessageKind::Info;
+    };
+
+    explicit MessageLog(uint32_t capacity = 1u << 17);
+
+    void add(MessageKind kind, uint64_t turn, std::string_view text);
+    // printf do bufora na stosie (najwyżej 255 znaków), potem add()
+    void addf(MessageKind kind, uint64_t turn, const char* fmt, ...);
+    void clear();
+
+    uint32_t size() const { return count_; }
+    uint32_t capacity() const { return static_cast<uint32_t>(ring_.size()); }
+    uint64_t total() const { return total_; }   // wszystkie dodane (z powtórzeniami), także te, które wypadły
+    Line line(uint32_t i) const;                // 0 = najstarsza zachowana
+
+    size_t internedCount() const { return strings_.size() - freeStrings_.size(); }
+    size_t internedBytes() const { return internedBytes_; }
+
+private:
+    struct Record {
+        uint64_t turn;
+        uint32_t text;
+        uint32_t repeat;
+        MessageKind kind;
+    };
+    struct Interned {
+        std::string text;   // po zwolnieniu zostaje pojemność - kolejny napis zwykle jej nie przekroczy
+        uint64_t hash = 0;
+        uint32_t refs = 0;
+    };
+
+    std::vector<Record> ring_;
+    uint32_t head_ = 0;   // indeks najstarszej
+    uint32_t count_ = 0;
+    uint64_t total_ = 0;
+    std::vector<Interned> strings_;
+    std::vector<uint32_t> freeStrings_;
+    std::unordered_map<uint64_t, uint32_t> byHash_;   // kolizja hasha: drugi napis bez wpisu w mapie
+    size_t internedBytes_ = 0;
+
+    uint32_t intern(std::string_view text);
+    void release(uint32_t id);
+};
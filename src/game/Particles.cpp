@@ -0,0 +1,192 @@
+#include "Particles.h"
+#include "core/JobSystem.h"
+#include "core/Simd.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Dla maski żywych pasów: skąd wziąć kolejne wyjścia (najpierw żywe w kolejności, potem dowolne)
+constexpr std::array<std::array<uint8_t, 4>, 16> makeCompactTable()
+{
+    std::array<std::array<uint8_t, 4>, 16> table{};
+    for (uint32_t mask = 0; mask < 16; ++mask) {
+        uint32_t out = 0;
+        for (uint8_t lane = 0; lane < 4; ++lane)
+            if (mask & (1u << lane)) table[mask][out++] = lane;
+        for (; out < 4; ++out) table[mask][out] = 0;
+    }
+    return table;
+}
+constexpr auto kCompact = makeCompactTable();
+
+uint32_t roundUp4(uint32_t n) { return (n + 3) & ~3u; }
+
+template <typename T, typename V>
+void storeCompacted(T* dst, V value, const std::array<uint8_t, 4>& order)
+{
+    alignas(16) T lanes[4];
+    simd::store(lanes, value);
+    dst[0] = lanes[order[0]];
+    dst[1] = lanes[order[1]];
+    dst[2] = lanes[order[2]];
+    dst[3] = lanes[order[3]];
+}
+
+}
+
+ParticleSystem::ParticleSystem(uint32_t capacity, uint64_t seed)
+    : rng_(seed)
+{
+    if (capacity == 0) throw std::runtime_error("Particle capacity must be positive");
+    const uint32_t blocks = (capacity + kBlockSize - 1) / kBlockSize;
+    const size_t n = static_cast<size_t>(blocks) * kBlockSize;
+    // Zerowane: życie 0 = martwa, więc ogony bloków od razu spełniają niezmiennik update()
+    x_ = std::make_unique<float[]>(n);
+    y_ = std::make_unique<float[]>(n);
+    vx_ = std::make_unique<float[]>(n);
+    vy_ = std::make_unique<float[]>(n);
+    life_ = std::make_unique<float[]>(n);
+    fade_ = std::make_unique<float[]>(n);
+    size_ = std::make_unique<float[]>(n);
+    color_ = std::make_unique<uint32_t[]>(n);
+    counts_.assign(blocks, 0);
+}
+
+ParticleSystem::Block ParticleSystem::block(uint32_t b) const
+{
+    const size_t base = static_cast<size_t>(b) * kBlockSize;
+    return { x_.get() + base, y_.get() + base, size_.get() + base, color_.get() + base, counts_[b] };
+}
+
+uint32_t ParticleSystem::emit(const ParticleBurst& burst, uint32_t count)
+{
+    uint32_t emitted = 0;
+    for (uint32_t tried = 0; emitted < count && tried < counts_.size(); ++tried) {
+        const uint32_t b = emitBlock_;
+        uint32_t& n = counts_[b];
+        const size_t base = static_cast<size_t>(b) * kBlockSize;
+        const uint32_t take = std::min(count - emitted, kBlockSize - n);
+        for (uint32_t k = 0; k < take; ++k) {
+            const size_t i = base + n + k;
+            const float angle = rng_.unit() * 6.2831853f;
+            const float speed = burst.speedMin + (burst.speedMax - burst.speedMin) * rng_.unit();
+            const float life = burst.lifeMin + (burst.lifeMax - burst.lifeMin) * rng_.unit();
+            x_[i] = burst.x;
+            y_[i] = burst.y;
+            vx_[i] = std::cos(angle) * speed;
+            vy_[i] = std::sin(angle) * speed;
+            life_[i] = life;
+            fade_[i] = life > 0.0f ? 1.0f / life : 0.0f;
+            size_[i] = burst.size;
+            color_[i] = burst.color;
+        }
+        n += take;
+        emitted += take;
+        // Niezmiennik: pasy do pełnej czwórki za ostatnią cząstką są martwe
+        for (uint32_t i = n; i < roundUp4(n); ++i) life_[base + i] = 0.0f;
+        if (n == kBlockSize) emitBlock_ = (emitBlock_ + 1) % static_cast<uint32_t>(counts_.size());
+    }
+    alive_ += emitted;
+    dropped_ += count - emitted;
+    return emitted;
+}
+
+void ParticleSystem::updateBlock(uint32_t b, float dt)
+{
+    const size_t base = static_cast<size_t>(b) * kBlockSize;
+    float* x = x_.get() + base;
+    float* y = y_.get() + base;
+    float* vx = vx_.get() + base;
+    float* vy = vy_.get() + base;
+    float* life = life_.get() + base;
+    float* fade = fade_.get() + base;
+    float* size = size_.get() + base;
+    uint32_t* color = color_.get() + base;
+
+    const simd::f32x4 vdt = simd::splat(dt);
+    const simd::f32x4 gx = simd::splat(gravityX_ * dt), gy = simd::splat(gravityY_ * dt);
+    const simd::f32x4 damping = simd::splat(1.0f / (1.0f + drag_ * dt));
+    const simd::f32x4 zero = simd::splat(0.0f), one = simd::splat(1.0f), alphaScale = simd::splat(255.0f);
+    const simd::u32x4 rgbMask = simd::splat(0x00FFFFFFu);
+
+    const uint32_t end = roundUp4(counts_[b]);
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < end; i += 4) {
+        const simd::f32x4 nvx = (simd::load(vx + i) + gx) * damping;
+        const simd::f32x4 nvy = (simd::load(vy + i) + gy) * damping;
+        const simd::f32x4 nx = simd::load(x + i) + nvx * vdt;
+        const simd::f32x4 ny = simd::load(y + i) + nvy * vdt;
+        const simd::f32x4 nlife = simd::load(life + i) - vdt;
+        const simd::f32x4 f = simd::load(fade + i);
+        const simd::f32x4 alpha = simd::min(simd::max(nlife * f, zero), one) * alphaScale;
+        const simd::u32x4 ncolor = (simd::load(color + i) & rgbMask) | simd::shiftLeft<24>(simd::toU32(alpha));
+        const uint32_t mask = simd::greaterMask(nlife, zero);
+
+        if (mask == 0xF) {
+            // Cała czwórka żyje (prawie zawsze): zwykły zapis, fade i size ruszamy tylko po dziurze
+            simd::store(vx + n, nvx);
+            simd::store(vy + n, nvy);
+            simd::store(x + n, nx);
+            simd::store(y + n, ny);
+            simd::store(life + n, nlife);
+            simd::store(color + n, ncolor);
+            if (n != i) {
+                simd::store(fade + n, f);
+                simd::store(size + n, simd::load(size + i));
+            }
+        } else {
+            // Zawsze 4 zapisy pod n <= i - nadpisują tylko już wczytane albo martwe pasy
+            const auto& order = kCompact[mask];
+            const simd::f32x4 s = simd::load(size + i);
+            storeCompacted(vx + n, nvx, order);
+            storeCompacted(vy + n, nvy, order);
+            storeCompacted(x + n, nx, order);
+            storeCompacted(y + n, ny, order);
+            storeCompacted(life + n, nlife, order);
+            storeCompacted(fade + n, f, order);
+            storeCompacted(size + n, s, order);
+            storeCompacted(color + n, ncolor, order);
+        }
+        n += static_cast<uint32_t>(std::popcount(mask));
+    }
+    for (uint32_t i = n; i < roundUp4(n); ++i) life[i] = 0.0f;
+    counts_[b] = n;
+}
+
+void ParticleSystem::update(float dt, JobSystem* jobs)
+{
+    if (alive_ == 0) return;
+    const uint32_t blocks = blockCount();
+    if (jobs) {
+        jobs->parallelFor(0, blocks, 1, [this, dt](uint32_t begin, uint32_t end) {
+            for (uint32_t b = begin; b < end; ++b)
+                if (counts_[b]) updateBlock(b, dt);
+        });
+    } else {
+        for (uint32_t b = 0; b < blocks; ++b)
+            if (counts_[b]) updateBlock(b, dt);
+    }
+
+    alive_ = 0;
+    uint32_t emptiest = 0;
+    for (uint32_t b = 0; b < blocks; ++b) {
+        alive_ += counts_[b];
+        if (counts_[b] < counts_[emptiest]) emptiest = b;
+    }
+    emitBlock_ = emptiest;
+}
+
+void ParticleSystem::clear()
+{
+    for (uint32_t b = 0; b < blockCount(); ++b) {
+        const size_t base = static_cast<size_t>(b) * kBlockSize;
+        std::fill(life_.get() + base, life_.get() + base + roundUp4(counts_[b]), 0.0f);
+        counts_[b] = 0;
+    }
+    alive_ = 0;
+    emitBlock_ = 0;
+}
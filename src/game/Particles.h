@@ -0,0 +1,68 @@
+#pragma once
+#include "Rng.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class JobSystem;
+
+// Wybuch cząstek z punktu: kierunki równomiernie po okręgu, prędkość i życie losowe z zakresów
+struct ParticleBurst {
+    float x = 0.0f;
+    float y = 0.0f;
+    float speedMin = 20.0f;      // piksele świata na sekundę
+    float speedMax = 60.0f;
+    float lifeMin = 0.3f;        // sekundy
+    float lifeMax = 0.8f;
+    float size = 1.0f;           // połowa boku kwadratu
+    uint32_t color = 0xFFFFFFFFu; // RGBA8 (R w najniższym bajcie); alfa maleje do zera z życiem
+};
+
+// Efekty (iskry, krew, czary) bez encji: cząstki w tablicach SoA o stałej pojemności, podzielonych
+// na bloki po kBlockSize. update() liczy 4 cząstki naraz (core/Simd.h) i w tym samym przejściu
+// ściska żywe na początek bloku - maska żywych pasów wybiera permutację z tablicy, bez rozgałęzień
+// per cząstka. Bloki są niezależne, więc idą równolegle na JobSystem. Po starcie nic nie alokuje.
+class ParticleSystem {
+public:
+    static constexpr uint32_t kBlockSize = 16384;
+
+    struct Block {
+        const float* x;
+        const float* y;
+        const float* size;
+        const uint32_t* color;
+        uint32_t count;
+    };
+
+    explicit ParticleSystem(uint32_t capacity, uint64_t seed = 1);
+
+    // Zwraca, ile cząstek się zmieściło (reszta przepada i trafia do dropped())
+    uint32_t emit(const ParticleBurst& burst, uint32_t count);
+    void update(float dt, JobSystem* jobs = nullptr);
+    void clear();
+
+    void setGravity(float x, float y) { gravityX_ = x; gravityY_ = y; }
+    void setDrag(float drag) { drag_ = drag; }   // ułamek prędkości traconej na sekundę (w przybliżeniu)
+
+    uint32_t alive() const { return alive_; }
+    uint32_t capacity() const { return static_cast<uint32_t>(counts_.size()) * kBlockSize; }
+    uint64_t dropped() const { return dropped_; }
+
+    uint32_t blockCount() const { return static_cast<uint32_t>(counts_.size()); }
+    Block block(uint32_t b) const;
+
+private:
+    // Jedna tablica na pole, blok b zajmuje [b * kBlockSize, (b + 1) * kBlockSize)
+    std::unique_ptr<float[]> x_, y_, vx_, vy_, life_, fade_, size_;   // fade = 1 / życie początkowe
+    std::unique_ptr<uint32_t[]> color_;
+    std::vector<uint32_t> counts_;
+    uint32_t emitBlock_ = 0;   // od którego bloku szukać miejsca
+    uint32_t alive_ = 0;
+    uint64_t dropped_ = 0;
+    float gravityX_ = 0.0f;
+    float gravityY_ = 0.0f;
+    float drag_ = 0.0f;
+    Rng rng_;
+
+    void updateBlock(uint32_t b, float dt);
+};
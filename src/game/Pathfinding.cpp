@@ -0,0 +1,296 @@
+#include "Pathfinding.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+int sign(int v) { return (v > 0) - (v < 0); }
+
+constexpr int kDirs[8][2] = {
+    { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+    { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 },
+};
+}
+
+// --- OpenList ---
+
+void Pathfinder::OpenList::push(uint32_t f, uint32_t g, TileIndex node)
+{
+    const uint64_t key = (static_cast<uint64_t>(f) << 32) | (std::numeric_limits<uint32_t>::max() - g);
+    heap_.push_back({ key, node });
+    std::push_heap(heap_.begin(), heap_.end(), [](const Entry& a, const Entry& b) { return a.key > b.key; });
+}
+
+TileIndex Pathfinder::OpenList::pop()
+{
+    std::pop_heap(heap_.begin(), heap_.end(), [](const Entry& a, const Entry& b) { return a.key > b.key; });
+    TileIndex n = heap_.back().node;
+    heap_.pop_back();
+    return n;
+}
+
+// --- Pathfinder ---
+
+Pathfinder::Pathfinder(const TileMap& map) : map_(map) {}
+
+void Pathfinder::ensureStorage()
+{
+    if (width_ == map_.width() && height_ == map_.height() && g_.size() == map_.size())
+        return;
+    width_ = map_.width();
+    height_ = map_.height();
+    g_.assign(map_.size(), 0);
+    parent_.assign(map_.size(), 0);
+    stamp_.assign(map_.size(), 0);
+    region_.assign(map_.size(), 0);
+    generation_ = 0;
+    regionsValid_ = false;
+    open_.reserve(map_.size() / 4 + 64);
+}
+
+void Pathfinder::beginQuery()
+{
+    ensureStorage();
+    // Przepełnienie licznika generacji - jedyny moment, kiedy czyścimy stemple
+    if (generation_ >= std::numeric_limits<uint32_t>::max() - 3) {
+        std::fill(stamp_.begin(), stamp_.end(), 0u);
+        generation_ = 0;
+    }
+    generation_ += 2;
+    open_.clear();
+    lastCost_ = 0;
+    lastExpanded_ = 0;
+}
+
+void Pathfinder::updateRegions()
+{
+    if (regionsValid_ && regionRevision_ == map_.revision()) return;
+
+    std::fill(region_.begin(), region_.end(), 0u);
+    uint32_t next = 0;
+    for (TileIndex seed = 0; seed < region_.size(); ++seed) {
+        if (region_[seed] || !(map_.data()[seed] & TileWalkable)) continue;
+        ++next;
+        region_[seed] = next;
+        floodStack_.push_back(seed);
+        while (!floodStack_.empty()) {
+            const TileIndex cur = floodStack_.back();
+            floodStack_.pop_back();
+            const int x = static_cast<int>(cur % width_);
+            const int y = static_cast<int>(cur / width_);
+            for (int k = 0; k < 4; ++k) {
+                const int nx = x + kDirs[k][0], ny = y + kDirs[k][1];
+                if (!map_.walkable(nx, ny)) continue;
+                const TileIndex n = map_.index(nx, ny);
+                if (region_[n]) continue;
+                region_[n] = next;
+                floodStack_.push_back(n);
+            }
+        }
+    }
+    regionRevision_ = map_.revision();
+    regionsValid_ = true;
+}
+
+uint32_t Pathfinder::heuristic(TileIndex a, TileIndex b) const
+{
+    const int dx = std::abs(static_cast<int>(a % width_) - static_cast<int>(b % width_));
+    const int dy = std::abs(static_cast<int>(a / width_) - static_cast<int>(b / width_));
+    const uint32_t lo = static_cast<uint32_t>(std::min(dx, dy));
+    const uint32_t hi = static_cast<uint32_t>(std::max(dx, dy));
+    return kStraightCost * hi + (kDiagonalCost - kStraightCost) * lo;
+}
+
+void Pathfinder::relax(TileIndex from, TileIndex to, uint32_t stepCost, TileIndex goal)
+{
+    if (isClosed(to)) return;
+    const uint32_t ng = g_[from] + stepCost;
+    if (isSeen(to) && ng >= g_[to]) return;
+    g_[to] = ng;
+    parent_[to] = from;
+    stamp_[to] = generation_;
+    open_.push(ng + heuristic(to, goal), ng, to);
+}
+
+bool Pathfinder::findPath(TilePos start, TilePos goal, std::vector<TilePos>& out, Algorithm algo)
+{
+    out.clear();
+    if (!map_.inBounds(start.x, start.y) || !map_.walkable(goal.x, goal.y))
+        return false;
+
+    ensureStorage();
+    updateRegions();
+    const TileIndex s = map_.index(start.x, start.y);
+    const TileIndex t = map_.index(goal.x, goal.y);
+    // Start na nieprzechodnim kaflu (np. zamknięte drzwi) nie ma regionu - wtedy szukamy normalnie
+    if (region_[s] && region_[s] != region_[t])
+        return false;
+
+    beginQuery();
+
+    g_[s] = 0;
+    parent_[s] = s;
+    stamp_[s] = generation_;
+    open_.push(heuristic(s, t), 0, s);
+
+    const bool found = (algo == Algorithm::JumpPoint) ? searchJumpPoint(s, t) : searchAStar(s, t);
+    if (!found) return false;
+
+    lastCost_ = g_[t];
+    buildPath(s, t, out);
+    return true;
+}
+
+bool Pathfinder::searchAStar(TileIndex start, TileIndex goal)
+{
+    (void)start;
+    while (!open_.empty()) {
+        const TileIndex cur = open_.pop();
+        if (isClosed(cur)) continue;
+        stamp_[cur] = generation_ + 1;
+        ++lastExpanded_;
+        if (cur == goal) return true;
+
+        const int x = static_cast<int>(cur % width_);
+        const int y = static_cast<int>(cur / width_);
+        for (const auto& d : kDirs) {
+            const int nx = x + d[0], ny = y + d[1];
+            if (!map_.walkable(nx, ny)) continue;
+            const bool diagonal = d[0] != 0 && d[1] != 0;
+            if (diagonal && (!map_.walkable(x + d[0], y) || !map_.walkable(x, y + d[1]))) continue;
+            relax(cur, map_.index(nx, ny), diagonal ? kDiagonalCost : kStraightCost, goal);
+        }
+    }
+    return false;
+}
+
+// Skok z (x, y) w kierunku (dx, dy). Wariant JPS bez ścinania rogów - ruch po przekątnej
+// wymaga wolnych obu sąsiadów ortogonalnych, więc wymuszeni sąsiedzi pojawiają się tylko
+// przy ruchu prostym, a przekątna szuka punktów skoku na swoich dwóch składowych.
+bool Pathfinder::jump(int x, int y, int dx, int dy, TileIndex goal, TileIndex& out) const
+{
+    for (;;) {
+        const int nx = x + dx, ny = y + dy;
+        if (!map_.walkable(nx, ny)) return false;
+        if (dx != 0 && dy != 0 && (!map_.walkable(x + dx, y) || !map_.walkable(x, y + dy))) return false;
+        x = nx;
+        y = ny;
+
+        const TileIndex idx = map_.index(x, y);
+        if (idx == goal) { out = idx; return true; }
+
+        if (dx != 0 && dy != 0) {
+            TileIndex unused = 0;
+            if (jump(x, y, dx, 0, goal, unused) || jump(x, y, 0, dy, goal, unused)) { out = idx; return true; }
+        } else if (dx != 0) {
+            if ((map_.walkable(x, y - 1) && !map_.walkable(x - dx, y - 1)) ||
+                (map_.walkable(x, y + 1) && !map_.walkable(x - dx, y + 1))) { out = idx; return true; }
+        } else {
+            if ((map_.walkable(x - 1, y) && !map_.walkable(x - 1, y - dy)) ||
+                (map_.walkable(x + 1, y) && !map_.walkable(x + 1, y - dy))) { out = idx; return true; }
+        }
+    }
+}
+
+bool Pathfinder::searchJumpPoint(TileIndex start, TileIndex goal)
+{
+    (void)start;
+    int dirs[8][2];
+    while (!open_.empty()) {
+        const TileIndex cur = open_.pop();
+        if (isClosed(cur)) continue;
+        stamp_[cur] = generation_ + 1;
+        ++lastExpanded_;
+        if (cur == goal) return true;
+
+        const int x = static_cast<int>(cur % width_);
+        const int y = static_cast<int>(cur / width_);
+
+        // Przycinanie sąsiadów względem kierunku, z którego przyszliśmy
+        int n = 0;
+        const TileIndex par = parent_[cur];
+        if (par == cur) {
+            for (const auto& d : kDirs) { dirs[n][0] = d[0]; dirs[n][1] = d[1]; ++n; }
+        } else {
+            const int dx = sign(x - static_cast<int>(par % width_));
+            const int dy = sign(y - static_cast<int>(par / width_));
+            auto add = [&](int ax, int ay) { dirs[n][0] = ax; dirs[n][1] = ay; ++n; };
+            if (dx != 0 && dy != 0) {
+                add(0, dy);
+                add(dx, 0);
+                add(dx, dy);
+            } else if (dx != 0) {
+                add(dx, 0);
+                add(dx, 1);
+                add(dx, -1);
+                add(0, 1);
+                add(0, -1);
+            } else {
+                add(0, dy);
+                add(1, dy);
+                add(-1, dy);
+                add(1, 0);
+                add(-1, 0);
+            }
+        }
+
+        for (int i = 0; i < n; ++i) {
+            TileIndex jp = 0;
+            if (!jump(x, y, dirs[i][0], dirs[i][1], goal, jp)) continue;
+            relax(cur, jp, heuristic(cur, jp), goal);
+        }
+    }
+    return false;
+}
+
+void Pathfinder::buildPath(TileIndex start, TileIndex goal, std::vector<TilePos>& out) const
+{
+    // Idziemy od celu po rodzicach; między punktami skoku uzupełniamy kafle pośrednie
+    TileIndex cur = goal;
+    out.push_back(map_.pos(cur));
+    while (cur != start) {
+        const TileIndex par = parent_[cur];
+        TilePos p = map_.pos(cur);
+        const TilePos target = map_.pos(par);
+        const int sx = sign(target.x - p.x), sy = sign(target.y - p.y);
+        while (!(p == target)) {
+            p.x += sx;
+            p.y += sy;
+            out.push_back(p);
+        }
+        cur = par;
+    }
+    std::reverse(out.begin(), out.end());
+}
+
+// --- PathCache ---
+
+PathCache::PathCache(Pathfinder& pathfinder, const TileMap& map, size_t slots)
+    : pathfinder_(pathfinder), map_(map), slots_(slots ? slots : 1) {}
+
+bool PathCache::findPath(TilePos start, TilePos goal, std::vector<TilePos>& out)
+{
+    const uint64_t h = (static_cast<uint64_t>(map_.index(start.x, start.y)) * 0x9E3779B97F4A7C15ull)
+                     ^ (static_cast<uint64_t>(map_.index(goal.x, goal.y)) * 0xC2B2AE3D27D4EB4Full);
+    Slot& slot = slots_[(h >> 32) % slots_.size()];
+
+    if (slot.valid && slot.revision == map_.revision() && slot.start == start && slot.goal == goal) {
+        ++hits_;
+        out.assign(slot.path.begin(), slot.path.end());
+        return slot.reachable;
+    }
+
+    ++misses_;
+    slot.start = start;
+    slot.goal = goal;
+    slot.revision = map_.revision();
+    slot.reachable = pathfinder_.findPath(start, goal, slot.path);
+    slot.valid = true;
+    out.assign(slot.path.begin(), slot.path.end());
+    return slot.reachable;
+}
+
+void PathCache::clear()
+{
+    for (auto& s : slots_) s.valid = false;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "TileMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Wyszukiwanie ścieżek po siatce 8-kierunkowej (bez ścinania rogów).
+// Stan węzłów trzymany w płaskich tablicach indeksowanych kaflem i oznaczany numerem
+// generacji, więc między zapytaniami niczego nie czyścimy. Po pierwszym zapytaniu
+// na danej mapie findPath nie alokuje (o ile wektor wynikowy ma już pojemność).
+class Pathfinder {
+public:
+    enum class Algorithm { AStar, JumpPoint };
+
+    static constexpr uint32_t kStraightCost = 10;
+    static constexpr uint32_t kDiagonalCost = 14;
+
+    explicit Pathfinder(const TileMap& map);
+
+    // Zwraca false gdy celu nie da się osiągnąć. out zawiera kafle od startu do celu włącznie.
+    bool findPath(TilePos start, TilePos goal, std::vector<TilePos>& out,
+                  Algorithm algo = Algorithm::JumpPoint);
+
+    uint32_t lastPathCost() const { return lastCost_; }
+    uint32_t lastExpanded() const { return lastExpanded_; }
+
+private:
+    // Kopiec binarny na wielokrotnie używanym wektorze; duplikaty wpisów odrzucamy przy zdejmowaniu.
+    class OpenList {
+    public:
+        struct Entry {
+            uint64_t key;   // f w starszych bitach, odwrócone g w młodszych (remisy -> większe g)
+            TileIndex node;
+        };
+        void clear() { heap_.clear(); }
+        bool empty() const { return heap_.empty(); }
+        void reserve(size_t n) { heap_.reserve(n); }
+        void push(uint32_t f, uint32_t g, TileIndex node);
+        TileIndex pop();
+    private:
+        std::vector<Entry> heap_;
+    };
+
+    const TileMap& map_;
+    int width_ = 0;
+    int height_ = 0;
+
+    std::vector<uint32_t> g_;
+    std::vector<TileIndex> parent_;
+    // stamp_ == generation_ -> węzeł odwiedzony, generation_ + 1 -> zamknięty
+    std::vector<uint32_t> stamp_;
+    uint32_t generation_ = 0;
+
+    OpenList open_;
+
+    // Etykiety spójnych obszarów - zapytanie o nieosiągalny cel odrzucamy bez zalewania mapy.
+    // Przy zakazie ścinania rogów wystarcza spójność 4-kierunkowa.
+    std::vector<uint32_t> region_;
+    std::vector<TileIndex> floodStack_;
+    uint32_t regionRevision_ = 0;
+    bool regionsValid_ = false;
+
+    uint32_t lastCost_ = 0;
+    uint32_t lastExpanded_ = 0;
+
+    void ensureStorage();
+    void beginQuery();
+    void updateRegions();
+    bool isClosed(TileIndex i) const { return stamp_[i] == generation_ + 1; }
+    bool isSeen(TileIndex i) const { return stamp_[i] == generation_ || stamp_[i] == generation_ + 1; }
+    void relax(TileIndex from, TileIndex to, uint32_t stepCost, TileIndex goal);
+    uint32_t heuristic(TileIndex a, TileIndex b) const;
+
+    bool searchAStar(TileIndex start, TileIndex goal);
+    bool searchJumpPoint(TileIndex start, TileIndex goal);
+    bool jump(int x, int y, int dx, int dy, TileIndex goal, TileIndex& out) const;
+    void buildPath(TileIndex start, TileIndex goal, std::vector<TilePos>& out) const;
+};
+
+// Mały cache ścieżek (mapowany bezpośrednio po parze start/cel).
+// Wpisy są unieważniane, gdy zmienia się TileMap::revision().
+class PathCache {
+public:
+    explicit PathCache(Pathfinder& pathfinder, const TileMap& map, size_t slots = 256);
+
+    bool findPath(TilePos start, TilePos goal, std::vector<TilePos>& out);
+    void clear();
+
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+
+private:
+    struct Slot {
+        TilePos start{ -1, -1 };
+        TilePos goal{ -1, -1 };
+        uint32_t revision = 0;
+        bool valid = false;
+        bool reachable = false;
+        std::vector<TilePos> path;
+    };
+
+    Pathfinder& pathfinder_;
+    const TileMap& map_;
+    std::vector<Slot> slots_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
@@ -0,0 +1,158 @@
+#include "Prefab.h"
+#include "Animation.h"
+#include "core/Hash.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace prefabfmt;
+
+namespace {
+
+size_t alignUp(size_t v) { return (v + 7) & ~size_t(7); }
+
+bool readFile(const std::string& path, std::string& out)
+{
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+} // namespace
+
+uint64_t PrefabTable::sourceHash(std::string_view prefabText, std::string_view animationText)
+{
+    // Klipy rozwiązujemy do tekstur arkuszy, więc zmiana animations.txt też unieważnia tabelę
+    return hashString(prefabText) * 31 + hashString(animationText);
+}
+
+std::vector<uint8_t> PrefabTable::compile(std::string_view text, const AnimationLibrary& animations, uint64_t sourceHash)
+{
+    std::istringstream in{ std::string(text) };
+    std::string line;
+    int lineNo = 0;
+    auto fail = [&](const std::string& what) {
+        throw std::runtime_error("prefabs:" + std::to_string(lineNo) + ": " + what);
+    };
+
+    std::vector<PrefabRecord> records;
+    std::vector<std::string> paths;
+    auto pathIndex = [&](const std::string& path) {
+        auto it = std::find(paths.begin(), paths.end(), path);
+        if (it != paths.end()) return static_cast<uint32_t>(it - paths.begin());
+        paths.push_back(path);
+        return static_cast<uint32_t>(paths.size() - 1);
+    };
+
+    while (std::getline(in, line)) {
+        ++lineNo;
+        std::istringstream ls(line);
+        std::string kind;
+        if (!(ls >> kind) || kind[0] == '#') continue;
+        if (kind != "prefab") fail("unknown entry " + kind);
+
+        std::string name, source, ref;
+        PrefabRecord r;
+        if (!(ls >> name >> source >> ref >> r.width >> r.height) || !r.width || !r.height)
+            fail("expected: prefab <name> <sprite|clip> <path|clip> <width> <height>");
+        r.nameHash = hashString(name);
+        if (source == "sprite") {
+            r.pathIndex = pathIndex(ref);
+        } else if (source == "clip") {
+            const int clip = animations.findClip(ref);
+            if (clip < 0) fail("unknown clip " + ref);
+            r.clipHash = hashString(ref);
+            r.pathIndex = pathIndex(animations.sheets()[animations.clip(static_cast<uint16_t>(clip)).sheet].path);
+        } else {
+            fail("prefab source must be sprite or clip");
+        }
+        for (const PrefabRecord& other : records)
+            if (other.nameHash == r.nameHash) fail("duplicate prefab " + name);
+        records.push_back(r);
+    }
+    std::sort(records.begin(), records.end(), [](const PrefabRecord& a, const PrefabRecord& b) { return a.nameHash < b.nameHash; });
+
+    size_t namesBytes = 0;
+    for (const std::string& p : paths) namesBytes += p.size();
+    const size_t recordsOff = alignUp(sizeof(FileHeader));
+    const size_t pathsOff = recordsOff + sizeof(PrefabRecord) * records.size();
+    const size_t namesOff = pathsOff + sizeof(PathRecord) * paths.size();
+    std::vector<uint8_t> out(alignUp(namesOff + namesBytes), 0);
+
+    FileHeader h{};
+    h.magic = kMagic;
+    h.version = kVersion;
+    h.sourceHash = sourceHash;
+    h.prefabCount = static_cast<uint32_t>(records.size());
+    h.pathCount = static_cast<uint32_t>(paths.size());
+    h.namesBytes = static_cast<uint32_t>(namesBytes);
+    std::memcpy(out.data(), &h, sizeof(h));
+    if (!records.empty())
+        std::memcpy(out.data() + recordsOff, records.data(), sizeof(PrefabRecord) * records.size());
+    uint32_t nameOffset = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        const PathRecord pr{ hashString(paths[i]), nameOffset, static_cast<uint32_t>(paths[i].size()) };
+        std::memcpy(out.data() + pathsOff + sizeof(PathRecord) * i, &pr, sizeof(pr));
+        std::memcpy(out.data() + namesOff + nameOffset, paths[i].data(), paths[i].size());
+        nameOffset += static_cast<uint32_t>(paths[i].size());
+    }
+    return out;
+}
+
+bool PrefabTable::load(std::span<const uint8_t> data)
+{
+    *this = {};
+    if (data.size() < sizeof(FileHeader)) return false;
+    FileHeader h;
+    std::memcpy(&h, data.data(), sizeof(h));
+    if (h.magic != kMagic) return false;
+    if (h.version != kVersion)
+        throw std::runtime_error("Unsupported prefab table version " + std::to_string(h.version));
+
+    const size_t recordsOff = alignUp(sizeof(FileHeader));
+    const size_t pathsOff = recordsOff + sizeof(PrefabRecord) * size_t(h.prefabCount);
+    const size_t namesOff = pathsOff + sizeof(PathRecord) * size_t(h.pathCount);
+    if (namesOff + h.namesBytes > data.size()) return false;
+
+    // Własna kopia: wektor daje wyrównanie dla rekordów 64-bit niezależnie od źródła danych
+    data_.assign(data.begin(), data.end());
+    prefabs_ = { reinterpret_cast<const PrefabRecord*>(data_.data() + recordsOff), h.prefabCount };
+    paths_ = { reinterpret_cast<const PathRecord*>(data_.data() + pathsOff), h.pathCount };
+    names_ = reinterpret_cast<const char*>(data_.data() + namesOff);
+    for (const PathRecord& p : paths_)
+        if (size_t(p.nameOffset) + p.nameLength > h.namesBytes) { *this = {}; return false; }
+    for (const PrefabRecord& r : prefabs_)
+        if (r.pathIndex >= h.pathCount) { *this = {}; return false; }
+    return true;
+}
+
+void PrefabTable::loadFiles(const std::string& binaryPath, const std::string& textPath, const std::string& animationPath,
+    const AnimationLibrary& animations)
+{
+    std::string text, animationText;
+    if (!readFile(textPath, text)) throw std::runtime_error("Failed to open " + textPath);
+    if (!readFile(animationPath, animationText)) throw std::runtime_error("Failed to open " + animationPath);
+    const uint64_t hash = sourceHash(text, animationText);
+
+    std::string binary;
+    if (readFile(binaryPath, binary)) {
+        const std::span<const uint8_t> bytes{ reinterpret_cast<const uint8_t*>(binary.data()), binary.size() };
+        if (load(bytes) && sourceHash() == hash) return;
+        std::cerr << "[Prefabs] " << binaryPath << " is out of date - compiling " << textPath << std::endl;
+    }
+    if (!load(compile(text, animations, hash)))
+        throw std::runtime_error("Failed to compile " + textPath);
+}
+
+int PrefabTable::find(uint64_t nameHash) const
+{
+    auto it = std::lower_bound(prefabs_.begin(), prefabs_.end(), nameHash,
+        [](const PrefabRecord& r, uint64_t h) { return r.nameHash < h; });
+    return it != prefabs_.end() && it->nameHash == nameHash ? static_cast<int>(it - prefabs_.begin()) : -1;
+}
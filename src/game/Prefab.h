@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class AnimationLibrary;
+
+// Rekord prefabu w skompilowanej tabeli (POD, czytany wprost z pliku). Odwołania do assetów
+// są już rozwiązane: tekstura to indeks w tabeli ścieżek, klip to hash nazwy.
+struct PrefabRecord {
+    uint64_t nameHash = 0;    // hashString(nazwa prefabu)
+    uint64_t clipHash = 0;    // hashString(nazwa klipu); 0 = sprite statyczny
+    uint32_t pathIndex = 0;   // tekstura (przy klipie: tekstura jego arkusza)
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t reserved = 0;
+};
+
+// Format pliku .rlpf: nagłówek, rekordy posortowane po nameHash, ścieżki tekstur.
+// sourceHash pozwala poznać, że plik jest starszy niż prefabs.txt / animations.txt.
+namespace prefabfmt {
+
+constexpr uint32_t kMagic = 0x46504C52;   // "RLPF"
+constexpr uint32_t kVersion = 1;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash;
+    uint32_t prefabCount;
+    uint32_t pathCount;
+    uint32_t namesBytes;
+    uint32_t reserved;
+};
+
+struct PathRecord {
+    uint64_t hash;         // hashString(ścieżka)
+    uint32_t nameOffset;   // w bloku nazw za tablicą ścieżek
+    uint32_t nameLength;
+};
+
+} // namespace prefabfmt
+
+// Tekst prefabów (assets/prefabs.txt):
+//   prefab <nazwa> sprite <plik png> <szer.> <wys.>
+//   prefab <nazwa> clip <klip z animations.txt> <szer.> <wys.>
+// Kompilacja (roguelike_prefabc albo w locie, gdy pliku .rlpf brak) rozwiązuje klipy do tekstur
+// arkuszy i deduplikuje ścieżki. W grze prefab wybiera się indeksem z find() - bez napisów.
+class PrefabTable {
+public:
+    static uint64_t sourceHash(std::string_view prefabText, std::string_view animationText);
+    // Wyjątek z numerem linii przy błędzie
+    static std::vector<uint8_t> compile(std::string_view text, const AnimationLibrary& animations, uint64_t sourceHash);
+
+    // false, gdy dane są ucięte albo to nie jest tabela prefabów; wyjątek przy nieznanej wersji
+    bool load(std::span<const uint8_t> data);
+    // Plik .rlpf, o ile jest aktualny; w przeciwnym razie kompiluje tekst w pamięci
+    void loadFiles(const std::string& binaryPath, const std::string& textPath, const std::string& animationPath,
+        const AnimationLibrary& animations);
+
+    uint64_t sourceHash() const { return data_.empty() ? 0 : header().sourceHash; }
+    std::span<const PrefabRecord> prefabs() const { return prefabs_; }
+    int find(uint64_t nameHash) const;   // -1 gdy brak
+
+    uint32_t pathCount() const { return static_cast<uint32_t>(paths_.size()); }
+    uint64_t pathHash(uint32_t i) const { return paths_[i].hash; }
+    std::string_view path(uint32_t i) const { return { names_ + paths_[i].nameOffset, paths_[i].nameLength }; }
+
+private:
+    std::vector<uint8_t> data_;
+    std::span<const PrefabRecord> prefabs_;
+    std::span<const prefabfmt::PathRecord> paths_;
+    const char* names_ = nullptr;
+
+    const prefabfmt::FileHeader& header() const { return *reinterpret_cast<const prefabfmt::FileHeader*>(data_.data()); }
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+
+// xoshiro256** - szybki, deterministyczny generator z jawnym stanem (zapis gry, powtórki).
+// Spełnia wymagania UniformRandomBitGenerator, więc działa z <random>.
+class Rng {
+public:
+    using State = std::array<uint64_t, 4>;
+    using result_type = uint64_t;
+
+    explicit Rng(uint64_t seed = 0x853C49E6748FEA9Bull) { reseed(seed); }
+
+    void reseed(uint64_t seed) {
+        // splitmix64 rozprowadza ziarno po całym stanie
+        for (auto& s : state_) {
+            seed += 0x9E3779B97F4A7C15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            s = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    // [0, n) bez dzielenia (Lemire); n > 0
+    uint32_t below(uint32_t n) { return static_cast<uint32_t>(((next() >> 32) * n) >> 32); }
+    // [lo, hi] włącznie
+    int range(int lo, int hi) { return lo + static_cast<int>(below(static_cast<uint32_t>(hi - lo + 1))); }
+    float unit() { return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f); }
+
+    const State& state() const { return state_; }
+    void setState(const State& s) { state_ = s; }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    result_type operator()() { return next(); }
+
+private:
+    State state_{};
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
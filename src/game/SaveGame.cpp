@@ -0,0 +1,422 @@
+#include "SaveGame.h"
+#include "core/AllocTracker.h"
+#include "core/Hash.h"
+#include "core/Log.h"
+#include "core/MappedFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+using namespace savefmt;
+
+namespace {
+
+constexpr uint32_t kMaxSections = 4;
+
+size_t alignUp(size_t v) { return (v + 7) & ~size_t(7); }
+
+// Dokłada do bufora wyrównany do 8 bajtów obszar i zwraca jego offset
+size_t grow(std::vector<uint8_t>& buf, size_t bytes)
+{
+    const size_t offset = alignUp(buf.size());
+    buf.resize(offset + bytes);
+    return offset;
+}
+
+template <typename T>
+T* at(std::vector<uint8_t>& buf, size_t offset) { return reinterpret_cast<T*>(buf.data() + offset); }
+
+int chunksAlong(int tiles) { return (tiles + kChunkSize - 1) / kChunkSize; }
+
+// Kopiuje chunk (cx, cy) z siatki do 32x32 bajtów; poza mapą zostaje TileWall
+void readChunk(const uint8_t* tiles, int width, int height, uint32_t chunk, uint8_t* out)
+{
+    const int cx = static_cast<int>(chunk % chunksAlong(width)) * kChunkSize;
+    const int cy = static_cast<int>(chunk / chunksAlong(width)) * kChunkSize;
+    const int w = std::min(kChunkSize, width - cx);
+    std::memset(out, TileWall, kChunkBytes);
+    for (int r = 0; r < kChunkSize && cy + r < height; ++r)
+        std::memcpy(out + r * kChunkSize, tiles + static_cast<size_t>(cy + r) * width + cx, w);
+}
+
+void writeChunk(uint8_t* tiles, int width, int height, uint32_t chunk, const uint8_t* in)
+{
+    const int cx = static_cast<int>(chunk % chunksAlong(width)) * kChunkSize;
+    const int cy = static_cast<int>(chunk / chunksAlong(width)) * kChunkSize;
+    const int w = std::min(kChunkSize, width - cx);
+    for (int r = 0; r < kChunkSize && cy + r < height; ++r)
+        std::memcpy(tiles + static_cast<size_t>(cy + r) * width + cx, in + r * kChunkSize, w);
+}
+
+bool chunkEqual(const uint8_t* a, const uint8_t* b, int width, int height, uint32_t chunk)
+{
+    const int cx = static_cast<int>(chunk % chunksAlong(width)) * kChunkSize;
+    const int cy = static_cast<int>(chunk / chunksAlong(width)) * kChunkSize;
+    const int w = std::min(kChunkSize, width - cx);
+    for (int r = 0; r < kChunkSize && cy + r < height; ++r) {
+        const size_t row = static_cast<size_t>(cy + r) * width + cx;
+        if (std::memcmp(a + row, b + row, w) != 0) return false;
+    }
+    return true;
+}
+
+// Serializuje rekord. chunks == nullptr -> wszystkie chunki po kolei (zapis pełny).
+// withEntities == false -> bez sekcji assetów i encji (delta, w której się nie zmieniły).
+void buildRecord(std::vector<uint8_t>& buf, Kind kind, uint64_t baseId, const WorldSnapshot& s,
+    const std::vector<uint32_t>* chunks, bool withEntities)
+{
+    buf.clear();
+    const uint32_t sectionCount = withEntities ? kMaxSections : 2;
+    const size_t headerOff = grow(buf, sizeof(FileHeader));
+    const size_t tableOff = grow(buf, sizeof(SectionHeader) * sectionCount);
+    uint32_t section = 0;
+    auto addSection = [&](Section type, uint32_t count, size_t offset) {
+        SectionHeader& h = at<SectionHeader>(buf, tableOff)[section++];
+        h.type = type;
+        h.count = count;
+        h.offset = offset;
+        h.size = buf.size() - offset;
+    };
+
+    const size_t metaOff = grow(buf, sizeof(MetaRecord));
+    MetaRecord& meta = *at<MetaRecord>(buf, metaOff);
+    meta = {};
+    meta.turn = s.turn;
+    std::copy(s.rng.begin(), s.rng.end(), meta.rng);
+    meta.width = s.width;
+    meta.height = s.height;
+    meta.chunkSize = kChunkSize;
+    addSection(Section::Meta, 1, metaOff);
+
+    const uint32_t chunkCount = chunks ? static_cast<uint32_t>(chunks->size())
+        : static_cast<uint32_t>(chunksAlong(s.width) * chunksAlong(s.height));
+    const size_t indexBytes = chunks ? alignUp(sizeof(uint32_t) * chunkCount) : 0;
+    const size_t chunksOff = grow(buf, indexBytes + kChunkBytes * chunkCount);
+    if (chunks && chunkCount)
+        std::memcpy(at<uint32_t>(buf, chunksOff), chunks->data(), sizeof(uint32_t) * chunkCount);
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        const uint32_t c = chunks ? (*chunks)[i] : i;
+        readChunk(s.tiles.data(), s.width, s.height, c, at<uint8_t>(buf, chunksOff + indexBytes + i * kChunkBytes));
+    }
+    addSection(Section::Chunks, chunkCount, chunksOff);
+
+    if (withEntities) {
+        size_t namesBytes = 0;
+        for (const auto& p : s.assetPaths) namesBytes += p.size();
+        const uint32_t assetCount = static_cast<uint32_t>(s.assetPaths.size());
+        const size_t assetsOff = grow(buf, sizeof(AssetRecord) * assetCount + namesBytes);
+        AssetRecord* records = at<AssetRecord>(buf, assetsOff);
+        char* names = at<char>(buf, assetsOff + sizeof(AssetRecord) * assetCount);
+        uint32_t nameOffset = 0;
+        for (uint32_t i = 0; i < assetCount; ++i) {
+            const std::string& p = s.assetPaths[i];
+            records[i] = { hashString(p), nameOffset, static_cast<uint32_t>(p.size()) };
+            std::memcpy(names + nameOffset, p.data(), p.size());
+            nameOffset += static_cast<uint32_t>(p.size());
+        }
+        addSection(Section::Assets, assetCount, assetsOff);
+
+        const size_t entitiesOff = grow(buf, sizeof(SaveEntity) * s.entities.size());
+        if (!s.entities.empty())
+            std::memcpy(buf.data() + entitiesOff, s.entities.data(), sizeof(SaveEntity) * s.entities.size());
+        addSection(Section::Entities, static_cast<uint32_t>(s.entities.size()), entitiesOff);
+    }
+
+    buf.resize(alignUp(buf.size()));
+    FileHeader& h = *at<FileHeader>(buf, headerOff);
+    h.magic = kMagic;
+    h.version = kVersion;
+    h.kind = kind;
+    h.sectionCount = sectionCount;
+    h.recordSize = buf.size();
+    h.baseId = baseId;
+}
+
+void applyRecord(const RecordView& v, WorldSnapshot& out)
+{
+    const MetaRecord& meta = v.meta();
+    out.turn = meta.turn;
+    std::copy(std::begin(meta.rng), std::end(meta.rng), out.rng.begin());
+    if (v.header().kind == Kind::Full) {
+        out.width = meta.width;
+        out.height = meta.height;
+        out.tiles.assign(static_cast<size_t>(out.width) * out.height, TileWall);
+    } else if (meta.width != out.width || meta.height != out.height) {
+        throw std::runtime_error("Save delta does not match base map size");
+    }
+
+    const uint32_t totalChunks = static_cast<uint32_t>(chunksAlong(out.width) * chunksAlong(out.height));
+    for (uint32_t i = 0; i < v.chunkCount(); ++i) {
+        const uint32_t c = v.chunkIndex(i);
+        if (c >= totalChunks) throw std::runtime_error("Save chunk index out of range");
+        writeChunk(out.tiles.data(), out.width, out.height, c, v.chunkData(i));
+    }
+
+    if (!v.hasEntities()) return;
+    out.entities.assign(v.entities().begin(), v.entities().end());
+    out.assetPaths.clear();
+    for (uint32_t i = 0; i < v.assetCount(); ++i)
+        out.assetPaths.emplace_back(v.assetPath(i));
+}
+
+uint64_t newBaseId()
+{
+    static uint64_t counter = 0;
+    uint64_t id = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    id ^= ++counter * 0x9E3779B97F4A7C15ull;
+    return id ? id : 1;
+}
+
+} // namespace
+
+// --- WorldSnapshot ---
+
+void WorldSnapshot::capture(const World& world)
+{
+    turn = world.turn;
+    rng = world.rng.state();
+    width = world.tiles.width();
+    height = world.tiles.height();
+    tiles.assign(world.tiles.data(), world.tiles.data() + world.tiles.size());
+}
+
+void WorldSnapshot::restore(World& world) const
+{
+    world.turn = turn;
+    world.rng.setState(rng);
+    world.tiles.assign(width, height, tiles.data());
+}
+
+// --- RecordView ---
+
+bool RecordView::parse(const uint8_t* data, size_t size)
+{
+    *this = {};
+    if (size < sizeof(FileHeader)) return false;
+    const auto* h = reinterpret_cast<const FileHeader*>(data);
+    if (h->magic != kMagic) return false;
+    if (h->version != kVersion)
+        throw std::runtime_error("Unsupported save version " + std::to_string(h->version));
+    if (h->recordSize > size || h->recordSize < sizeof(FileHeader) + sizeof(SectionHeader) * h->sectionCount)
+        return false;
+
+    const auto* table = reinterpret_cast<const SectionHeader*>(data + alignUp(sizeof(FileHeader)));
+    for (uint32_t i = 0; i < h->sectionCount; ++i) {
+        const SectionHeader& s = table[i];
+        if (s.offset % 8 != 0 || s.offset > h->recordSize || s.size > h->recordSize - s.offset) return false;
+        const uint8_t* p = data + s.offset;
+        switch (s.type) {
+        case Section::Meta:
+            if (s.size < sizeof(MetaRecord)) return false;
+            meta_ = reinterpret_cast<const MetaRecord*>(p);
+            break;
+        case Section::Assets:
+            if (s.size < sizeof(AssetRecord) * s.count) return false;
+            assets_ = { reinterpret_cast<const AssetRecord*>(p), s.count };
+            names_ = reinterpret_cast<const char*>(p + sizeof(AssetRecord) * s.count);
+            for (const AssetRecord& a : assets_)
+                if (sizeof(AssetRecord) * s.count + a.nameOffset + a.nameLength > s.size) return false;
+            break;
+        case Section::Chunks: {
+            const size_t indexBytes = h->kind == Kind::Delta ? alignUp(sizeof(uint32_t) * s.count) : 0;
+            if (s.size < indexBytes + kChunkBytes * s.count) return false;
+            chunkIndices_ = indexBytes ? reinterpret_cast<const uint32_t*>(p) : nullptr;
+            chunkData_ = p + indexBytes;
+            chunkCount_ = s.count;
+            break;
+        }
+        case Section::Entities:
+            if (s.size < sizeof(SaveEntity) * s.count) return false;
+            entities_ = { reinterpret_cast<const SaveEntity*>(p), s.count };
+            hasEntities_ = true;
+            break;
+        default:
+            break;   // nieznane sekcje z nowszych wersji pomijamy
+        }
+    }
+    if (h->kind == Kind::Full && !hasEntities_) return false;
+    if (!meta_ || meta_->chunkSize != kChunkSize || meta_->width < 0 || meta_->height < 0) return false;
+    header_ = h;
+    return true;
+}
+
+std::string_view RecordView::assetPath(uint32_t i) const
+{
+    return { names_ + assets_[i].nameOffset, assets_[i].nameLength };
+}
+
+// --- SaveSystem ---
+
+SaveSystem::SaveSystem(std::string path) : path_(std::move(path))
+{
+    thread_ = std::thread([this] { threadMain(); });
+}
+
+SaveSystem::~SaveSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+WorldSnapshot* SaveSystem::beginSave()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (pending_ || busy_) ? nullptr : &snapshot_;
+}
+
+void SaveSystem::commitSave(bool incremental)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = true;
+        pendingIncremental_ = incremental;
+    }
+    cv_.notify_all();
+}
+
+bool SaveSystem::busy() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_ || busy_;
+}
+
+void SaveSystem::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !pending_ && !busy_; });
+}
+
+SaveStats SaveSystem::lastStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void SaveSystem::threadMain()
+{
+    AllocScope scope(AllocTag::Save);
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return pending_ || stop_; });
+        if (!pending_) return;
+        pending_ = false;
+        busy_ = true;
+        const bool incremental = pendingIncremental_;
+        lock.unlock();
+
+        SaveStats stats{};
+        try {
+            stats = write(incremental);
+        } catch (const std::exception& e) {
+            logger::error(LogCategory::Save, "Failed: %s", e.what());
+            savedWidth_ = savedHeight_ = 0;   // następny zapis będzie pełny
+        }
+
+        lock.lock();
+        busy_ = false;
+        stats_ = stats;
+        cv_.notify_all();
+    }
+}
+
+SaveStats SaveSystem::write(bool incremental)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const WorldSnapshot& s = snapshot_;
+    const std::string deltaPath = path_ + ".delta";
+    SaveStats stats{};
+
+    const bool haveBase = savedWidth_ == s.width && savedHeight_ == s.height && savedTiles_.size() == s.tiles.size();
+    if (incremental && haveBase) {
+        changed_.clear();
+        const uint32_t total = static_cast<uint32_t>(chunksAlong(s.width) * chunksAlong(s.height));
+        for (uint32_t c = 0; c < total; ++c)
+            if (!chunkEqual(s.tiles.data(), savedTiles_.data(), s.width, s.height, c)) changed_.push_back(c);
+
+        const bool entitiesChanged = s.assetPaths != savedAssets_ || s.entities.size() != savedEntities_.size() ||
+            (!s.entities.empty() && std::memcmp(s.entities.data(), savedEntities_.data(), sizeof(SaveEntity) * s.entities.size()) != 0);
+        buildRecord(buffer_, Kind::Delta, baseId_, s, &changed_, entitiesChanged);
+        // Gdy delty urosną ponad zapis pełny, taniej jest zapisać całość od nowa
+        if (deltaBytes_ + buffer_.size() <= baseBytes_) {
+            std::ofstream out(deltaPath, std::ios::binary | std::ios::app);
+            if (!out) throw std::runtime_error("Failed to open " + deltaPath);
+            out.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+            out.flush();
+            if (!out) throw std::runtime_error("Failed to write " + deltaPath);
+
+            for (uint32_t c : changed_) {
+                uint8_t chunk[kChunkBytes];
+                readChunk(s.tiles.data(), s.width, s.height, c, chunk);
+                writeChunk(savedTiles_.data(), s.width, s.height, c, chunk);
+            }
+            if (entitiesChanged) {
+                savedEntities_ = s.entities;
+                savedAssets_ = s.assetPaths;
+            }
+            deltaBytes_ += buffer_.size();
+            stats.incremental = true;
+            stats.chunksWritten = static_cast<uint32_t>(changed_.size());
+            stats.bytesWritten = buffer_.size();
+            stats.writeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            return stats;
+        }
+    }
+
+    // Zapis pełny: plik tymczasowy + rename, żeby przerwany zapis nie zniszczył poprzedniego
+    baseId_ = newBaseId();
+    buildRecord(buffer_, Kind::Full, baseId_, s, nullptr, true);
+    const std::string tmpPath = path_ + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Failed to open " + tmpPath);
+        out.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+        out.flush();
+        if (!out) throw std::runtime_error("Failed to write " + tmpPath);
+    }
+    std::filesystem::rename(tmpPath, path_);
+    std::error_code ec;
+    std::filesystem::remove(deltaPath, ec);
+
+    savedTiles_ = s.tiles;
+    savedEntities_ = s.entities;
+    savedAssets_ = s.assetPaths;
+    savedWidth_ = s.width;
+    savedHeight_ = s.height;
+    baseBytes_ = buffer_.size();
+    deltaBytes_ = 0;
+    stats.chunksWritten = static_cast<uint32_t>(chunksAlong(s.width) * chunksAlong(s.height));
+    stats.bytesWritten = buffer_.size();
+    stats.writeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+// --- Wczytywanie ---
+
+bool loadWorld(const std::string& path, WorldSnapshot& out)
+{
+    MappedFile base;
+    if (!base.open(path)) return false;
+    RecordView view;
+    if (!view.parse(base.data(), base.size()) || view.header().kind != Kind::Full)
+        throw std::runtime_error("Corrupted save file: " + path);
+    applyRecord(view, out);
+    const uint64_t baseId = view.header().baseId;
+
+    MappedFile delta;
+    if (!delta.open(path + ".delta")) return true;
+    size_t offset = 0;
+    while (offset < delta.size()) {
+        if (!view.parse(delta.data() + offset, delta.size() - offset)) break;
+        if (view.header().kind == Kind::Delta && view.header().baseId == baseId)
+            applyRecord(view, out);
+        offset += view.header().recordSize;
+    }
+    return true;
+}
@@ -0,0 +1,173 @@
+#pragma once
+#include "World.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Rekord encji w pliku zapisu (POD, czytany wprost z mapowania)
+struct SaveEntity {
+    uint64_t spriteHash = 0;   // hashString(ścieżka assetu)
+    float x = 0.0f;
+    float y = 0.0f;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t layer = 1;        // DrawLayer
+    uint32_t reserved = 0;     // bez dziur w rekordzie - zapis przyrostowy porównuje encje memcmp
+};
+
+// Migawka stanu do zapisu. Kopiowana na wątku gry (kilka memcpy), serializowana w tle.
+struct WorldSnapshot {
+    uint64_t turn = 0;
+    Rng::State rng{};
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> tiles;
+    std::vector<SaveEntity> entities;
+    std::vector<std::string> assetPaths;
+
+    void capture(const World& world);   // tiles/rng/turn; pojemność wektorów jest reużywana
+    void restore(World& world) const;
+};
+
+// Format pliku: nagłówek, tabela sekcji, sekcje wyrównane do 8 bajtów. Wszystko little-endian
+// i POD, więc po zmapowaniu pliku czytamy rekordy bez parsowania pól.
+// Zapis pełny: <path>. Zapisy przyrostowe dopisywane są do <path>.delta jako kolejne rekordy
+// tego samego formatu, zawierające tylko zmienione chunki kafli (encje i assety tylko gdy się zmieniły).
+namespace savefmt {
+
+constexpr uint32_t kMagic = 0x56534C52;   // "RLSV"
+constexpr uint32_t kVersion = 2;   // 2: warstwa encji
+constexpr int kChunkSize = 32;
+constexpr size_t kChunkBytes = static_cast<size_t>(kChunkSize) * kChunkSize;
+
+enum class Kind : uint32_t { Full = 0, Delta = 1 };
+enum class Section : uint32_t { Meta = 1, Assets = 2, Chunks = 3, Entities = 4 };
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    Kind kind;
+    uint32_t sectionCount;
+    uint64_t recordSize;   // rozmiar całego rekordu w bajtach (wielokrotność 8)
+    uint64_t baseId;       // rekordy delta pasują tylko do zapisu pełnego o tym samym id
+};
+
+struct SectionHeader {
+    Section type;
+    uint32_t count;
+    uint64_t offset;       // od początku rekordu
+    uint64_t size;
+};
+
+struct MetaRecord {
+    uint64_t turn;
+    uint64_t rng[4];
+    int32_t width;
+    int32_t height;
+    int32_t chunkSize;
+    uint32_t reserved;
+};
+
+struct AssetRecord {
+    uint64_t hash;
+    uint32_t nameOffset;   // w bloku nazw za tablicą rekordów
+    uint32_t nameLength;
+};
+
+// Widok na jeden rekord (pełny lub delta) w pamięci - zwykle prosto w zmapowany plik
+class RecordView {
+public:
+    // false, gdy dane są ucięte albo to nie jest rekord zapisu; wyjątek przy nieznanej wersji
+    bool parse(const uint8_t* data, size_t size);
+
+    const FileHeader& header() const { return *header_; }
+    const MetaRecord& meta() const { return *meta_; }
+    bool hasEntities() const { return hasEntities_; }   // w delcie brak = bez zmian
+    std::span<const SaveEntity> entities() const { return entities_; }
+
+    uint32_t assetCount() const { return static_cast<uint32_t>(assets_.size()); }
+    uint64_t assetHash(uint32_t i) const { return assets_[i].hash; }
+    std::string_view assetPath(uint32_t i) const;
+
+    uint32_t chunkCount() const { return chunkCount_; }
+    uint32_t chunkIndex(uint32_t i) const { return chunkIndices_ ? chunkIndices_[i] : i; }
+    const uint8_t* chunkData(uint32_t i) const { return chunkData_ + i * kChunkBytes; }
+
+private:
+    const FileHeader* header_ = nullptr;
+    const MetaRecord* meta_ = nullptr;
+    std::span<const AssetRecord> assets_;
+    const char* names_ = nullptr;
+    std::span<const SaveEntity> entities_;
+    const uint32_t* chunkIndices_ = nullptr;   // nullptr w zapisie pełnym (chunki po kolei)
+    const uint8_t* chunkData_ = nullptr;
+    uint32_t chunkCount_ = 0;
+    bool hasEntities_ = false;
+};
+
+} // namespace savefmt
+
+struct SaveStats {
+    bool incremental = false;
+    uint32_t chunksWritten = 0;
+    uint64_t bytesWritten = 0;
+    double writeMs = 0.0;
+};
+
+// Zapis w tle: beginSave() oddaje bufor migawki (albo nullptr, gdy poprzedni zapis jeszcze trwa),
+// gra go wypełnia i woła commitSave(). Serializacja, porównanie chunków i zapis na dysk
+// dzieją się w osobnym wątku, więc klatka nie czeka na I/O.
+class SaveSystem {
+public:
+    explicit SaveSystem(std::string path);
+    ~SaveSystem();
+
+    SaveSystem(const SaveSystem&) = delete;
+    SaveSystem& operator=(const SaveSystem&) = delete;
+
+    WorldSnapshot* beginSave();
+    // incremental: dopisz tylko zmienione chunki (o ile istnieje zapis pełny o tych wymiarach)
+    void commitSave(bool incremental);
+
+    bool busy() const;
+    void waitIdle();
+    SaveStats lastStats() const;
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool pending_ = false;
+    bool busy_ = false;
+    bool stop_ = false;
+    bool pendingIncremental_ = false;
+    SaveStats stats_{};
+
+    WorldSnapshot snapshot_;
+    // Stan wątku zapisu
+    std::vector<uint8_t> buffer_;
+    std::vector<uint8_t> savedTiles_;     // kafle z ostatniego zapisu - do wykrywania zmian
+    std::vector<SaveEntity> savedEntities_;
+    std::vector<std::string> savedAssets_;
+    std::vector<uint32_t> changed_;
+    int savedWidth_ = 0;
+    int savedHeight_ = 0;
+    uint64_t baseId_ = 0;
+    uint64_t baseBytes_ = 0;
+    uint64_t deltaBytes_ = 0;
+
+    void threadMain();
+    SaveStats write(bool incremental);
+};
+
+// Wczytuje zapis pełny i nakłada pasujące rekordy z <path>.delta. false, gdy zapisu nie ma.
+// Uszkodzony ogon pliku delta (np. przerwany zapis) jest pomijany.
+bool loadWorld(const std::string& path, WorldSnapshot& out);
@@ -0,0 +1,229 @@
+#include "Simulation.h"
+#include "LevelGen.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+constexpr int kActiveRadius = 10;   // pełne tury
+constexpr int kCoarseRadius = 24;   // dalej potwory śpią, aż gracz podejdzie
+constexpr int kRestBelow = 2;       // gracz odpoczywa przy HP < maxHp / kRestBelow i bez wroga obok
+constexpr int kRandomProbes = 256;  // potem freeTile przechodzi kafle po kolei
+
+int chebyshev(TilePos a, TilePos b) { return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y)); }
+
+// Tylko do dziennika: nazwa z id, bez losowania (ta sama gra z logiem i bez)
+const char* monsterName(uint32_t id)
+{
+    static const char* const kNames[] = { "rat", "goblin", "kobold", "bat", "skeleton", "orc" };
+    return kNames[id % (sizeof(kNames) / sizeof(kNames[0]))];
+}
+}
+
+Simulation::Simulation(uint64_t seed, const SimConfig& config)
+    : config_(config), chase_(world_.tiles), paths_(world_.tiles)
+{
+    world_.rng.reseed(seed);
+    setupWorld(world_);
+    playerStats_ = { config_.playerHp, config_.playerHp, 2, 6 };
+    enterLevel();
+}
+
+void Simulation::enterLevel()
+{
+    generateLevel(world_.tiles, depth_);
+    stats_.depth = std::max(stats_.depth, depth_);
+    occupant_.assign(world_.tiles.size(), kNobody);
+    scheduler_ = TurnScheduler();
+    actors_.clear();
+    positions_.clear();
+
+    // Więcej potworów niż wolnych kafli się nie zmieści - reszta po prostu się nie pojawia
+    uint32_t freeTiles = 0;
+    for (int y = 1; y < world_.tiles.height() - 1; ++y)
+        for (int x = 1; x < world_.tiles.width() - 1; ++x)
+            freeTiles += world_.tiles.walkable(x, y) ? 1u : 0u;
+    if (freeTiles == 0) throw std::runtime_error("Generated level has no walkable tiles");
+
+    player_ = spawnActor(playerStats_, TurnScheduler::kNormalSpeed, 0);
+    monsters_ = std::min(config_.monstersPerLevel + 2 * depth_, freeTiles - 1);
+    for (uint32_t i = 0; i < monsters_; ++i) {
+        const int hp = 4 + static_cast<int>(depth_) + world_.rng.range(0, 4);
+        const Actor monster{ hp, hp, 1, 2 + static_cast<int>(depth_ / 2) };
+        spawnActor(monster, 80 + world_.rng.below(41), world_.rng.below(TurnScheduler::kActionCost));
+    }
+
+    chase_.clearGoals();
+    playerGoal_ = chase_.addGoal(positions_[player_]);
+    chase_.update();
+    chaseDirty_ = false;
+    scheduler_.applyDistanceLod(positions_, positions_[player_], kActiveRadius, kCoarseRadius);
+}
+
+// Losowe próby, a na zatłoczonym piętrze pierwszy wolny kafel od ostatniej próby
+TilePos Simulation::freeTile()
+{
+    const TileMap& tiles = world_.tiles;
+    auto isFree = [&](TilePos p) { return tiles.walkable(p.x, p.y) && occupant_[tiles.index(p.x, p.y)] == kNobody; };
+    TilePos p{};
+    for (int i = 0; i < kRandomProbes; ++i) {
+        p = { world_.rng.range(1, tiles.width() - 2), world_.rng.range(1, tiles.height() - 2) };
+        if (isFree(p)) return p;
+    }
+    const int innerW = tiles.width() - 2, innerH = tiles.height() - 2;
+    const int start = (p.y - 1) * innerW + (p.x - 1);
+    for (int k = 0; k < innerW * innerH; ++k) {
+        const int i = (start + k) % (innerW * innerH);
+        const TilePos q{ 1 + i % innerW, 1 + i / innerW };
+        if (isFree(q)) return q;
+    }
+    throw std::runtime_error("No free tile left on the level");
+}
+
+Simulation::ActorId Simulation::spawnActor(const Actor& actor, uint32_t speed, uint32_t initialDelay)
+{
+    const TilePos pos = freeTile();
+    const ActorId id = scheduler_.addActor(speed, initialDelay);
+    if (id >= actors_.size()) {
+        actors_.resize(id + 1);
+        positions_.resize(id + 1);
+    }
+    actors_[id] = actor;
+    positions_[id] = pos;
+    occupant_[world_.tiles.index(pos.x, pos.y)] = id;
+    return id;
+}
+
+void Simulation::moveActor(ActorId id, TilePos to)
+{
+    const TilePos from = positions_[id];
+    occupant_[world_.tiles.index(from.x, from.y)] = kNobody;
+    occupant_[world_.tiles.index(to.x, to.y)] = id;
+    positions_[id] = to;
+}
+
+void Simulation::attack(ActorId from, ActorId to)
+{
+    const Actor& a = actors_[from];
+    Actor& target = actors_[to];
+    const int damage = world_.rng.range(a.minDamage, a.maxDamage);
+    target.hp -= damage;
+    if (to == player_) {
+        stats_.damageTaken += damage;
+        if (log_) log_->addf(MessageKind::Hurt, stats_.turns, "The %s hits you for %d.", monsterName(from), damage);
+        if (target.hp <= 0) {
+            stats_.died = true;
+            over_ = true;
+            if (log_) log_->addf(MessageKind::Death, stats_.turns, "You die on depth %u.", depth_ + 1);
+        }
+        return;
+    }
+    stats_.damageDealt += damage;
+    if (log_) log_->addf(MessageKind::Combat, stats_.turns, "You hit the %s for %d.", monsterName(to), damage);
+    if (target.hp > 0) return;
+    if (log_) log_->addf(MessageKind::Death, stats_.turns, "The %s dies.", monsterName(to));
+    const TilePos pos = positions_[to];
+    occupant_[world_.tiles.index(pos.x, pos.y)] = kNobody;
+    scheduler_.removeActor(to);
+    --monsters_;
+    ++stats_.kills;
+}
+
+Simulation::ActorId Simulation::weakestNeighbour(TilePos pos) const
+{
+    ActorId best = kNobody;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (!world_.tiles.inBounds(pos.x + dx, pos.y + dy)) continue;
+            const ActorId id = occupant_[world_.tiles.index(pos.x + dx, pos.y + dy)];
+            if (id == kNobody || id == player_) continue;
+            if (best == kNobody || actors_[id].hp < actors_[best].hp) best = id;
+        }
+    }
+    return best;
+}
+
+void Simulation::playerTurn()
+{
+    ++stats_.turns;
+    ++world_.turn;
+    if (stats_.turns >= config_.maxTurns) over_ = true;
+
+    if (monsters_ == 0) {
+        playerStats_ = actors_[player_];
+        ++depth_;
+        if (log_) log_->addf(MessageKind::Info, stats_.turns, "You descend to depth %u.", depth_ + 1);
+        enterLevel();   // nowy harmonogram - gracz jest w nim od razu zaplanowany
+        return;
+    }
+
+    Actor& self = actors_[player_];
+    const TilePos pos = positions_[player_];
+    const ActorId enemy = weakestNeighbour(pos);
+    if (enemy != kNobody) {
+        attack(player_, enemy);
+    } else if (self.hp < self.maxHp / kRestBelow) {
+        ++self.hp;
+    } else {
+        // Najbliższy żywy potwór (Czebyszew); ścieżka omija filary, zajęte kafle tylko czekamy
+        ActorId target = kNobody;
+        int best = INT32_MAX;
+        for (ActorId id = 0; id < actors_.size(); ++id) {
+            if (id == player_ || !scheduler_.alive(id)) continue;
+            const int d = chebyshev(pos, positions_[id]);
+            if (d < best) {
+                best = d;
+                target = id;
+            }
+        }
+        if (target != kNobody && paths_.findPath(pos, positions_[target], path_) && path_.size() > 1) {
+            const TilePos next = path_[1];
+            if (occupant_[world_.tiles.index(next.x, next.y)] == kNobody) {
+                moveActor(player_, next);
+                chase_.moveGoal(playerGoal_, next);
+                chaseDirty_ = true;
+                scheduler_.applyDistanceLod(positions_, next, kActiveRadius, kCoarseRadius);
+            }
+        }
+    }
+    scheduler_.endTurn(player_);
+}
+
+void Simulation::monsterTurn(ActorId id, uint32_t steps)
+{
+    for (uint32_t s = 0; s < steps; ++s) {
+        const TilePos pos = positions_[id];
+        if (chebyshev(pos, positions_[player_]) <= 1) {
+            attack(id, player_);
+            break;
+        }
+        if (chaseDirty_) {
+            chase_.update();
+            chaseDirty_ = false;
+        }
+        const TilePos next = chase_.nextStep(pos);
+        if (next == pos || occupant_[world_.tiles.index(next.x, next.y)] != kNobody) break;
+        moveActor(id, next);
+    }
+    scheduler_.endTurn(id);
+}
+
+bool Simulation::step()
+{
+    if (over_) return false;
+    TurnScheduler::Turn turn;
+    if (!scheduler_.next(turn)) {
+        over_ = true;
+        return false;
+    }
+    ++stats_.actions;
+    if (turn.actor == player_) playerTurn();
+    else monsterTurn(turn.actor, turn.steps);
+    return !over_;
+}
+
+const SimStats& Simulation::run()
+{
+    while (step()) {}
+    return stats_;
+}
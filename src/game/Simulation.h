@@ -0,0 +1,87 @@
+#pragma once
+#include "DijkstraMap.h"
+#include "MessageLog.h"
+#include "Pathfinding.h"
+#include "TurnScheduler.h"
+#include "World.h"
+#include <cstdint>
+#include <vector>
+
+struct SimConfig {
+    uint32_t maxTurns = 1000;          // tury gracza; po nich gra kończy się bez śmierci
+    uint32_t monstersPerLevel = 12;    // + 2 na każde kolejne piętro
+    int playerHp = 40;
+};
+
+struct SimStats {
+    uint64_t turns = 0;        // tury gracza
+    uint64_t actions = 0;      // tury wszystkich aktorów (tura Coarse to kilka kroków, liczona raz)
+    uint32_t depth = 0;        // najgłębsze osiągnięte piętro
+    uint32_t kills = 0;
+    uint64_t damageDealt = 0;
+    uint64_t damageTaken = 0;
+    bool died = false;
+};
+
+// Gra bez okna: gracz i potwory sterowane przez AI na World, kolejność z TurnScheduler.
+// Potwory idą po wspólnej mapie Dijkstry do gracza (dalekie rzadziej - LOD harmonogramu),
+// gracz szuka ścieżki do najbliższego potwora, bije sąsiadów, odpoczywa przy niskim HP
+// i schodzi niżej po oczyszczeniu piętra. Cała losowość z world.rng - to samo ziarno daje tę samą grę.
+class Simulation {
+public:
+    explicit Simulation(uint64_t seed, const SimConfig& config = {});
+
+    // DijkstraMap i Pathfinder trzymają referencję do world_.tiles
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // Jedna tura aktora z harmonogramu; false po śmierci gracza albo limicie tur
+    bool step();
+    const SimStats& run();
+
+    // Opcjonalny dziennik walki (panel Log); bez niego symulacja nic nie formatuje
+    void setLog(MessageLog* log) { log_ = log; }
+
+    const SimStats& stats() const { return stats_; }
+    const World& world() const { return world_; }
+    uint32_t depth() const { return depth_; }
+
+private:
+    using ActorId = TurnScheduler::ActorId;
+    static constexpr ActorId kNobody = UINT32_MAX;
+
+    struct Actor {
+        int hp = 0;
+        int maxHp = 0;
+        int minDamage = 0;
+        int maxDamage = 0;
+    };
+
+    SimConfig config_;
+    World world_;
+    TurnScheduler scheduler_;
+    DijkstraMap chase_;
+    Pathfinder paths_;
+    DijkstraMap::GoalId playerGoal_ = -1;
+    bool chaseDirty_ = false;           // gracz się ruszył - mapę przeliczy pierwszy idący potwór
+    ActorId player_ = 0;
+    Actor playerStats_;                 // przechodzi między piętrami
+    std::vector<Actor> actors_;         // indeksowane ActorId
+    std::vector<TilePos> positions_;    // indeksowane ActorId (applyDistanceLod)
+    std::vector<ActorId> occupant_;     // kafel -> aktor albo kNobody
+    std::vector<TilePos> path_;
+    uint32_t monsters_ = 0;             // żywe na bieżącym piętrze
+    uint32_t depth_ = 0;
+    SimStats stats_;
+    bool over_ = false;
+    MessageLog* log_ = nullptr;
+
+    void enterLevel();
+    TilePos freeTile();
+    ActorId spawnActor(const Actor& actor, uint32_t speed, uint32_t initialDelay);
+    void moveActor(ActorId id, TilePos to);
+    void attack(ActorId from, ActorId to);
+    ActorId weakestNeighbour(TilePos pos) const;
+    void playerTurn();
+    void monsterTurn(ActorId id, uint32_t steps);
+};
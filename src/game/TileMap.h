@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+using TileIndex = uint32_t;
+
+// Bity opisujące kafel (jeden bajt na kafel)
+enum TileFlags : uint8_t {
+    TileWalkable    = 1u << 0,
+    TileTransparent = 1u << 1,
+};
+
+inline constexpr uint8_t TileFloor = TileWalkable | TileTransparent;
+inline constexpr uint8_t TileWall  = 0;
+
+struct TilePos {
+    int x = 0;
+    int y = 0;
+    bool operator==(const TilePos&) const = default;
+};
+
+// Płaska siatka kafli indeksowana y * width + x.
+// revision() rośnie przy każdej zmianie - cache (np. ścieżek) porównują ją zamiast słuchać zdarzeń.
+class TileMap {
+public:
+    TileMap() = default;
+    TileMap(int width, int height, uint8_t fill = TileFloor)
+        : width_(width), height_(height), tiles_(static_cast<size_t>(width) * height, fill) {}
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    size_t size() const { return tiles_.size(); }
+    uint32_t revision() const { return revision_; }
+
+    bool inBounds(int x, int y) const { return x >= 0 && y >= 0 && x < width_ && y < height_; }
+    TileIndex index(int x, int y) const { return static_cast<TileIndex>(y) * width_ + x; }
+    TilePos pos(TileIndex i) const { return { static_cast<int>(i % width_), static_cast<int>(i / width_) }; }
+
+    uint8_t at(int x, int y) const { return tiles_[index(x, y)]; }
+    bool walkable(int x, int y) const { return inBounds(x, y) && (tiles_[index(x, y)] & TileWalkable); }
+    bool transparent(int x, int y) const { return inBounds(x, y) && (tiles_[index(x, y)] & TileTransparent); }
+
+    void set(int x, int y, uint8_t flags) {
+        uint8_t& t = tiles_[index(x, y)];
+        if (t == flags) return;
+        t = flags;
+        ++revision_;
+    }
+
+    // Podmiana całej siatki (wczytanie zapisu, generator poziomów)
+    void assign(int width, int height, const uint8_t* tiles) {
+        width_ = width;
+        height_ = height;
+        tiles_.assign(tiles, tiles + static_cast<size_t>(width) * height);
+        ++revision_;
+    }
+
+    const uint8_t* data() const { return tiles_.data(); }
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<uint8_t> tiles_;
+    uint32_t revision_ = 0;
+};
@@ -0,0 +1,178 @@
+#include "TurnScheduler.h"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+constexpr uint32_t kNotQueued = std::numeric_limits<uint32_t>::max();
+}
+
+// --- RadixHeap ---
+
+size_t TurnScheduler::RadixHeap::bucketFor(uint64_t key, uint64_t last)
+{
+    return key == last ? 0 : static_cast<size_t>(64 - std::countl_zero(key ^ last));
+}
+
+void TurnScheduler::RadixHeap::push(const Item& item)
+{
+    buckets_[bucketFor(item.key, last_)].push_back(item);
+    ++size_;
+}
+
+template <typename Live>
+bool TurnScheduler::RadixHeap::pop(Item& out, const Live& live)
+{
+    for (;;) {
+        auto& front = buckets_[0];
+        while (!front.empty()) {
+            out = front.back();
+            front.pop_back();
+            --size_;
+            if (live(out)) return true;
+        }
+        if (size_ == 0) return false;
+
+        size_t i = 1;
+        while (buckets_[i].empty()) ++i;
+        auto& bucket = buckets_[i];
+        // Nieaktualne wpisy wypadają przed wyborem minimum, więc last_ to zawsze klucz żywego wpisu
+        const auto stale = std::remove_if(bucket.begin(), bucket.end(), [&](const Item& it) { return !live(it); });
+        size_ -= static_cast<size_t>(bucket.end() - stale);
+        bucket.erase(stale, bucket.end());
+        if (bucket.empty()) continue;
+        uint64_t minKey = bucket[0].key;
+        for (const auto& it : bucket) minKey = std::min(minKey, it.key);
+        last_ = minKey;
+        // Każdy element trafia do kubełka o niższym numerze - stąd zamortyzowane O(log C)
+        for (const auto& it : bucket) buckets_[bucketFor(it.key, last_)].push_back(it);
+        bucket.clear();
+    }
+}
+
+// --- TurnScheduler ---
+
+TurnScheduler::ActorId TurnScheduler::addActor(uint32_t speed, uint32_t initialDelay)
+{
+    ActorId id;
+    if (!freeIds_.empty()) {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    } else {
+        id = static_cast<ActorId>(alive_.size());
+        nextTime_.push_back(0);
+        speed_.push_back(0);
+        version_.push_back(0);
+        sleepRemaining_.push_back(kNotQueued);
+        steps_.push_back(1);
+        lod_.push_back(Lod::Active);
+        alive_.push_back(0);
+        queued_.push_back(0);
+    }
+    ++version_[id];
+    speed_[id] = std::max(1u, speed);
+    sleepRemaining_[id] = kNotQueued;
+    steps_[id] = 1;
+    lod_[id] = Lod::Active;
+    alive_[id] = 1;
+    queued_[id] = 0;
+    ++liveActors_;
+    enqueue(id, now_ + initialDelay);
+    return id;
+}
+
+void TurnScheduler::removeActor(ActorId id)
+{
+    if (!alive(id)) return;
+    dequeue(id);
+    alive_[id] = 0;
+    freeIds_.push_back(id);
+    --liveActors_;
+}
+
+void TurnScheduler::setSpeed(ActorId id, uint32_t speed)
+{
+    // Nowa szybkość liczy się od następnej akcji - zaplanowana tura zostaje
+    speed_[id] = std::max(1u, speed);
+}
+
+void TurnScheduler::enqueue(ActorId id, uint64_t time)
+{
+    nextTime_[id] = time;
+    queued_[id] = 1;
+    ++scheduled_;
+    heap_.push({ time, id, version_[id] });
+}
+
+void TurnScheduler::dequeue(ActorId id)
+{
+    if (!queued_[id]) return;
+    ++version_[id];   // wpis w kopcu staje się nieaktualny
+    queued_[id] = 0;
+    --scheduled_;
+}
+
+void TurnScheduler::setLod(ActorId id, Lod lod)
+{
+    if (!alive(id) || lod_[id] == lod) return;
+    const Lod old = lod_[id];
+    lod_[id] = lod;
+
+    if (lod == Lod::Asleep) {
+        if (queued_[id]) {
+            sleepRemaining_[id] = static_cast<uint32_t>(nextTime_[id] - now_);
+            dequeue(id);
+        } else {
+            sleepRemaining_[id] = kNotQueued;
+        }
+    } else if (old == Lod::Asleep) {
+        if (sleepRemaining_[id] != kNotQueued)
+            enqueue(id, now_ + sleepRemaining_[id]);
+        sleepRemaining_[id] = kNotQueued;
+    }
+}
+
+void TurnScheduler::applyDistanceLod(std::span<const TilePos> positions, TilePos player, int activeRadius, int coarseRadius)
+{
+    const size_t n = std::min(positions.size(), alive_.size());
+    for (ActorId id = 0; id < n; ++id) {
+        if (!alive_[id]) continue;
+        const int d = std::max(std::abs(positions[id].x - player.x), std::abs(positions[id].y - player.y));
+        setLod(id, d <= activeRadius ? Lod::Active : d <= coarseRadius ? Lod::Coarse : Lod::Asleep);
+    }
+}
+
+bool TurnScheduler::next(Turn& out)
+{
+    RadixHeap::Item item{};
+    const auto live = [this](const RadixHeap::Item& it) {
+        return alive_[it.actor] && queued_[it.actor] && version_[it.actor] == it.version;
+    };
+    if (!heap_.pop(item, live)) return false;
+    const ActorId id = item.actor;
+    queued_[id] = 0;
+    --scheduled_;
+    now_ = item.key;
+    steps_[id] = lod_[id] == Lod::Coarse ? kCoarseSteps : 1;
+    out = { id, now_, steps_[id] };
+    return true;
+}
+
+uint32_t TurnScheduler::delayFor(ActorId id, uint32_t actionCost, uint32_t steps) const
+{
+    const uint64_t work = static_cast<uint64_t>(actionCost) * steps * kNormalSpeed;
+    const uint64_t delay = (work + speed_[id] - 1) / speed_[id];
+    return static_cast<uint32_t>(std::clamp<uint64_t>(delay, 1, kNotQueued - 1));
+}
+
+void TurnScheduler::endTurn(ActorId id, uint32_t actionCost)
+{
+    if (!alive(id) || queued_[id]) return;
+    const uint32_t delay = delayFor(id, actionCost, steps_[id]);
+    if (lod_[id] == Lod::Asleep) {
+        sleepRemaining_[id] = delay;
+        return;
+    }
+    enqueue(id, now_ + delay);
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "TileMap.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Harmonogram tur oparty na energii/szybkości. Zamiast co tick przechodzić po wszystkich
+// aktorach, każdy ma wyliczony czas następnej akcji i siedzi w kopcu pozycyjnym (radix heap)
+// - czasy są monotoniczne, więc schedule jest O(1), a pop zamortyzowane O(log C).
+// Usunięcie (śmierć, przeplanowanie) to podbicie wersji aktora; stare wpisy giną przy zdejmowaniu.
+//
+// Pętla gry:
+//   TurnScheduler::Turn t;
+//   while (sched.next(t)) { act(t.actor, t.steps); sched.endTurn(t.actor, cost); }
+// Aktor, dla którego nie wołamy endTurn (np. gracz czekający na wejście), wypada z kolejki.
+class TurnScheduler {
+public:
+    using ActorId = uint32_t;
+
+    static constexpr uint32_t kNormalSpeed = 100;   // energia na tick przy normalnej szybkości
+    static constexpr uint32_t kActionCost = 100;    // koszt zwykłej akcji
+    static constexpr uint32_t kCoarseSteps = 8;     // ile akcji naraz wykonuje daleki aktor
+
+    // Active - pełne tury; Coarse - rzadsze tury po kCoarseSteps akcji (uproszczone AI);
+    // Asleep - poza kolejką, nic nie kosztuje, po obudzeniu dokańcza pozostały czas.
+    enum class Lod : uint8_t { Active, Coarse, Asleep };
+
+    struct Turn {
+        ActorId actor = 0;
+        uint64_t time = 0;
+        uint32_t steps = 1;   // > 1 dla aktorów Coarse
+    };
+
+    ActorId addActor(uint32_t speed = kNormalSpeed, uint32_t initialDelay = 0);
+    void removeActor(ActorId id);
+    bool alive(ActorId id) const { return id < alive_.size() && alive_[id]; }
+
+    void setSpeed(ActorId id, uint32_t speed);
+    void setLod(ActorId id, Lod lod);
+    Lod lod(ActorId id) const { return lod_[id]; }
+
+    // Przydział LOD po odległości (Czebyszewa) od gracza; positions indeksowane ActorId.
+    void applyDistanceLod(std::span<const TilePos> positions, TilePos player, int activeRadius, int coarseRadius);
+
+    // Zdejmuje najbliższego aktora i przesuwa zegar; false gdy kolejka pusta.
+    bool next(Turn& out);
+    // Planuje kolejną turę aktora po akcji o danym koszcie energii.
+    void endTurn(ActorId id, uint32_t actionCost = kActionCost);
+
+    uint64_t now() const { return now_; }
+    size_t scheduledCount() const { return scheduled_; }
+    size_t actorCount() const { return liveActors_; }
+
+private:
+    // Kopiec pozycyjny: kubełek i trzyma klucze różniące się od ostatnio zdjętego
+    // najstarszym bitem na pozycji i-1. Wymaga kluczy >= ostatniego minimum.
+    // pop pomija nieaktualne wpisy (live == false), zanim przesunie last_ - inaczej last_
+    // mógłby uciec przed zegar i nowy wpis now_ + delay złamałby warunek kopca.
+    class RadixHeap {
+    public:
+        struct Item {
+            uint64_t key;
+            ActorId actor;
+            uint32_t version;
+        };
+        void push(const Item& item);
+        template <typename Live>
+        bool pop(Item& out, const Live& live);
+        bool empty() const { return size_ == 0; }
+        size_t size() const { return size_; }
+        uint64_t last() const { return last_; }
+    private:
+        std::array<std::vector<Item>, 65> buckets_;
+        uint64_t last_ = 0;
+        size_t size_ = 0;
+        static size_t bucketFor(uint64_t key, uint64_t last);
+    };
+
+    RadixHeap heap_;
+    uint64_t now_ = 0;
+    size_t scheduled_ = 0;
+    size_t liveActors_ = 0;
+
+    // Stan aktorów (SoA) indeksowany ActorId
+    std::vector<uint64_t> nextTime_;
+    std::vector<uint32_t> speed_;
+    std::vector<uint32_t> version_;
+    std::vector<uint32_t> sleepRemaining_;
+    std::vector<uint32_t> steps_;
+    std::vector<Lod> lod_;
+    std::vector<uint8_t> alive_;
+    std::vector<uint8_t> queued_;
+    std::vector<ActorId> freeIds_;
+
+    uint32_t delayFor(ActorId id, uint32_t actionCost, uint32_t steps) const;
+    void enqueue(ActorId id, uint64_t time);
+    void dequeue(ActorId id);
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include "Rng.h"
+#include "TileMap.h"
+#include <cstdint>
+
+// Stan świata gry niezależny od renderera
+struct World {
+    TileMap tiles;
+    Rng rng;
+    uint64_t turn = 0;
+};
@@ -1,10 +1,50 @@
 #include "app/VulkanImGuiApp.h"
+#include "core/Log.h"
+#include <cstdlib>
+#include <iostream>
 #include <string>
 
+static bool parseLogLevel(const std::string& name, LogLevel& level) {
+    for (uint8_t l = 0; l < static_cast<uint8_t>(LogLevel::Count); ++l) {
+        if (name == logLevelName(static_cast<LogLevel>(l))) {
+            level = static_cast<LogLevel>(l);
+            return true;
+        }
+    }
+    return false;
+}
+
 int main(int argc, char** argv) {
     VulkanImGuiApp app;
     if (argc > 1 && argv[1] && std::string(argv[1]) == "--smoke") {
         return app.runSmokeTest();
     }
-    return app.run();
+
+    RunOptions options;
+    logger::Config log;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--record" && hasValue) options.recordPath = argv[++i];
+        else if (arg == "--replay" && hasValue) options.replayPath = argv[++i];
+        else if (arg == "--seed" && hasValue) options.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--realtime") options.realtime = true;
+        else if (arg == "--frames" && hasValue) options.maxFrames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--alloc-budget" && hasValue) options.allocBudget = std::atoi(argv[++i]);
+        else if (arg == "--startup-report") options.startupReport = true;
+        else if (arg == "--no-idle") options.idle = false;
+        else if (arg == "--log" && hasValue) log.path = argv[++i];
+        else if (arg == "--log-level" && hasValue && parseLogLevel(argv[i + 1], log.minLevel)) ++i;
+        else if (arg == "--log-block") log.blockWhenFull = true;
+        else {
+            std::cerr << "Usage: RogueLikeGame [--smoke] [--record <file>] [--replay <file> [--realtime]] [--seed <n>]"
+                         " [--frames <n>] [--alloc-budget <n>] [--startup-report] [--no-idle]"
+                         " [--log <file>] [--log-level verbose|info|warning|error] [--log-block]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    logger::start(log);
+    const int result = app.run(options);
+    logger::stop();
+    return result;
 }
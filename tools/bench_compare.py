@@ -0,0 +1,61 @@
+"""Porównuje dwa wyniki `roguelike_bench --json` i zgłasza regresje.
+
+Użycie: python tools/bench_compare.py base.json new.json [--threshold 0.10]
+
+Dla każdej nazwy brany jest najlepszy wynik (przy --repeat jest ich kilka). Regresja = spadek
+przepustowości (per_second) o więcej niż próg. Kod wyjścia 1, gdy jest choć jedna regresja.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, "r", encoding="utf-8") as f:
+        data = json.load(f)
+    best = {}
+    for b in data["benchmarks"]:
+        name = b["name"]
+        if name not in best or b["per_second"] > best[name]["per_second"]:
+            best[name] = b
+    return data, best
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two roguelike_bench JSON results")
+    parser.add_argument("base")
+    parser.add_argument("new")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative throughput drop treated as a regression (default 0.10)")
+    args = parser.parse_args()
+
+    base_data, base = load(args.base)
+    new_data, new = load(args.new)
+    if base_data.get("build") != new_data.get("build"):
+        print(f"warning: comparing {base_data.get('build')} with {new_data.get('build')} build")
+
+    regressions = 0
+    print(f"{'benchmark':<40} {'base/s':>14} {'new/s':>14} {'change':>8}")
+    for name in sorted(set(base) | set(new)):
+        if name not in base or name not in new:
+            print(f"{name:<40} {'only in ' + ('new' if name in new else 'base'):>38}")
+            continue
+        b = base[name]["per_second"]
+        n = new[name]["per_second"]
+        change = (n - b) / b if b > 0 else 0.0
+        flag = ""
+        if change < -args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        elif change > args.threshold:
+            flag = "  faster"
+        print(f"{name:<40} {b:>14.1f} {n:>14.1f} {change:>+7.1%}{flag}")
+
+    if regressions:
+        print(f"{regressions} regression(s) above {args.threshold:.0%}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
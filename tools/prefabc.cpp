@@ -0,0 +1,44 @@
+#include "game/Animation.h"
+#include "game/Prefab.h"
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Krok budowania: assets/prefabs.txt (+ animations.txt) -> <build>/assets/prefabs.rlpf
+// Użycie: roguelike_prefabc <prefabs.txt> <animations.txt> <wyjście.rlpf>
+namespace {
+std::string readText(const char* path)
+{
+    std::ifstream f(path, std::ios::binary);
+    if (!f) throw std::runtime_error(std::string("Failed to open ") + path);
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 4) {
+        std::cerr << "Usage: roguelike_prefabc <prefabs.txt> <animations.txt> <out.rlpf>" << std::endl;
+        return EXIT_FAILURE;
+    }
+    try {
+        const std::string text = readText(argv[1]);
+        const std::string animationText = readText(argv[2]);
+        AnimationLibrary animations;
+        animations.loadFromText(animationText);
+        const auto table = PrefabTable::compile(text, animations, PrefabTable::sourceHash(text, animationText));
+
+        std::ofstream out(argv[3], std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size()));
+        if (!out) throw std::runtime_error(std::string("Failed to write ") + argv[3]);
+    } catch (const std::exception& e) {
+        std::cerr << argv[1] << ": " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+#include "core/JobSystem.h"
+#include "game/Simulation.h"
+#include "game/TurnScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Gry bez okna na wszystkich rdzeniach: testy balansu i obciążenie CPU logiką gry.
+// Użycie: roguelike_sim [--games <n>] [--turns <n>] [--seed <n>] [--threads <n>] [--monsters <n>]
+//        roguelike_sim --check-scheduler
+// Gra i ma ziarno seed + i, więc wynik nie zależy od liczby wątków.
+namespace {
+void usage()
+{
+    std::fprintf(stderr, "Usage: roguelike_sim [--games <n>] [--turns <n>] [--seed <n>] [--threads <n>] [--monsters <n>]\n"
+                         "       roguelike_sim --check-scheduler\n");
+}
+
+// Czas tury nie może się cofać ani przy usypianiu/budzeniu, ani przy dodawaniu/usuwaniu aktorów
+// (nieaktualne wpisy w kopcu). Zwraca liczbę błędów.
+int checkScheduler()
+{
+    int failures = 0;
+    {
+        // Zdjęty został tylko nieaktualny wpis uśpionego A; B (96) musi wyjść przed C (101)
+        TurnScheduler sched;
+        const auto a = sched.addActor(100, 100);
+        sched.setLod(a, TurnScheduler::Lod::Asleep);
+        TurnScheduler::Turn t;
+        if (sched.next(t)) ++failures;
+        const auto b = sched.addActor(100, 96);
+        sched.addActor(100, 101);
+        if (!sched.next(t) || t.actor != b || t.time != 96) {
+            std::fprintf(stderr, "check-scheduler: stale pop reordered turns (actor %u at %llu)\n", t.actor,
+                static_cast<unsigned long long>(t.time));
+            ++failures;
+        }
+    }
+
+    std::mt19937 rng(7);
+    TurnScheduler sched;
+    std::vector<TurnScheduler::ActorId> actors;
+    uint64_t lastTime = 0;
+    for (uint32_t step = 0; step < 200000; ++step) {
+        switch (rng() % 8) {
+        case 0:
+            actors.push_back(sched.addActor(50 + rng() % 150, rng() % 300));
+            break;
+        case 1:
+            if (!actors.empty()) {
+                const size_t i = rng() % actors.size();
+                sched.removeActor(actors[i]);
+                actors[i] = actors.back();
+                actors.pop_back();
+            }
+            break;
+        case 2:
+        case 3:
+            if (!actors.empty()) sched.setLod(actors[rng() % actors.size()], static_cast<TurnScheduler::Lod>(rng() % 3));
+            break;
+        default: {
+            TurnScheduler::Turn t;
+            if (!sched.next(t)) break;
+            if (t.time < lastTime) {
+                std::fprintf(stderr, "check-scheduler: time went back from %llu to %llu at step %u\n",
+                    static_cast<unsigned long long>(lastTime), static_cast<unsigned long long>(t.time), step);
+                ++failures;
+            }
+            lastTime = t.time;
+            sched.endTurn(t.actor, 50 + rng() % 150);
+            break;
+        }
+        }
+    }
+    std::printf("check-scheduler: %s\n", failures ? "FAILED" : "ok");
+    return failures;
+}
+
+// Percentyl z posortowanej kopii
+uint64_t percentile(std::vector<uint64_t> values, double p)
+{
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())))];
+}
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t games = 1000;
+    uint64_t seed = 1;
+    uint32_t threads = 0;   // 0 = wszystkie rdzenie
+    SimConfig config;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--check-scheduler")) return checkScheduler() ? EXIT_FAILURE : EXIT_SUCCESS;
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--games") && hasValue) games = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--turns") && hasValue) config.maxTurns = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--seed") && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--threads") && hasValue) threads = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--monsters") && hasValue) config.monstersPerLevel = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else {
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<SimStats> results(games);
+    auto runGames = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t g = begin; g < end; ++g) {
+            Simulation sim(seed + g, config);
+            results[g] = sim.run();
+        }
+    };
+
+    const auto t0 = std::chrono::steady_clock::now();
+    uint32_t usedThreads = 1;
+    if (threads == 1) {
+        runGames(0, games);
+    } else {
+        // Wątek główny pomaga w parallelFor, więc roboczych jest o jeden mniej
+        JobSystem jobs(threads ? threads - 1 : 0);
+        usedThreads = jobs.workerCount() + 1;
+        jobs.parallelFor(0, games, 1, runGames);
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    uint64_t turns = 0, actions = 0, kills = 0, deaths = 0, dealt = 0, taken = 0, depthSum = 0;
+    uint32_t maxDepth = 0;
+    std::vector<uint64_t> depths, survived;
+    depths.reserve(games);
+    survived.reserve(games);
+    for (const SimStats& s : results) {
+        turns += s.turns;
+        actions += s.actions;
+        kills += s.kills;
+        deaths += s.died;
+        dealt += s.damageDealt;
+        taken += s.damageTaken;
+        depthSum += s.depth;
+        maxDepth = std::max(maxDepth, s.depth);
+        depths.push_back(s.depth);
+        if (s.died) survived.push_back(s.turns);
+    }
+
+    const double n = games ? static_cast<double>(games) : 1.0;
+    std::printf("%u games, %u threads, %.3f s\n", games, usedThreads, seconds);
+    std::printf("throughput: %.0f turns/s, %.0f actor turns/s, %.1f games/s\n",
+        static_cast<double>(turns) / seconds, static_cast<double>(actions) / seconds, n / seconds);
+    std::printf("deaths: %llu (%.1f%%), turns before death p50 %llu p90 %llu\n",
+        static_cast<unsigned long long>(deaths), 100.0 * static_cast<double>(deaths) / n,
+        static_cast<unsigned long long>(percentile(survived, 0.5)), static_cast<unsigned long long>(percentile(survived, 0.9)));
+    std::printf("depth: mean %.2f, p50 %llu, p90 %llu, max %u\n", static_cast<double>(depthSum) / n,
+        static_cast<unsigned long long>(percentile(depths, 0.5)), static_cast<unsigned long long>(percentile(depths, 0.9)), maxDepth);
+    std::printf("per game: %.1f kills, %.1f damage dealt, %.1f damage taken\n",
+        static_cast<double>(kills) / n, static_cast<double>(dealt) / n, static_cast<double>(taken) / n);
+    return EXIT_SUCCESS;
+}